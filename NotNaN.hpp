@@ -1,29 +1,815 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
 #include <cmath>
+#include <compare>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <expected>
 #include <format>
 #include <functional>
+#include <limits>
 #include <numeric>
 #include <ostream>
+#include <ranges>
+#include <span>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <utility>
 
-template <typename T>
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace notnan
+{
+namespace detail
+{
+    template <std::size_t SIZE>
+    struct UnsignedOfSize;
+    template <>
+    struct UnsignedOfSize<2>
+    {
+        using Type = std::uint16_t;
+    };
+    template <>
+    struct UnsignedOfSize<4>
+    {
+        using Type = std::uint32_t;
+    };
+    template <>
+    struct UnsignedOfSize<8>
+    {
+        using Type = std::uint64_t;
+    };
+#ifdef __SIZEOF_INT128__
+    template <>
+    struct UnsignedOfSize<16>
+    {
+        using Type = unsigned __int128;
+    };
+#endif
+
+    // IEEE 754 interchange formats: sign, exponent and the mantissa without its implicit bit fill the whole type
+    template <typename T>
+    concept IsInterchangeFormat = std::numeric_limits<T>::radix == 2
+                                  && requires { typename UnsignedOfSize<sizeof(T)>::Type; }
+                                  && 8 * sizeof(T) - std::numeric_limits<T>::digits <= 16
+                                  && std::numeric_limits<T>::max_exponent
+                                       == (1 << (8 * sizeof(T) - std::numeric_limits<T>::digits - 1));
+
+    // The x87 80 bit format, which stores the integer bit of the mantissa explicitly
+    template <typename T>
+    concept IsX87Extended = std::numeric_limits<T>::radix == 2 && std::numeric_limits<T>::digits == 64
+                            && std::numeric_limits<T>::max_exponent == 16384 && std::endian::native == std::endian::little;
+
+    // std::float16_t and std::bfloat16_t. Most hardware only stores them and computes in float.
+    template <typename T>
+    concept IsHalfPrecision = IsInterchangeFormat<T> && sizeof(T) == 2;
+
+    // Not every standard library formats the 16 bit formats, they are formatted as the float they convert to exactly
+    template <typename T>
+    using FormatType = std::conditional_t<std::is_default_constructible_v<std::formatter<T>>, T, float>;
+
+    // mantissa in bytes 0 to 7, sign and exponent in bytes 8 and 9, the rest is padding
+    template <typename T>
+    struct X87Layout
+    {
+        std::uint64_t mantissa;
+        std::uint16_t signExponent;
+        std::uint8_t  padding[sizeof(T) - 10];
+    };
+
+    // NaN test on the bit pattern, integer operations on the representation are never folded away
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto isNaNBits(const T value) noexcept -> bool
+    {
+        if constexpr (IsInterchangeFormat<T>)
+        {
+            using Bits               = typename UnsignedOfSize<sizeof(T)>::Type;
+            constexpr int  EXPONENT  = 8 * sizeof(T) - std::numeric_limits<T>::digits;
+            constexpr Bits ABS_MASK  = static_cast<Bits>(~Bits {}) >> 1U;
+            constexpr Bits INFINITY_ = ((Bits {1} << EXPONENT) - 1) << (std::numeric_limits<T>::digits - 1);
+            return (std::bit_cast<Bits>(value) & ABS_MASK) > INFINITY_;
+        }
+        else if constexpr (IsX87Extended<T>)
+        {
+            const auto layout = std::bit_cast<X87Layout<T>>(value);
+            return (layout.signExponent & 0x7FFFU) == 0x7FFFU && (layout.mantissa & (~std::uint64_t {} >> 1U)) != 0;
+        }
+        else
+        {
+            // unknown format, hope for the best
+            return std::isnan(value);
+        }
+    }
+
+    // The bits of a value as an unsigned integer in the order of the values: negative values have all bits flipped,
+    // the others only the sign bit. -0.0 comes right before +0.0.
+    template <std::floating_point T>
+        requires IsInterchangeFormat<T>
+    [[nodiscard]]
+    constexpr auto orderedBits(const T value) noexcept -> typename UnsignedOfSize<sizeof(T)>::Type
+    {
+        using Bits          = typename UnsignedOfSize<sizeof(T)>::Type;
+        constexpr Bits SIGN = Bits {1} << (8 * sizeof(T) - 1);
+        const Bits     bits = std::bit_cast<Bits>(value);
+        return (bits & SIGN) != 0 ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | SIGN);
+    }
+
+    template <std::floating_point T>
+        requires IsInterchangeFormat<T>
+    [[nodiscard]]
+    constexpr auto fromOrderedBits(const typename UnsignedOfSize<sizeof(T)>::Type bits) noexcept -> T
+    {
+        using Bits          = typename UnsignedOfSize<sizeof(T)>::Type;
+        constexpr Bits SIGN = Bits {1} << (8 * sizeof(T) - 1);
+        return std::bit_cast<T>((bits & SIGN) != 0 ? static_cast<Bits>(bits ^ SIGN) : static_cast<Bits>(~bits));
+    }
+
+    // Formats toOrderedBytes supports, and the number of bytes it writes
+    template <typename T>
+    concept HasOrderedBytes = std::floating_point<T> && (IsInterchangeFormat<T> || IsX87Extended<T>);
+
+    template <std::floating_point T>
+    constexpr std::size_t ORDERED_SIZE = IsX87Extended<T> ? 10 : sizeof(T);
+
+    // orderedBits in big-endian bytes, so that memcmp compares like the values. -0.0 is written as +0.0.
+    template <HasOrderedBytes T>
+    constexpr void encodeOrdered(const T value, std::byte* const out) noexcept
+    {
+        const T normalized = value == T {0} ? T {0} : value;
+        if constexpr (IsInterchangeFormat<T>)
+        {
+            const auto bits = orderedBits(normalized);
+            for (std::size_t idx = 0; idx < sizeof(T); ++idx)
+            {
+                out[idx] = static_cast<std::byte>(bits >> (8 * (sizeof(T) - 1 - idx)));
+            }
+        }
+        else
+        {
+            // sign and exponent first, then the mantissa with its explicit integer bit
+            const auto    layout = std::bit_cast<X87Layout<T>>(normalized);
+            std::uint16_t high   = layout.signExponent;
+            std::uint64_t low    = layout.mantissa;
+            if ((high & 0x8000U) != 0)
+            {
+                high = static_cast<std::uint16_t>(~high);
+                low  = ~low;
+            }
+            else
+            {
+                high = static_cast<std::uint16_t>(high | 0x8000U);
+            }
+            out[0] = static_cast<std::byte>(high >> 8U);
+            out[1] = static_cast<std::byte>(high);
+            for (std::size_t idx = 0; idx < 8; ++idx)
+            {
+                out[2 + idx] = static_cast<std::byte>(low >> (8 * (7 - idx)));
+            }
+        }
+    }
+
+    // The inverse of encodeOrdered, may give NaN for bytes that encodeOrdered does not write
+    template <HasOrderedBytes T>
+    [[nodiscard]]
+    constexpr auto decodeOrdered(const std::byte* const in) noexcept -> T
+    {
+        if constexpr (IsInterchangeFormat<T>)
+        {
+            using Bits = typename UnsignedOfSize<sizeof(T)>::Type;
+            Bits bits  = 0;
+            for (std::size_t idx = 0; idx < sizeof(T); ++idx)
+            {
+                bits = static_cast<Bits>(bits << 8U) | std::to_integer<Bits>(in[idx]);
+            }
+            return fromOrderedBits<T>(bits);
+        }
+        else
+        {
+            std::uint64_t low  = 0;
+            auto          high = static_cast<std::uint16_t>(
+              (std::to_integer<unsigned>(in[0]) << 8U) | std::to_integer<unsigned>(in[1])
+            );
+            for (std::size_t idx = 0; idx < 8; ++idx)
+            {
+                low = (low << 8U) | std::to_integer<std::uint64_t>(in[2 + idx]);
+            }
+            if ((high & 0x8000U) != 0)
+            {
+                high = static_cast<std::uint16_t>(high & 0x7FFFU);
+            }
+            else
+            {
+                high = static_cast<std::uint16_t>(~high);
+                low  = ~low;
+            }
+            return std::bit_cast<T>(X87Layout<T> {low, high, {}});
+        }
+    }
+}    // namespace detail
+
+// NaN test on the bit pattern.
+// Under -ffast-math or -ffinite-math-only the compiler may fold std::isnan and x != x to false, integer operations
+// on the representation are kept. The test is the same in every translation unit, whatever flags it is built with.
+// The 16 bit formats need neither a conversion nor a std::isnan overload this way.
+template <std::floating_point T>
+[[nodiscard]]
+constexpr auto isNaN(const T value) noexcept -> bool
+{
+    return detail::isNaNBits(value);
+}
+
+// The operation during which a NaN was found
+enum class Operation : std::uint8_t
+{
+    Construct,
+    Assign,
+    Compare,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Sqrt,
+    Cbrt,
+    Pow,
+    Log,
+    Log2,
+    Log10,
+    LogBase,
+    Log1p,
+    Exp,
+    Exp2,
+    Expm1,
+    Abs,
+    Floor,
+    Ceil,
+    Round,
+    Modf,
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+    Atan2,
+    Hypot,
+    Erf,
+    Erfc,
+    Tgamma,
+    Lgamma,
+    Midpoint,
+    Reduce,    // sums over whole ranges, see NotNaNAlgorithm.hpp
+    Scope,     // anything inside a NaNGuardScope, see NotNaNGuard.hpp
+};
+
+// Which value was NaN
+enum class Operand : std::uint8_t
+{
+    Value,     // the value given to a constructor, assignment or comparison
+    Lhs,
+    Rhs,
+    Result,    // the operands were fine, the operation produced NaN
+};
+
+[[nodiscard]]
+constexpr auto toString(const Operation operation) noexcept -> std::string_view
+{
+    switch (operation)
+    {
+        case Operation::Construct: return "construction";
+        case Operation::Assign:    return "assignment";
+        case Operation::Compare:   return "comparison";
+        case Operation::Add:       return "addition";
+        case Operation::Subtract:  return "subtraction";
+        case Operation::Multiply:  return "multiplication";
+        case Operation::Divide:    return "division";
+        case Operation::Sqrt:      return "sqrt";
+        case Operation::Cbrt:      return "cbrt";
+        case Operation::Pow:       return "pow";
+        case Operation::Log:       return "log";
+        case Operation::Log2:      return "log2";
+        case Operation::Log10:     return "log10";
+        case Operation::LogBase:   return "logBase";
+        case Operation::Log1p:     return "log1p";
+        case Operation::Exp:       return "exp";
+        case Operation::Exp2:      return "exp2";
+        case Operation::Expm1:     return "expm1";
+        case Operation::Abs:       return "abs";
+        case Operation::Floor:     return "floor";
+        case Operation::Ceil:      return "ceil";
+        case Operation::Round:     return "round";
+        case Operation::Modf:      return "modf";
+        case Operation::Sin:       return "sin";
+        case Operation::Cos:       return "cos";
+        case Operation::Tan:       return "tan";
+        case Operation::Asin:      return "asin";
+        case Operation::Acos:      return "acos";
+        case Operation::Atan:      return "atan";
+        case Operation::Atan2:     return "atan2";
+        case Operation::Hypot:     return "hypot";
+        case Operation::Erf:       return "erf";
+        case Operation::Erfc:      return "erfc";
+        case Operation::Tgamma:    return "tgamma";
+        case Operation::Lgamma:    return "lgamma";
+        case Operation::Midpoint:  return "midpoint";
+        case Operation::Reduce:    return "reduction";
+        case Operation::Scope:     return "guarded scope";
+    }
+    return "unknown operation";
+}
+
+// What went wrong, small enough to be passed around in registers
+struct NaNError
+{
+    Operation operation;
+    Operand   operand;
+
+    constexpr auto operator== (const NaNError& other) const noexcept -> bool = default;
+};
+
+// Holds no strings, so it can be returned from noexcept code and copied freely
+static_assert(std::is_trivially_copyable_v<NaNError>);
+static_assert(sizeof(NaNError) == 2);
+
+// Human readable description, only built on the error path
+[[nodiscard, gnu::cold]]
+inline auto describe(const NaNError& error) -> std::string
+{
+    switch (error.operand)
+    {
+        case Operand::Value:
+            if (error.operation == Operation::Construct)
+            {
+                return "Can not construct with NaN";
+            }
+            if (error.operation == Operation::Assign)
+            {
+                return "Can not assign NaN";
+            }
+            if (error.operation == Operation::Compare)
+            {
+                return "Can not compare with NaN";
+            }
+            return std::format("Argument of {} is NaN", toString(error.operation));
+        case Operand::Lhs:    return std::format("lhs of {} is NaN", toString(error.operation));
+        case Operand::Rhs:    return std::format("rhs of {} is NaN", toString(error.operation));
+        case Operand::Result: return std::format("Result of {} is NaN", toString(error.operation));
+    }
+    return "NaN";
+}
+
+// Check policies decide what happens when a NaN shows up.
+// CHECKED    - whether the checks are compiled in at all
+// Result<R>  - what an operation that would produce R returns
+// success<R> - wraps a checked R into Result<R>
+// failure<R> - reports an error through Result<R>, if the policy has a way to do so
+// raise      - reports an error where there is no result to carry it (constructors, comparisons)
+template <typename P>
+concept CheckPolicy = requires (const NaNError error) {
+    { P::CHECKED } -> std::convertible_to<bool>;
+    { P::raise(error) };
+    { P::template failure<int>(error) } -> std::same_as<typename P::template Result<int>>;
+    { P::template success<int>(0) } -> std::same_as<typename P::template Result<int>>;
+};
+
+namespace detail
+{
+    // Policies without an error channel in the return type return R and never come back from failure
+    template <typename Derived>
+    struct RaisingPolicy
+    {
+        template <typename R>
+        using Result = R;
+
+        template <typename R>
+        [[nodiscard]]
+        static constexpr auto success(R value) noexcept -> R
+        {
+            return value;
+        }
+
+        template <typename R>
+        [[noreturn]]
+        static auto failure(const NaNError error) -> R
+        {
+            Derived::raise(error);
+        }
+    };
+}    // namespace detail
+
+// Throws std::runtime_error when arithmetic produces NaN, std::invalid_argument for all other NaN (the default)
+struct ThrowPolicy : detail::RaisingPolicy<ThrowPolicy>
+{
+    static constexpr bool CHECKED = true;
+
+    [[noreturn, gnu::cold, gnu::noinline]]
+    static void raise(const NaNError error)
+    {
+        const bool arithmetic = error.operation == Operation::Add
+                                || error.operation == Operation::Subtract
+                                || error.operation == Operation::Multiply
+                                || error.operation == Operation::Divide
+                                || error.operation == Operation::Reduce
+                                || error.operation == Operation::Scope;
+        if (arithmetic && error.operand == Operand::Result)
+        {
+            throw std::runtime_error(describe(error));
+        }
+        throw std::invalid_argument(describe(error));
+    }
+};
+
+// Calls std::terminate, for code built without exceptions
+struct TerminatePolicy : detail::RaisingPolicy<TerminatePolicy>
+{
+    static constexpr bool CHECKED = true;
+
+    [[noreturn, gnu::cold, gnu::noinline]]
+    static void raise(const NaNError /* error */) noexcept
+    {
+        std::terminate();
+    }
+};
+
+// Checks like assert: reports and aborts in debug builds, no checks at all with NDEBUG
+struct AssertPolicy : detail::RaisingPolicy<AssertPolicy>
+{
+#ifdef NDEBUG
+    static constexpr bool CHECKED = false;
+#else
+    static constexpr bool CHECKED = true;
+#endif
+
+    [[noreturn, gnu::cold, gnu::noinline]]
+    static void raise(const NaNError error) noexcept
+    {
+        std::fprintf(stderr, "NotNaN assertion failed: %s\n", describe(error).c_str());    // NOLINT(cppcoreguidelines-pro-type-vararg)
+        std::abort();
+    }
+};
+
+// No checks. The caller guarantees that NaN never happens.
+struct UncheckedPolicy : detail::RaisingPolicy<UncheckedPolicy>
+{
+    static constexpr bool CHECKED = false;
+
+    [[noreturn]]
+    static void raise(const NaNError /* error */) noexcept
+    {
+        std::unreachable();
+    }
+};
+
+// Operations return std::expected<NotNaN, NaNError>, in-place modifications std::expected<void, NaNError>.
+// Constructors and comparisons have no way to return an error and call std::terminate on NaN,
+// use NotNaN::fromValue to construct from values that may be NaN.
+struct ExpectedPolicy
+{
+    static constexpr bool CHECKED = true;
+
+    template <typename R>
+    using Result = std::expected<std::conditional_t<std::is_reference_v<R>, void, R>, NaNError>;
+
+    template <typename R>
+    [[nodiscard]]
+    static constexpr auto success(R value) noexcept -> Result<R>
+    {
+        if constexpr (std::is_reference_v<R>)
+        {
+            return {};
+        }
+        else
+        {
+            return value;
+        }
+    }
+
+    template <typename R>
+    [[nodiscard]]
+    static constexpr auto failure(const NaNError error) noexcept -> Result<R>
+    {
+        return std::unexpected(error);
+    }
+
+    [[noreturn, gnu::cold, gnu::noinline]]
+    static void raise(const NaNError /* error */) noexcept
+    {
+        std::terminate();
+    }
+};
+}    // namespace notnan
+
+template <typename T, notnan::CheckPolicy Policy = notnan::ThrowPolicy>
+    requires std::floating_point<T>
+class NotNaN;
+
+namespace notnan
+{
+namespace detail
+{
+    template <typename U>
+    inline constexpr bool IS_NOT_NAN = false;
+
+    template <std::floating_point T, CheckPolicy Policy>
+    inline constexpr bool IS_NOT_NAN<NotNaN<T, Policy>> = true;
+
+    template <typename BinaryOp>
+    inline constexpr Operation OPERATION_OF = Operation::Construct;
+    template <>
+    inline constexpr Operation OPERATION_OF<std::plus<>> = Operation::Add;
+    template <>
+    inline constexpr Operation OPERATION_OF<std::minus<>> = Operation::Subtract;
+    template <>
+    inline constexpr Operation OPERATION_OF<std::multiplies<>> = Operation::Multiply;
+    template <>
+    inline constexpr Operation OPERATION_OF<std::divides<>> = Operation::Divide;
+
+    // Results in a 16 bit format are computed in float, which holds all of their values. float has more than twice
+    // their precision, so rounding its + - * / result once more gives the correctly rounded result, whatever excess
+    // precision the compiler would otherwise keep. Without native 16 bit arithmetic the hardware does the same.
+    template <typename CT, typename BinaryOp, typename L, typename R>
+    [[nodiscard]]
+    constexpr auto compute(const BinaryOp& operation, const L& lhs, const R& rhs) -> CT
+    {
+        if constexpr (IsHalfPrecision<CT>)
+        {
+            return static_cast<CT>(operation(static_cast<float>(lhs), static_cast<float>(rhs)));
+        }
+        else
+        {
+            return operation(lhs, rhs);
+        }
+    }
+
+    // Policies with DEFERRED_RESULT_CHECK do not check results of operations on numbers while deferring() is true,
+    // they find them some other way
+    template <typename P>
+    inline constexpr bool DEFERS_RESULT_CHECK = requires {
+        requires P::DEFERRED_RESULT_CHECK;
+        { P::deferring() } noexcept -> std::same_as<bool>;
+    };
+
+    // Whether the result check is left to the policy right now. Constant evaluation has no flags to check later.
+    template <typename P>
+    [[nodiscard]]
+    constexpr auto isDeferringResultCheck() noexcept -> bool
+    {
+        if constexpr (DEFERS_RESULT_CHECK<P>)
+        {
+            if !consteval
+            {
+                return P::deferring();
+            }
+        }
+        return false;
+    }
+
+    // Selects the constructor that skips the check, for values already known not to be NaN
+    struct UncheckedTag
+    {
+    };
+
+    // Lets the other headers wrap values they have proven not to be NaN, without checking them again.
+    // N has to befriend UncheckedAccess and have a constructor taking UncheckedTag.
+    struct UncheckedAccess
+    {
+        template <typename N, typename T>
+        [[nodiscard]]
+        static constexpr auto make(const T& value) noexcept -> N
+        {
+            return N {UncheckedTag {}, value};
+        }
+    };
+
+    // Like NotNaN::isBadResult, deferred policies check results some other way while they are deferring
+    template <CheckPolicy Policy, std::floating_point T>
+    [[nodiscard]]
+    constexpr auto isBadProvenResult(const T value) noexcept -> bool
+    {
+        if (isDeferringResultCheck<Policy>())
+        {
+            return false;
+        }
+        return Policy::CHECKED && isNaN(value);
+    }
+
+    template <typename Out, CheckPolicy Policy>
+    [[nodiscard, gnu::cold, gnu::noinline]]
+    constexpr auto provenFailure(const NaNError error) -> typename Policy::template Result<Out>
+    {
+        return Policy::template failure<Out>(error);
+    }
+
+    // Wraps the result of an operation into Out, NotNaN or a type built on it.
+    // Without CHECK the types of the operands have proven that the result can't be NaN and it is returned as is,
+    // otherwise it is checked like any other result and returned through the policy's Result.
+    template <typename Out, CheckPolicy Policy, bool CHECK, std::floating_point T>
+    [[nodiscard]]
+    constexpr auto makeProven(const T value, const Operation operation)
+    {
+        if constexpr (CHECK)
+        {
+            if (isBadProvenResult<Policy>(value)) [[unlikely]]
+            {
+                return provenFailure<Out, Policy>({operation, Operand::Result});
+            }
+            return Policy::template success<Out>(UncheckedAccess::make<Out>(value));
+        }
+        else
+        {
+            return UncheckedAccess::make<Out>(value);
+        }
+    }
+}    // namespace detail
+
+// Satisfied by the NotNaN specializations only, not by everything that converts to them
+template <typename U>
+concept IsNotNaN = detail::IS_NOT_NAN<U>;
+}    // namespace notnan
+
+template <typename T, notnan::CheckPolicy Policy>
     requires std::floating_point<T>
 class NotNaN
 {
   private:
     T m_value;
 
+    template <typename F, notnan::CheckPolicy P>
+        requires std::floating_point<F>
+    friend class NotNaN;
+
+    friend struct notnan::detail::UncheckedAccess;
+
+    template <typename R>
+    using Result = typename Policy::template Result<R>;
+
+    // What the try functions return, regardless of the policy.
+    // They never raise, the error is always handed back. Under a policy without checks they always succeed.
+    template <typename R>
+    using Expected = std::expected<R, notnan::NaNError>;
+
+    constexpr NotNaN(notnan::detail::UncheckedTag /* tag */, const T& value) noexcept : m_value {value}
+    {
+        // empty
+    }
+
+    // Checks a result and wraps it into NotNaN<F>
+    template <std::floating_point F>
+    [[nodiscard]]
+    static constexpr auto tryMake(const F& value, const notnan::Operation operation) noexcept
+      -> Expected<NotNaN<F, Policy>>
+    {
+        if (isBadResult(value)) [[unlikely]]
+        {
+            return std::unexpected(notnan::NaNError {operation, notnan::Operand::Result});
+        }
+        return NotNaN<F, Policy> {notnan::detail::UncheckedTag {}, value};
+    }
+
+    // The result of a mixed operation as T. The 16 bit formats have no implicit conversion from wider types, their
+    // results are rounded explicitly. Rounding can't give NaN.
+    template <typename CT>
+    [[nodiscard]]
+    static constexpr auto toValue(const CT& value) noexcept -> T
+    {
+        if constexpr (notnan::detail::IsHalfPrecision<T>)
+        {
+            return static_cast<T>(value);
+        }
+        else
+        {
+            // no static_cast<T>(value) to force compiler warnings on caller site for incompatible types
+            return value;
+        }
+    }
+
+    template <typename CT>
+    [[nodiscard]]
+    static constexpr auto tryMake(const Expected<CT>& value) noexcept -> Expected<NotNaN>
+    {
+        if (!value) [[unlikely]]
+        {
+            return std::unexpected(value.error());
+        }
+        return NotNaN(notnan::detail::UncheckedTag {}, toValue(*value));
+    }
+
+    // The failure path of all operations, kept out of line so the checks stay small where they are inlined.
+    // Takes the error by value, a reference would keep the checked result from living in a register.
+    template <typename R>
+    [[nodiscard, gnu::cold, gnu::noinline]]
+    static constexpr auto failure(const notnan::NaNError error) -> Result<R>
+    {
+        return Policy::template failure<R>(error);
+    }
+
+    // Hands the outcome of a try function to the policy
+    template <typename R>
+    [[nodiscard]]
+    static constexpr auto toResult(const Expected<R>& value) -> Result<R>
+    {
+        if (!value) [[unlikely]]
+        {
+            return failure<R>(value.error());
+        }
+        return Policy::template success<R>(*value);
+    }
+
+    template <std::floating_point F>
+    [[nodiscard]]
+    static constexpr auto makeResult(const F& value, const notnan::Operation operation) -> Result<NotNaN<F, Policy>>
+    {
+        return toResult(tryMake(value, operation));
+    }
+
+    template <typename CT>
+    [[nodiscard]]
+    constexpr auto assignResult(const Expected<CT>& value) -> Result<NotNaN&>
+    {
+        if (!value) [[unlikely]]
+        {
+            return failure<NotNaN&>(value.error());
+        }
+        m_value = toValue(*value);
+        return Policy::template success<NotNaN&>(*this);
+    }
+
+    // Checks an argument that is not a NotNaN
+    template <typename U>
+    [[nodiscard]]
+    static constexpr auto isBadArgument(const U& value) noexcept -> bool
+    {
+        if constexpr (Policy::CHECKED && std::floating_point<U>)
+        {
+            return notnan::isNaN(value);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // Checks the result of an operation.
+    // Deferred policies skip this while they are deferring, e.g. inside a NaNGuardScope.
+    template <typename U>
+    [[nodiscard]]
+    static constexpr auto isBadResult(const U& value) noexcept -> bool
+    {
+        if (notnan::detail::isDeferringResultCheck<Policy>())
+        {
+            return false;
+        }
+        return isBadArgument(value);
+    }
+
+    static constexpr void checkValue(const auto& value, const notnan::Operation operation)
+    {
+        if (isBadArgument(value)) [[unlikely]]
+        {
+            Policy::raise({operation, notnan::Operand::Value});
+        }
+    }
+
   protected:
+    template <typename CT, typename BinaryOp>
+    [[nodiscard]]
+    static constexpr auto checkResult(const CT& value) noexcept -> Expected<CT>
+    {
+        if (isBadResult(value)) [[unlikely]]
+        {
+            return Expected<CT> {std::unexpect, notnan::detail::OPERATION_OF<BinaryOp>, notnan::Operand::Result};
+        }
+        return Expected<CT> {value};
+    }
+
     // NotNaN lhs (implied), arithmetic rhs
+    // The implied lhs is known not to be NaN, so it is not checked again
     template <typename U, typename BinaryOp>
         requires (std::is_arithmetic_v<std::remove_cvref_t<U>> && std::regular_invocable<BinaryOp, T, U>)
     [[nodiscard]]
     constexpr auto arithmeticHelper(const U& rhs, const BinaryOp& operation) const
     {
-        return arithmeticHelper(m_value, rhs, operation);
+        using CT = std::common_type_t<T, U>;
+
+        if (isBadArgument(rhs)) [[unlikely]]
+        {
+            return Expected<CT> {std::unexpect, notnan::detail::OPERATION_OF<BinaryOp>, notnan::Operand::Rhs};
+        }
+
+        // no static_cast<T>(lhs | rhs) to force compiler warnings on caller site for incompatible types
+        return checkResult<CT, BinaryOp>(notnan::detail::compute<CT>(operation, m_value, rhs));
     }
 
     // arithmetic lhs and arithmetic rhs
@@ -34,53 +820,53 @@ class NotNaN
         requires std::regular_invocable<BinaryOp, decltype(lhs), U>
                  && std::is_arithmetic_v<std::remove_cvref_t<decltype(lhs)>>
     {
-        if (std::isnan(lhs))
+        using CT                              = std::common_type_t<std::remove_cvref_t<decltype(lhs)>, U>;
+        constexpr notnan::Operation OPERATION = notnan::detail::OPERATION_OF<BinaryOp>;
+
+        if (isBadArgument(lhs)) [[unlikely]]
         {
-            throw std::invalid_argument(std::format("lhs is {}", lhs));
+            return Expected<CT> {std::unexpect, OPERATION, notnan::Operand::Lhs};
         }
-        if (std::isnan(rhs))
+        if (isBadArgument(rhs)) [[unlikely]]
         {
-            throw std::invalid_argument(std::format("rhs is {}", rhs));
+            return Expected<CT> {std::unexpect, OPERATION, notnan::Operand::Rhs};
         }
 
-        using CT = std::common_type_t<decltype(lhs), U>;
         // no static_cast<T>(lhs | rhs) to force compiler warnings on caller site for incompatible types
-        CT val   = operation(lhs, rhs);
-        if (std::isnan(val))
-        {
-            throw std::runtime_error(std::format("Result is {}", val));
-        }
-        return val;
+        return checkResult<CT, BinaryOp>(notnan::detail::compute<CT>(operation, lhs, rhs));
     }
 
     // NotNaN lhs (implied), NotNaN rhs
     template <std::floating_point F, typename BinaryOp>
         requires std::regular_invocable<BinaryOp, T, F>
     [[nodiscard]]
-    constexpr auto arithmeticHelper(const NotNaN<F>& rhs, const BinaryOp& operation) const
+    constexpr auto arithmeticHelper(const NotNaN<F, Policy>& rhs, const BinaryOp& operation) const
     {
-        return arithmeticHelper(m_value, rhs, operation);
+        // no static_cast<T>(lhs | rhs) to force compiler warnings on caller site for incompatible types
+        using CT = std::common_type_t<T, F>;
+        return checkResult<CT, BinaryOp>(notnan::detail::compute<CT>(operation, m_value, *rhs));
     }
 
     // arithmetic lhs, NotNaN rhs
     template <std::floating_point F, typename BinaryOp>
     [[nodiscard]]
-    static constexpr auto arithmeticHelper(const auto& lhs, const NotNaN<F>& rhs, const BinaryOp& operation)
+    static constexpr auto arithmeticHelper(const auto& lhs, const NotNaN<F, Policy>& rhs, const BinaryOp& operation)
         requires std::is_arithmetic_v<std::remove_cvref_t<decltype(lhs)>>
     {
-        using CT = std::common_type_t<decltype(lhs), F>;
-        // no static_cast<T>(lhs | rhs) to force compiler warnings on caller site for incompatible types
-        CT val   = operation(lhs, *rhs);
-        if (std::isnan(val))
+        using CT = std::common_type_t<std::remove_cvref_t<decltype(lhs)>, F>;
+
+        if (isBadArgument(lhs)) [[unlikely]]
         {
-            throw std::runtime_error(std::format("Result is {}", val));
+            return Expected<CT> {std::unexpect, notnan::detail::OPERATION_OF<BinaryOp>, notnan::Operand::Lhs};
         }
-        return val;
+
+        // no static_cast<T>(lhs | rhs) to force compiler warnings on caller site for incompatible types
+        return checkResult<CT, BinaryOp>(notnan::detail::compute<CT>(operation, lhs, *rhs));
     }
 
   public:
-    using Type = T;
-
+    using Type        = T;
+    using PolicyType  = Policy;
     // Default constructor
     NotNaN()   = delete;    // force initialization
     ~NotNaN()  = default;
@@ -88,26 +874,62 @@ class NotNaN
     // Constructor with value
     constexpr explicit NotNaN(const T& value) : m_value {value}
     {
-        if (std::isnan(value))
+        checkValue(value, notnan::Operation::Construct);
+    }
+
+    // Construction that reports NaN through the policy's result type instead of raising
+    [[nodiscard]]
+    static constexpr auto fromValue(const T& value) -> Result<NotNaN>
+    {
+        return toResult(tryFromValue(value));
+    }
+
+    // Construction that reports NaN through std::expected, whatever the policy
+    [[nodiscard]]
+    static constexpr auto tryFromValue(const T& value) noexcept -> Expected<NotNaN>
+    {
+        if (isBadArgument(value)) [[unlikely]]
         {
-            throw std::invalid_argument(std::format("Can not construct with {}", value));
+            return std::unexpected(notnan::NaNError {notnan::Operation::Construct, notnan::Operand::Value});
         }
+        return NotNaN {notnan::detail::UncheckedTag {}, value};
+    }
+
+    // Big-endian bytes whose memcmp order is the order of <=>, e.g. for keys of sorted key-value stores.
+    // -0.0 is written as +0.0, so that equal values have equal bytes.
+    static constexpr std::size_t ORDERED_SIZE = notnan::detail::ORDERED_SIZE<T>;
+
+    [[nodiscard]]
+    constexpr auto toOrderedBytes() const noexcept -> std::array<std::byte, ORDERED_SIZE>
+        requires notnan::detail::HasOrderedBytes<T>
+    {
+        std::array<std::byte, ORDERED_SIZE> bytes {};
+        notnan::detail::encodeOrdered(m_value, bytes.data());
+        return bytes;
     }
 
-    // Copy constructor from other NotNaN
+    // The inverse of toOrderedBytes. Bytes of a NaN are handled like fromValue does.
+    [[nodiscard]]
+    static constexpr auto fromOrderedBytes(const std::span<const std::byte, ORDERED_SIZE> bytes) -> Result<NotNaN>
+        requires notnan::detail::HasOrderedBytes<T>
+    {
+        return fromValue(notnan::detail::decodeOrdered<T>(bytes.data()));
+    }
+
+    // Copy constructor from other NotNaN, explicit like a static_cast, which also narrows to the 16 bit formats
     template <std::floating_point F>
         requires (!std::same_as<T, F>)
-    constexpr explicit NotNaN(const NotNaN<F>& other) noexcept : m_value(*other)
+    constexpr explicit NotNaN(const NotNaN<F, Policy>& other) noexcept : m_value(toValue(*other))
     {
         // empty
     }
 
     constexpr NotNaN(const NotNaN& other) noexcept = default;
 
-    // Move constructor from other NotNaN
+    // Move constructor from other NotNaN, where F converts implicitly, which excludes narrowing to the 16 bit formats
     template <std::floating_point F>
-    constexpr NotNaN(NotNaN<F>&& other) noexcept
-        requires (!std::same_as<T, F>)
+    constexpr NotNaN(NotNaN<F, Policy>&& other) noexcept
+        requires (!std::same_as<T, F> && std::convertible_to<F, T>)
             : m_value(*other)
     {
         // empty
@@ -117,8 +939,8 @@ class NotNaN
 
     // Copy assignment from other NotNaN
     template <std::floating_point F>
-    constexpr auto operator= (const NotNaN<F>& other) noexcept -> NotNaN&
-        requires (!std::same_as<T, F>)
+    constexpr auto operator= (const NotNaN<F, Policy>& other) noexcept -> NotNaN&
+        requires (!std::same_as<T, F> && std::convertible_to<F, T>)
     {
         // no self check required because we know T != F
         m_value = *other;
@@ -129,8 +951,8 @@ class NotNaN
 
     // Move assignment from other NotNaN
     template <std::floating_point F>
-    constexpr auto operator= (NotNaN<F>&& other) noexcept -> NotNaN&
-        requires (!std::same_as<T, F>)
+    constexpr auto operator= (NotNaN<F, Policy>&& other) noexcept -> NotNaN&
+        requires (!std::same_as<T, F> && std::convertible_to<F, T>)
     {
         // no self check required because we know T != F
         m_value = *other;
@@ -140,16 +962,16 @@ class NotNaN
     constexpr auto operator= (NotNaN&& other) noexcept -> NotNaN& = default;
 
     // Copy assignment from value
-    constexpr auto operator= (const auto& value) -> NotNaN&
+    constexpr auto operator= (const auto& value) -> Result<NotNaN&>
         requires std::is_arithmetic_v<std::remove_cvref_t<decltype(value)>>
     {
-        if (std::isnan(value))
+        if (isBadArgument(value)) [[unlikely]]
         {
-            throw std::invalid_argument(std::format("Can not assign {}", value));
+            return failure<NotNaN&>({notnan::Operation::Assign, notnan::Operand::Value});
         }
         // no static_cast<T>(value) to force compiler warnings on caller site for incompatible types
         m_value = value;
-        return *this;
+        return Policy::template success<NotNaN&>(*this);
     }
 
     // Getting the value
@@ -175,10 +997,10 @@ class NotNaN
 
     template <std::floating_point F>
     [[nodiscard]]
-    explicit operator NotNaN<F> () const noexcept
+    explicit operator NotNaN<F, Policy> () const noexcept
         requires (!std::same_as<T, F>)
     {
-        return {m_value};
+        return NotNaN<F, Policy> {notnan::detail::UncheckedTag {}, static_cast<F>(m_value)};
     }
 
     // Comparison
@@ -186,10 +1008,7 @@ class NotNaN
     friend constexpr auto operator<=> (const auto& lhs, const NotNaN& rhs)
         requires std::is_arithmetic_v<std::remove_cvref_t<decltype(lhs)>>
     {
-        if (std::isnan(lhs))
-        {
-            throw std::invalid_argument(std::format("Can not compare with {}", lhs));
-        }
+        checkValue(lhs, notnan::Operation::Compare);
         // no static_cast<T>(lhs) to force compiler warnings on caller site for incompatible types
         return lhs <=> *rhs;
     }
@@ -197,29 +1016,32 @@ class NotNaN
     constexpr auto operator<=> (const auto& rhs) const
         requires std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
     {
-        if (std::isnan(rhs))
-        {
-            throw std::invalid_argument(std::format("Can not compare with {}", rhs));
-        }
+        checkValue(rhs, notnan::Operation::Compare);
         // no static_cast<T>(value) to force compiler warnings on caller site for incompatible types
         return m_value <=> rhs;
     }
+    // Without NaN the values are totally ordered. -0.0 and +0.0 are equivalent, as with ==, and hash the same.
     template <std::floating_point F>
     [[nodiscard]]
-    constexpr auto operator<=> (const NotNaN<F>& rhs) const noexcept
+    constexpr auto operator<=> (const NotNaN<F, Policy>& rhs) const noexcept -> std::strong_ordering
     {
         // no static_cast<T>(value) to force compiler warnings on caller site for incompatible types
-        return m_value <=> *rhs;
+        if (m_value < *rhs)
+        {
+            return std::strong_ordering::less;
+        }
+        if (*rhs < m_value)
+        {
+            return std::strong_ordering::greater;
+        }
+        return std::strong_ordering::equal;
     }
 
     [[nodiscard]]
     friend constexpr auto operator== (const auto& lhs, const NotNaN& rhs) -> bool
         requires std::is_arithmetic_v<std::remove_cvref_t<decltype(lhs)>>
     {
-        if (std::isnan(lhs))
-        {
-            throw std::invalid_argument(std::format("Can not compare with {}", lhs));
-        }
+        checkValue(lhs, notnan::Operation::Compare);
         // no static_cast<T>(lhs) to force compiler warnings on caller site for incompatible types
         return lhs == *rhs;
     }
@@ -228,406 +1050,1317 @@ class NotNaN
     constexpr auto operator== (const auto& rhs) const -> bool
         requires std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
     {
-        if (std::isnan(rhs))
-        {
-            throw std::invalid_argument(std::format("Can not compare with {}", rhs));
-        }
+        checkValue(rhs, notnan::Operation::Compare);
         // no static_cast<T>(value) to force compiler warnings on caller site for incompatible types
         return m_value == rhs;
     }
     template <std::floating_point F>
     [[nodiscard]]
-    constexpr auto operator== (const NotNaN<F> rhs) const noexcept -> bool
+    constexpr auto operator== (const NotNaN<F, Policy> rhs) const noexcept -> bool
     {
         // no static_cast<T>(value) to force compiler warnings on caller site for incompatible types
         return m_value == *rhs;
     }
 
     // Addition
-    friend constexpr auto operator+ (const auto& lhs, const NotNaN& rhs)
+    friend constexpr auto operator+ (const auto& lhs, const NotNaN& rhs) -> Result<NotNaN>
         requires std::is_arithmetic_v<std::remove_cvref_t<decltype(lhs)>>
     {
-        return NotNaN(arithmeticHelper(lhs, rhs, std::plus {}));
+        return toResult(tryMake(arithmeticHelper(lhs, rhs, std::plus {})));
     }
-    constexpr auto operator+ (const auto& rhs) const
+    constexpr auto operator+ (const auto& rhs) const -> Result<NotNaN>
         requires (
           std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
-          || std::convertible_to<std::remove_cvref_t<decltype(rhs)>, NotNaN>
+          || notnan::IsNotNaN<std::remove_cvref_t<decltype(rhs)>>
         )
     {
-        return NotNaN(arithmeticHelper(rhs, std::plus {}));
+        return toResult(tryAdd(rhs));
     }
-    constexpr auto operator+= (const auto& rhs)
+    [[nodiscard]]
+    constexpr auto tryAdd(const auto& rhs) const noexcept -> Expected<NotNaN>
         requires (
           std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
-          || std::convertible_to<std::remove_cvref_t<decltype(rhs)>, NotNaN>
+          || notnan::IsNotNaN<std::remove_cvref_t<decltype(rhs)>>
         )
     {
-        m_value = arithmeticHelper(rhs, std::plus {});
-        return *this;
+        return tryMake(arithmeticHelper(rhs, std::plus {}));
+    }
+    constexpr auto operator+= (const auto& rhs) -> Result<NotNaN&>
+        requires (
+          std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
+          || notnan::IsNotNaN<std::remove_cvref_t<decltype(rhs)>>
+        )
+    {
+        return assignResult(arithmeticHelper(rhs, std::plus {}));
     }
 
     // Subtraction
-    friend constexpr auto operator- (const auto& lhs, const NotNaN& rhs)
+    friend constexpr auto operator- (const auto& lhs, const NotNaN& rhs) -> Result<NotNaN>
         requires std::is_arithmetic_v<std::remove_cvref_t<decltype(lhs)>>
     {
-        return NotNaN(arithmeticHelper(lhs, rhs, std::minus {}));
+        return toResult(tryMake(arithmeticHelper(lhs, rhs, std::minus {})));
     }
-    constexpr auto operator- (const auto& rhs) const
+    constexpr auto operator- (const auto& rhs) const -> Result<NotNaN>
         requires (
           std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
-          || std::convertible_to<std::remove_cvref_t<decltype(rhs)>, NotNaN>
+          || notnan::IsNotNaN<std::remove_cvref_t<decltype(rhs)>>
         )
     {
-        return NotNaN(arithmeticHelper(rhs, std::minus {}));
+        return toResult(trySubtract(rhs));
     }
-    constexpr auto operator-= (const auto& rhs)
+    [[nodiscard]]
+    constexpr auto trySubtract(const auto& rhs) const noexcept -> Expected<NotNaN>
         requires (
           std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
-          || std::convertible_to<std::remove_cvref_t<decltype(rhs)>, NotNaN>
+          || notnan::IsNotNaN<std::remove_cvref_t<decltype(rhs)>>
         )
     {
-        m_value = arithmeticHelper(rhs, std::minus {});
-        return *this;
+        return tryMake(arithmeticHelper(rhs, std::minus {}));
+    }
+    constexpr auto operator-= (const auto& rhs) -> Result<NotNaN&>
+        requires (
+          std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
+          || notnan::IsNotNaN<std::remove_cvref_t<decltype(rhs)>>
+        )
+    {
+        return assignResult(arithmeticHelper(rhs, std::minus {}));
+    }
+
+    // Multiplication
+    friend constexpr auto operator* (const auto& lhs, const NotNaN& rhs) -> Result<NotNaN>
+        requires std::is_arithmetic_v<std::remove_cvref_t<decltype(lhs)>>
+    {
+        return toResult(tryMake(arithmeticHelper(lhs, rhs, std::multiplies {})));
+    }
+    constexpr auto operator* (const auto& rhs) const -> Result<NotNaN>
+        requires (
+          std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
+          || notnan::IsNotNaN<std::remove_cvref_t<decltype(rhs)>>
+        )
+    {
+        return toResult(tryMultiply(rhs));
+    }
+    [[nodiscard]]
+    constexpr auto tryMultiply(const auto& rhs) const noexcept -> Expected<NotNaN>
+        requires (
+          std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
+          || notnan::IsNotNaN<std::remove_cvref_t<decltype(rhs)>>
+        )
+    {
+        return tryMake(arithmeticHelper(rhs, std::multiplies {}));
+    }
+    constexpr auto operator*= (const auto& rhs) -> Result<NotNaN&>
+        requires (
+          std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
+          || notnan::IsNotNaN<std::remove_cvref_t<decltype(rhs)>>
+        )
+    {
+        return assignResult(arithmeticHelper(rhs, std::multiplies {}));
+    }
+
+    // Division
+    friend constexpr auto operator/ (const auto& lhs, const NotNaN& rhs) -> Result<NotNaN>
+        requires std::is_arithmetic_v<std::remove_cvref_t<decltype(lhs)>>
+    {
+        return toResult(tryMake(arithmeticHelper(lhs, rhs, std::divides {})));
+    }
+    constexpr auto operator/ (const auto& rhs) const -> Result<NotNaN>
+        requires (
+          std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
+          || notnan::IsNotNaN<std::remove_cvref_t<decltype(rhs)>>
+        )
+    {
+        return toResult(tryDivide(rhs));
+    }
+    [[nodiscard]]
+    constexpr auto tryDivide(const auto& rhs) const noexcept -> Expected<NotNaN>
+        requires (
+          std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
+          || notnan::IsNotNaN<std::remove_cvref_t<decltype(rhs)>>
+        )
+    {
+        return tryMake(arithmeticHelper(rhs, std::divides {}));
+    }
+    constexpr auto operator/= (const auto& rhs) -> Result<NotNaN&>
+        requires (
+          std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
+          || notnan::IsNotNaN<std::remove_cvref_t<decltype(rhs)>>
+        )
+    {
+        return assignResult(arithmeticHelper(rhs, std::divides {}));
+    }
+
+    // Unary operators
+    constexpr auto operator+ () const noexcept -> NotNaN { return NotNaN {notnan::detail::UncheckedTag {}, +m_value}; }
+    constexpr auto operator- () const noexcept -> NotNaN { return NotNaN {notnan::detail::UncheckedTag {}, -m_value}; }
+
+    // Boolean nonsense
+    [[nodiscard]]
+    constexpr auto operator!() const noexcept -> bool
+    {
+        return !static_cast<bool>(m_value);
+    }
+
+    // special functions
+    // logs and powers
+
+    [[nodiscard]]
+    constexpr auto sqrt() const -> Result<NotNaN>
+    {
+        return toResult(trySqrt());
+    }
+    [[nodiscard]]
+    constexpr auto trySqrt() const noexcept -> Expected<NotNaN>
+    {
+        return tryMake(std::sqrt(m_value), notnan::Operation::Sqrt);
+    }
+    [[nodiscard]]
+    constexpr auto cbrt() const -> Result<NotNaN>
+    {
+        return toResult(tryCbrt());
+    }
+    [[nodiscard]]
+    constexpr auto tryCbrt() const noexcept -> Expected<NotNaN>
+    {
+        return tryMake(std::cbrt(m_value), notnan::Operation::Cbrt);
+    }
+
+    template <typename U>
+        requires std::is_arithmetic_v<U>
+    [[nodiscard]]
+    constexpr auto pow(const U& rhs) const -> Result<NotNaN<std::common_type_t<T, U>, Policy>>
+    {
+        return toResult(tryPow(rhs));
+    }
+    template <typename U>
+        requires std::is_arithmetic_v<U>
+    [[nodiscard]]
+    constexpr auto tryPow(const U& rhs) const noexcept -> Expected<NotNaN<std::common_type_t<T, U>, Policy>>
+    {
+        using CT = std::common_type_t<T, U>;
+        if (isBadArgument(rhs)) [[unlikely]]
+        {
+            return std::unexpected(notnan::NaNError {notnan::Operation::Pow, notnan::Operand::Rhs});
+        }
+        return tryMake(std::pow(static_cast<CT>(m_value), static_cast<CT>(rhs)), notnan::Operation::Pow);
+    }
+
+    template <std::floating_point F>
+    [[nodiscard]]
+    constexpr auto pow(const NotNaN<F, Policy>& rhs) const -> Result<NotNaN<std::common_type_t<T, F>, Policy>>
+    {
+        return toResult(tryPow(rhs));
+    }
+    template <std::floating_point F>
+    [[nodiscard]]
+    constexpr auto tryPow(const NotNaN<F, Policy>& rhs) const noexcept -> Expected<NotNaN<std::common_type_t<T, F>, Policy>>
+    {
+        using CT = std::common_type_t<T, F>;
+        return tryMake(std::pow(static_cast<CT>(m_value), static_cast<CT>(rhs)), notnan::Operation::Pow);
+    }
+
+    // natural log (base e)
+    [[nodiscard]]
+    constexpr auto log() const -> Result<NotNaN>
+    {
+        return toResult(tryLog());
+    }
+    [[nodiscard]]
+    constexpr auto tryLog() const noexcept -> Expected<NotNaN>
+    {
+        return tryMake(std::log(m_value), notnan::Operation::Log);
+    }
+
+    [[nodiscard]]
+    constexpr auto log2() const -> Result<NotNaN>
+    {
+        return toResult(tryLog2());
+    }
+    [[nodiscard]]
+    constexpr auto tryLog2() const noexcept -> Expected<NotNaN>
+    {
+        return tryMake(std::log2(m_value), notnan::Operation::Log2);
+    }
+
+    [[nodiscard]]
+    constexpr auto log10() const -> Result<NotNaN>
+    {
+        return toResult(tryLog10());
+    }
+    [[nodiscard]]
+    constexpr auto tryLog10() const noexcept -> Expected<NotNaN>
+    {
+        return tryMake(std::log10(m_value), notnan::Operation::Log10);
+    }
+
+    template <typename U>
+        requires std::is_arithmetic_v<U>
+    [[nodiscard]]
+    constexpr auto logBase(const U& base) const -> Result<NotNaN<std::common_type_t<T, U>, Policy>>
+    {
+        return toResult(tryLogBase(base));
+    }
+    template <typename U>
+        requires std::is_arithmetic_v<U>
+    [[nodiscard]]
+    constexpr auto tryLogBase(const U& base) const noexcept -> Expected<NotNaN<std::common_type_t<T, U>, Policy>>
+    {
+        using CT = std::common_type_t<T, U>;
+        if (isBadArgument(base)) [[unlikely]]
+        {
+            return std::unexpected(notnan::NaNError {notnan::Operation::LogBase, notnan::Operand::Rhs});
+        }
+        return tryMake(
+          std::log(static_cast<CT>(m_value)) / std::log(static_cast<CT>(base)), notnan::Operation::LogBase);
+    }
+
+    template <std::floating_point F>
+    [[nodiscard]]
+    constexpr auto logBase(const NotNaN<F, Policy>& base) const -> Result<NotNaN<std::common_type_t<T, F>, Policy>>
+    {
+        return toResult(tryLogBase(base));
+    }
+    template <std::floating_point F>
+    [[nodiscard]]
+    constexpr auto tryLogBase(const NotNaN<F, Policy>& base) const noexcept -> Expected<NotNaN<std::common_type_t<T, F>, Policy>>
+    {
+        using CT = std::common_type_t<T, F>;
+        return tryMake(
+          std::log(static_cast<CT>(m_value)) / std::log(static_cast<CT>(base)), notnan::Operation::LogBase);
+    }
+
+    [[nodiscard]]
+    constexpr auto log1p() const -> Result<NotNaN>
+    {
+        return toResult(tryLog1p());
+    }
+    [[nodiscard]]
+    constexpr auto tryLog1p() const noexcept -> Expected<NotNaN>
+    {
+        return tryMake(std::log1p(m_value), notnan::Operation::Log1p);
+    }
+
+    // e ^ m_value
+    [[nodiscard]]
+    constexpr auto exp() const -> Result<NotNaN>
+    {
+        return toResult(tryExp());
+    }
+    [[nodiscard]]
+    constexpr auto tryExp() const noexcept -> Expected<NotNaN>
+    {
+        return tryMake(std::exp(m_value), notnan::Operation::Exp);
+    }
+
+    [[nodiscard]]
+    constexpr auto exp2() const -> Result<NotNaN>
+    {
+        return toResult(tryExp2());
+    }
+    [[nodiscard]]
+    constexpr auto tryExp2() const noexcept -> Expected<NotNaN>
+    {
+        return tryMake(std::exp2(m_value), notnan::Operation::Exp2);
+    }
+
+    [[nodiscard]]
+    constexpr auto expm1() const -> Result<NotNaN>
+    {
+        return toResult(tryExpm1());
+    }
+    [[nodiscard]]
+    constexpr auto tryExpm1() const noexcept -> Expected<NotNaN>
+    {
+        return tryMake(std::expm1(m_value), notnan::Operation::Expm1);
+    }
+
+    // values and rounding
+
+    [[nodiscard]]
+    constexpr auto abs() const -> Result<NotNaN>
+    {
+        return makeResult(std::abs(m_value), notnan::Operation::Abs);
+    }
+
+    [[nodiscard]]
+    constexpr auto floor() const -> Result<NotNaN>
+    {
+        return makeResult(std::floor(m_value), notnan::Operation::Floor);
+    }
+
+    [[nodiscard]]
+    constexpr auto ceil() const -> Result<NotNaN>
+    {
+        return makeResult(std::ceil(m_value), notnan::Operation::Ceil);
+    }
+
+    [[nodiscard]]
+    constexpr auto round() const -> Result<NotNaN>
+    {
+        return makeResult(std::round(m_value), notnan::Operation::Round);
+    }
+
+    [[nodiscard]]
+    constexpr auto modf(NotNaN* const iptr) const -> Result<NotNaN>
+    {
+        T integralPart;
+        T fractionalPart = std::modf(m_value, &integralPart);
+        // neither part of a number can be NaN
+        *iptr            = NotNaN {notnan::detail::UncheckedTag {}, integralPart};
+        return makeResult(fractionalPart, notnan::Operation::Modf);
+    }
+
+    // trigonometry
+
+    [[nodiscard]]
+    constexpr auto sin() const -> Result<NotNaN>
+    {
+        return toResult(trySin());
+    }
+    [[nodiscard]]
+    constexpr auto trySin() const noexcept -> Expected<NotNaN>
+    {
+        return tryMake(std::sin(m_value), notnan::Operation::Sin);
+    }
+
+    [[nodiscard]]
+    constexpr auto cos() const -> Result<NotNaN>
+    {
+        return toResult(tryCos());
+    }
+    [[nodiscard]]
+    constexpr auto tryCos() const noexcept -> Expected<NotNaN>
+    {
+        return tryMake(std::cos(m_value), notnan::Operation::Cos);
+    }
+
+    [[nodiscard]]
+    constexpr auto tan() const -> Result<NotNaN>
+    {
+        return toResult(tryTan());
+    }
+    [[nodiscard]]
+    constexpr auto tryTan() const noexcept -> Expected<NotNaN>
+    {
+        return tryMake(std::tan(m_value), notnan::Operation::Tan);
     }
 
-    // Multiplication
-    friend constexpr auto operator* (const auto& lhs, const NotNaN& rhs)
-        requires std::is_arithmetic_v<std::remove_cvref_t<decltype(lhs)>>
+    [[nodiscard]]
+    constexpr auto asin() const -> Result<NotNaN>
     {
-        return NotNaN(arithmeticHelper(lhs, rhs, std::multiplies {}));
+        return toResult(tryAsin());
     }
-    constexpr auto operator* (const auto& rhs) const
-        requires (
-          std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
-          || std::convertible_to<std::remove_cvref_t<decltype(rhs)>, NotNaN>
-        )
+    [[nodiscard]]
+    constexpr auto tryAsin() const noexcept -> Expected<NotNaN>
     {
-        return NotNaN(arithmeticHelper(rhs, std::multiplies {}));
+        return tryMake(std::asin(m_value), notnan::Operation::Asin);
     }
-    constexpr auto operator*= (const auto& rhs)
-        requires (
-          std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
-          || std::convertible_to<std::remove_cvref_t<decltype(rhs)>, NotNaN>
-        )
+
+    [[nodiscard]]
+    constexpr auto acos() const -> Result<NotNaN>
     {
-        m_value = arithmeticHelper(rhs, std::multiplies {});
-        return *this;
+        return toResult(tryAcos());
     }
-
-    // Division
-    friend constexpr auto operator/ (const auto& lhs, const NotNaN& rhs)
-        requires std::is_arithmetic_v<std::remove_cvref_t<decltype(lhs)>>
+    [[nodiscard]]
+    constexpr auto tryAcos() const noexcept -> Expected<NotNaN>
     {
-        return NotNaN(arithmeticHelper(lhs, rhs, std::divides {}));
+        return tryMake(std::acos(m_value), notnan::Operation::Acos);
     }
-    constexpr auto operator/ (const auto& rhs) const
-        requires (
-          std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
-          || std::convertible_to<std::remove_cvref_t<decltype(rhs)>, NotNaN>
-        )
+
+    [[nodiscard]]
+    constexpr auto atan() const -> Result<NotNaN>
     {
-        return NotNaN(arithmeticHelper(rhs, std::divides {}));
+        return toResult(tryAtan());
     }
-    constexpr auto operator/= (const auto& rhs)
-        requires (
-          std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
-          || std::convertible_to<std::remove_cvref_t<decltype(rhs)>, NotNaN>
-        )
+    [[nodiscard]]
+    constexpr auto tryAtan() const noexcept -> Expected<NotNaN>
     {
-        m_value = arithmeticHelper(rhs, std::divides {});
-        return *this;
+        return tryMake(std::atan(m_value), notnan::Operation::Atan);
     }
 
-    // Unary operators
-    constexpr auto operator+ () const noexcept -> NotNaN { return NotNaN(+m_value); }
-    constexpr auto operator- () const noexcept -> NotNaN { return NotNaN(-m_value); }
-
-    // Boolean nonsense
+    template <typename U>
+        requires std::is_arithmetic_v<U>
     [[nodiscard]]
-    constexpr auto operator!() const noexcept -> bool
+    constexpr auto atan2(const U& y) const -> Result<NotNaN<std::common_type_t<T, U>, Policy>>
     {
-        return !static_cast<bool>(m_value);
+        return toResult(tryAtan2(y));
+    }
+    template <typename U>
+        requires std::is_arithmetic_v<U>
+    [[nodiscard]]
+    constexpr auto tryAtan2(const U& y) const noexcept -> Expected<NotNaN<std::common_type_t<T, U>, Policy>>
+    {
+        using CT = std::common_type_t<T, U>;
+        if (isBadArgument(y)) [[unlikely]]
+        {
+            return std::unexpected(notnan::NaNError {notnan::Operation::Atan2, notnan::Operand::Rhs});
+        }
+        return tryMake(std::atan2(static_cast<CT>(m_value), static_cast<CT>(y)), notnan::Operation::Atan2);
     }
 
-    // special functions
-    // logs and powers
-
+    template <std::floating_point F>
     [[nodiscard]]
-    constexpr auto sqrt() const -> NotNaN
+    constexpr auto atan2(const NotNaN<F, Policy>& y) const -> Result<NotNaN<std::common_type_t<T, F>, Policy>>
     {
-        return NotNaN {std::sqrt(m_value)};
+        return toResult(tryAtan2(y));
     }
+    template <std::floating_point F>
     [[nodiscard]]
-    constexpr auto cbrt() const -> NotNaN
+    constexpr auto tryAtan2(const NotNaN<F, Policy>& y) const noexcept -> Expected<NotNaN<std::common_type_t<T, F>, Policy>>
     {
-        return NotNaN {std::cbrt(m_value)};
+        using CT = std::common_type_t<T, F>;
+        return tryMake(std::atan2(static_cast<CT>(m_value), static_cast<CT>(y)), notnan::Operation::Atan2);
     }
 
+    template <typename U>
+        requires std::is_arithmetic_v<U>
     [[nodiscard]]
-    constexpr auto pow(const auto& rhs) const
-        requires std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
+    constexpr auto hypot(const U& y) const -> Result<NotNaN<std::common_type_t<T, U>, Policy>>
     {
-        using CT = std::common_type_t<T, std::remove_cvref_t<decltype(rhs)>>;
-        if (std::isnan(rhs))
+        return toResult(tryHypot(y));
+    }
+    template <typename U>
+        requires std::is_arithmetic_v<U>
+    [[nodiscard]]
+    constexpr auto tryHypot(const U& y) const noexcept -> Expected<NotNaN<std::common_type_t<T, U>, Policy>>
+    {
+        using CT = std::common_type_t<T, U>;
+        if (isBadArgument(y)) [[unlikely]]
         {
-            throw std::invalid_argument(std::format("Can not raise to the power of {}", rhs));
+            return std::unexpected(notnan::NaNError {notnan::Operation::Hypot, notnan::Operand::Rhs});
         }
-        return NotNaN<CT> {std::pow(static_cast<CT>(m_value), static_cast<CT>(rhs))};
+        return tryMake(std::hypot(static_cast<CT>(m_value), static_cast<CT>(y)), notnan::Operation::Hypot);
     }
 
     template <std::floating_point F>
     [[nodiscard]]
-    constexpr auto pow(const NotNaN<F>& rhs) const
+    constexpr auto hypot(const NotNaN<F, Policy>& y) const -> Result<NotNaN<std::common_type_t<T, F>, Policy>>
+    {
+        return toResult(tryHypot(y));
+    }
+    template <std::floating_point F>
+    [[nodiscard]]
+    constexpr auto tryHypot(const NotNaN<F, Policy>& y) const noexcept -> Expected<NotNaN<std::common_type_t<T, F>, Policy>>
     {
         using CT = std::common_type_t<T, F>;
-        return NotNaN<CT> {std::pow(static_cast<CT>(m_value), static_cast<CT>(rhs))};
+        return tryMake(std::hypot(static_cast<CT>(m_value), static_cast<CT>(y)), notnan::Operation::Hypot);
     }
 
-    // natural log (base e)
+    // error function and complementary error function
     [[nodiscard]]
-    constexpr auto log() const -> NotNaN
+    constexpr auto erf() const -> Result<NotNaN>
     {
-        return NotNaN {std::log(m_value)};
+        return toResult(tryErf());
+    }
+    [[nodiscard]]
+    constexpr auto tryErf() const noexcept -> Expected<NotNaN>
+    {
+        return tryMake(std::erf(m_value), notnan::Operation::Erf);
+    }
+    [[nodiscard]]
+    constexpr auto erfc() const -> Result<NotNaN>
+    {
+        return toResult(tryErfc());
     }
-
     [[nodiscard]]
-    constexpr auto log2() const -> NotNaN
+    constexpr auto tryErfc() const noexcept -> Expected<NotNaN>
     {
-        return NotNaN {std::log2(m_value)};
+        return tryMake(std::erfc(m_value), notnan::Operation::Erfc);
     }
 
+    // gamma
+    [[nodiscard]]
+    constexpr auto tgamma() const -> Result<NotNaN>
+    {
+        return toResult(tryTgamma());
+    }
     [[nodiscard]]
-    constexpr auto log10() const -> NotNaN
+    constexpr auto tryTgamma() const noexcept -> Expected<NotNaN>
     {
-        return NotNaN {std::log10(m_value)};
+        return tryMake(std::tgamma(m_value), notnan::Operation::Tgamma);
+    }
+    [[nodiscard]]
+    constexpr auto lgamma() const -> Result<NotNaN>
+    {
+        return toResult(tryLgamma());
+    }
+    [[nodiscard]]
+    constexpr auto tryLgamma() const noexcept -> Expected<NotNaN>
+    {
+        return tryMake(std::lgamma(m_value), notnan::Operation::Lgamma);
     }
 
+    // midpoint
+    template <typename U>
+        requires std::is_arithmetic_v<U>
+    [[nodiscard]]
+    constexpr auto midpoint(const U& rhs) const -> Result<NotNaN<std::common_type_t<T, U>, Policy>>
+    {
+        return toResult(tryMidpoint(rhs));
+    }
+    template <typename U>
+        requires std::is_arithmetic_v<U>
     [[nodiscard]]
-    constexpr auto logBase(const auto& base)
-        requires std::is_arithmetic_v<std::remove_cvref_t<decltype(base)>>
+    constexpr auto tryMidpoint(const U& rhs) const noexcept -> Expected<NotNaN<std::common_type_t<T, U>, Policy>>
     {
-        using CT = std::common_type_t<T, std::remove_cvref_t<decltype(base)>>;
-        if (std::isnan(base))
+        using CT = std::common_type_t<T, U>;
+        if (isBadArgument(rhs)) [[unlikely]]
         {
-            throw std::invalid_argument(std::format("Base is {}", base));
+            return std::unexpected(notnan::NaNError {notnan::Operation::Midpoint, notnan::Operand::Rhs});
         }
-        return NotNaN<CT> {std::log(static_cast<CT>(m_value)) / std::log(static_cast<CT>(base))};
+        return tryMake(std::midpoint(static_cast<CT>(m_value), static_cast<CT>(rhs)), notnan::Operation::Midpoint);
     }
 
-    template <typename F>
+    template <std::floating_point F>
+    [[nodiscard]]
+    constexpr auto midpoint(const NotNaN<F, Policy>& rhs) const -> Result<NotNaN<std::common_type_t<T, F>, Policy>>
+    {
+        return toResult(tryMidpoint(rhs));
+    }
+    template <std::floating_point F>
     [[nodiscard]]
-    constexpr auto logBase(const NotNaN<F>& base)
+    constexpr auto tryMidpoint(const NotNaN<F, Policy>& rhs) const noexcept -> Expected<NotNaN<std::common_type_t<T, F>, Policy>>
     {
         using CT = std::common_type_t<T, F>;
-        return NotNaN<CT> {std::log(static_cast<CT>(m_value)) / std::log(static_cast<CT>(base))};
+        return tryMake(std::midpoint(static_cast<CT>(m_value), static_cast<CT>(rhs)), notnan::Operation::Midpoint);
     }
 
-    [[nodiscard]]
-    constexpr auto log1p() const -> NotNaN
+    // Stream operators
+    friend auto operator<< (std::ostream& ostream, const NotNaN& value) -> std::ostream&
+    {
+        ostream << *value;
+        return ostream;
+    }
+    friend auto operator>> (std::istream& istream, NotNaN& value) -> std::istream&
     {
-        return NotNaN {std::log1p(m_value)};
+        T val;
+        if (!(istream >> val))
+        {
+            return istream;
+        }
+        // copy assignment checks for NaN
+        if constexpr (std::same_as<Result<NotNaN&>, NotNaN&>)
+        {
+            value = val;
+        }
+        else if (!(value = val))
+        {
+            istream.setstate(std::ios_base::failbit);
+        }
+        return istream;
     }
+};
 
-    // e ^ m_value
-    [[nodiscard]]
-    constexpr auto exp() const -> NotNaN
+// Formatter
+template <std::floating_point T, notnan::CheckPolicy Policy>
+struct std::formatter<NotNaN<T, Policy>> : std::formatter<notnan::detail::FormatType<T>>
+{
+    template <class FormatContext>
+    auto format(const NotNaN<T, Policy>& t, FormatContext& ctx) const
     {
-        return NotNaN {std::exp(m_value)};
+        using F = notnan::detail::FormatType<T>;
+        return std::formatter<F>::format(static_cast<F>(*t), ctx);
     }
+};
 
+namespace notnan
+{
+namespace detail
+{
+    // The representation of a value folded into 64 bits, without the padding of the x87 format
+    template <std::floating_point T>
     [[nodiscard]]
-    constexpr auto exp2() const -> NotNaN
+    constexpr auto hashBits(const T value) noexcept -> std::uint64_t
     {
-        return NotNaN {std::exp2(m_value)};
+        if constexpr (IsInterchangeFormat<T>)
+        {
+            const auto bits = std::bit_cast<typename UnsignedOfSize<sizeof(T)>::Type>(value);
+            if constexpr (sizeof(T) > sizeof(std::uint64_t))
+            {
+                return static_cast<std::uint64_t>(bits) ^ static_cast<std::uint64_t>(bits >> 64U);
+            }
+            else
+            {
+                return static_cast<std::uint64_t>(bits);
+            }
+        }
+        else if constexpr (IsX87Extended<T>)
+        {
+            const auto layout = std::bit_cast<X87Layout<T>>(value);
+            return layout.mantissa ^ (std::uint64_t {layout.signExponent} << 48U);
+        }
+        else
+        {
+            return std::hash<T> {}(value);
+        }
     }
 
+    // The finalizer of MurmurHash3: every input bit flips each output bit with probability about 1/2
     [[nodiscard]]
-    constexpr auto expm1() const -> NotNaN
+    constexpr auto mixBits(std::uint64_t bits) noexcept -> std::uint64_t
     {
-        return NotNaN {std::expm1(m_value)};
+        bits ^= bits >> 33U;
+        bits *= 0xFF51'AFD7'ED55'8CCD;
+        bits ^= bits >> 33U;
+        bits *= 0xC4CE'B9FE'1A85'EC53;
+        bits ^= bits >> 33U;
+        return bits;
     }
 
-    // values and rounding
-
     [[nodiscard]]
-    constexpr auto abs() const -> NotNaN
+    constexpr auto decimalDigits(int value) noexcept -> std::size_t
     {
-        return NotNaN {std::abs(m_value)};
+        std::size_t digits = 1;
+        for (; value >= 10; value /= 10)
+        {
+            ++digits;
+        }
+        return digits;
     }
+}    // namespace detail
 
-    [[nodiscard]]
-    constexpr auto floor() const -> NotNaN
+// The longest text std::to_chars writes for a T in shortest round trip form: sign, digits, point and exponent.
+// Fixed notation is only used when it is not longer than scientific notation.
+template <std::floating_point T>
+constexpr std::size_t MAX_CHARS = 1 + std::numeric_limits<T>::max_digits10 + 1 + 2
+                                  + detail::decimalDigits(
+                                    std::numeric_limits<T>::max_digits10 - std::numeric_limits<T>::min_exponent10
+                                  );
+
+// Writes values separated by delimiter into buffer with std::to_chars, in shortest round trip form.
+// Returns the end of the text, or the end of buffer and std::errc::value_too_large if it does not fit.
+// A buffer of size * (MAX_CHARS<T> + delimiter.size()) always suffices.
+template <std::ranges::input_range R>
+    requires IsNotNaN<std::remove_cvref_t<std::ranges::range_value_t<R>>>
+[[nodiscard]]
+auto writeDelimited(const std::span<char> buffer, const R& values, const std::string_view delimiter = ",") noexcept
+  -> std::to_chars_result
+{
+    char* const last  = buffer.data() + buffer.size();
+    char*       out   = buffer.data();
+    bool        first = true;
+    for (const auto& value : values)
     {
-        return NotNaN {std::floor(m_value)};
+        if (!first)
+        {
+            if (static_cast<std::size_t>(last - out) < delimiter.size()) [[unlikely]]
+            {
+                return {last, std::errc::value_too_large};
+            }
+            out = std::ranges::copy(delimiter, out).out;
+        }
+        first = false;
+
+        // NaN is impossible here, so there is no special value to treat
+        const auto [end, error] = std::to_chars(out, last, *value);
+        if (error != std::errc {}) [[unlikely]]
+        {
+            return {last, error};
+        }
+        out = end;
     }
+    return {out, std::errc {}};
+}
+
+namespace detail
+{
+    // Formats spans of NotNaN like C++23 formats ranges, "[1.5, 2, -3]", with the format spec applied to each element.
+    // Without a spec the elements go through std::to_chars directly, which is the output of {} as well.
+    template <std::floating_point T, CheckPolicy Policy>
+    class RangeFormatter
+    {
+      private:
+        std::formatter<FormatType<T>> m_element;
+        bool                          m_shortest {true};
+
+      public:
+        constexpr auto parse(std::format_parse_context& ctx)
+        {
+            m_shortest = ctx.begin() == ctx.end() || *ctx.begin() == '}';
+            return m_element.parse(ctx);
+        }
+
+        template <class FormatContext>
+        auto format(const std::span<const NotNaN<T, Policy>> values, FormatContext& ctx) const
+        {
+            auto out = ctx.out();
+            *out++   = '[';
+            for (std::size_t idx = 0; idx < values.size(); ++idx)
+            {
+                if (idx != 0)
+                {
+                    *out++ = ',';
+                    *out++ = ' ';
+                }
+                if (m_shortest)
+                {
+                    using F = FormatType<T>;
+                    std::array<char, MAX_CHARS<F>> text;    // NOLINT(cppcoreguidelines-pro-type-member-init)
+                    const auto end = std::to_chars(text.data(), text.data() + text.size(), static_cast<F>(*values[idx])).ptr;
+                    out            = std::copy(text.data(), end, out);
+                }
+                else
+                {
+                    ctx.advance_to(out);
+                    out = m_element.format(static_cast<FormatType<T>>(*values[idx]), ctx);
+                }
+            }
+            *out++ = ']';
+            return out;
+        }
+    };
+}    // namespace detail
+}    // namespace notnan
+
+template <std::floating_point T, notnan::CheckPolicy Policy, std::size_t Extent>
+struct std::formatter<std::span<const NotNaN<T, Policy>, Extent>> : notnan::detail::RangeFormatter<T, Policy>
+{
+};
+
+template <std::floating_point T, notnan::CheckPolicy Policy, std::size_t Extent>
+struct std::formatter<std::span<NotNaN<T, Policy>, Extent>> : notnan::detail::RangeFormatter<T, Policy>
+{
+};
 
+// Hash consistent with ==: -0.0 and +0.0 hash the same. The bits are mixed, so that the low bits are usable for
+// power of two tables even though the low mantissa bits of round values are all zero.
+template <std::floating_point T, notnan::CheckPolicy Policy>
+struct std::hash<NotNaN<T, Policy>>
+{
     [[nodiscard]]
-    constexpr auto ceil() const -> NotNaN
+    constexpr auto operator() (const NotNaN<T, Policy>& value) const noexcept -> std::size_t
     {
-        return NotNaN {std::ceil(m_value)};
+        const T normalized = *value == T {0} ? T {0} : *value;
+        return static_cast<std::size_t>(notnan::detail::mixBits(notnan::detail::hashBits(normalized)));
     }
+};
 
+namespace notnan
+{
+namespace detail
+{
+    template <std::floating_point T>
     [[nodiscard]]
-    constexpr auto round() const -> NotNaN
+    constexpr auto findNaNScalar(const T* const data, const std::size_t first, const std::size_t last) noexcept
+      -> std::size_t
     {
-        return NotNaN {std::round(m_value)};
+        for (std::size_t idx = first; idx < last; ++idx)
+        {
+            if (isNaN(data[idx]))
+            {
+                return idx;
+            }
+        }
+        return last;
     }
 
-    [[nodiscard]]
-    constexpr auto modf(NotNaN<T>* const iptr) const -> NotNaN
+    // The vector kernels work on the bit patterns like isNaN, because floating point compares of a value against
+    // itself are folded away under -ffast-math. With the sign cleared, a lane is NaN when it is above infinity.
+    // Four registers are ORed together so that the loop body has a single, almost never taken, branch. The exact
+    // index is only searched for once a block is known to contain a NaN.
+#if defined(__AVX512F__)
+    inline auto findNaNVector(const float* const data, const std::size_t size) noexcept -> std::size_t
     {
-        T integralPart;
-        T fractionalPart = std::modf(m_value, &integralPart);
-        *iptr            = NotNaN(integralPart);
-        return NotNaN {fractionalPart};
+        constexpr std::size_t LANES     = 16;
+        constexpr std::size_t BLOCK     = 4 * LANES;
+        const __m512i         ABS_MASK  = _mm512_set1_epi32(0x7FFF'FFFF);
+        const __m512i         INFINITY_ = _mm512_set1_epi32(0x7F80'0000);
+        const auto            nanLanes  = [&](const std::size_t offset)
+        {
+            const __m512i bits = _mm512_loadu_si512(data + offset);
+            return _mm512_cmpgt_epi32_mask(_mm512_and_si512(bits, ABS_MASK), INFINITY_);
+        };
+
+        std::size_t idx = 0;
+        for (; idx + BLOCK <= size; idx += BLOCK)
+        {
+            const __mmask16 mask = nanLanes(idx) | nanLanes(idx + LANES) | nanLanes(idx + 2 * LANES)
+                                   | nanLanes(idx + 3 * LANES);
+            if (mask != 0) [[unlikely]]
+            {
+                return findNaNScalar(data, idx, idx + BLOCK);
+            }
+        }
+        return findNaNScalar(data, idx, size);
     }
 
-    // trigonometry
+    inline auto findNaNVector(const double* const data, const std::size_t size) noexcept -> std::size_t
+    {
+        constexpr std::size_t LANES     = 8;
+        constexpr std::size_t BLOCK     = 4 * LANES;
+        const __m512i         ABS_MASK  = _mm512_set1_epi64(0x7FFF'FFFF'FFFF'FFFF);
+        const __m512i         INFINITY_ = _mm512_set1_epi64(0x7FF0'0000'0000'0000);
+        const auto            nanLanes  = [&](const std::size_t offset)
+        {
+            const __m512i bits = _mm512_loadu_si512(data + offset);
+            return _mm512_cmpgt_epi64_mask(_mm512_and_si512(bits, ABS_MASK), INFINITY_);
+        };
 
-    [[nodiscard]]
-    constexpr auto sin() const -> NotNaN
+        std::size_t idx = 0;
+        for (; idx + BLOCK <= size; idx += BLOCK)
+        {
+            const __mmask8 mask = nanLanes(idx) | nanLanes(idx + LANES) | nanLanes(idx + 2 * LANES)
+                                  | nanLanes(idx + 3 * LANES);
+            if (mask != 0) [[unlikely]]
+            {
+                return findNaNScalar(data, idx, idx + BLOCK);
+            }
+        }
+        return findNaNScalar(data, idx, size);
+    }
+#elif defined(__AVX2__)
+    // infinity - |x| is negative exactly for NaN, so the sign bits of the difference are the NaN lanes
+    inline auto findNaNVector(const float* const data, const std::size_t size) noexcept -> std::size_t
     {
-        return NotNaN {std::sin(m_value)};
+        constexpr std::size_t LANES     = 8;
+        constexpr std::size_t BLOCK     = 4 * LANES;
+        const __m256i         ABS_MASK  = _mm256_set1_epi32(0x7FFF'FFFF);
+        const __m256i         INFINITY_ = _mm256_set1_epi32(0x7F80'0000);
+        const auto            nanLanes  = [&](const std::size_t offset)
+        {
+            const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));    // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            return _mm256_sub_epi32(INFINITY_, _mm256_and_si256(bits, ABS_MASK));
+        };
+
+        std::size_t idx = 0;
+        for (; idx + BLOCK <= size; idx += BLOCK)
+        {
+            const __m256i mask = _mm256_or_si256(
+              _mm256_or_si256(nanLanes(idx), nanLanes(idx + LANES)),
+              _mm256_or_si256(nanLanes(idx + 2 * LANES), nanLanes(idx + 3 * LANES))
+            );
+            if (_mm256_movemask_ps(_mm256_castsi256_ps(mask)) != 0) [[unlikely]]
+            {
+                return findNaNScalar(data, idx, idx + BLOCK);
+            }
+        }
+        return findNaNScalar(data, idx, size);
     }
 
-    [[nodiscard]]
-    constexpr auto cos() const -> NotNaN
+    inline auto findNaNVector(const double* const data, const std::size_t size) noexcept -> std::size_t
     {
-        return NotNaN {std::cos(m_value)};
+        constexpr std::size_t LANES     = 4;
+        constexpr std::size_t BLOCK     = 4 * LANES;
+        const __m256i         ABS_MASK  = _mm256_set1_epi64x(0x7FFF'FFFF'FFFF'FFFF);
+        const __m256i         INFINITY_ = _mm256_set1_epi64x(0x7FF0'0000'0000'0000);
+        const auto            nanLanes  = [&](const std::size_t offset)
+        {
+            const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));    // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            return _mm256_sub_epi64(INFINITY_, _mm256_and_si256(bits, ABS_MASK));
+        };
+
+        std::size_t idx = 0;
+        for (; idx + BLOCK <= size; idx += BLOCK)
+        {
+            const __m256i mask = _mm256_or_si256(
+              _mm256_or_si256(nanLanes(idx), nanLanes(idx + LANES)),
+              _mm256_or_si256(nanLanes(idx + 2 * LANES), nanLanes(idx + 3 * LANES))
+            );
+            if (_mm256_movemask_pd(_mm256_castsi256_pd(mask)) != 0) [[unlikely]]
+            {
+                return findNaNScalar(data, idx, idx + BLOCK);
+            }
+        }
+        return findNaNScalar(data, idx, size);
     }
+#elif defined(__SSE2__)
+    // infinity - |x| is negative exactly for NaN, so the sign bits of the difference are the NaN lanes
+    inline auto findNaNVector(const float* const data, const std::size_t size) noexcept -> std::size_t
+    {
+        constexpr std::size_t LANES     = 4;
+        constexpr std::size_t BLOCK     = 4 * LANES;
+        const __m128i         ABS_MASK  = _mm_set1_epi32(0x7FFF'FFFF);
+        const __m128i         INFINITY_ = _mm_set1_epi32(0x7F80'0000);
+        const auto            nanLanes  = [&](const std::size_t offset)
+        {
+            const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));    // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            return _mm_sub_epi32(INFINITY_, _mm_and_si128(bits, ABS_MASK));
+        };
 
-    [[nodiscard]]
-    constexpr auto tan() const -> NotNaN
+        std::size_t idx = 0;
+        for (; idx + BLOCK <= size; idx += BLOCK)
+        {
+            const __m128i mask = _mm_or_si128(
+              _mm_or_si128(nanLanes(idx), nanLanes(idx + LANES)), _mm_or_si128(nanLanes(idx + 2 * LANES), nanLanes(idx + 3 * LANES))
+            );
+            if (_mm_movemask_ps(_mm_castsi128_ps(mask)) != 0) [[unlikely]]
+            {
+                return findNaNScalar(data, idx, idx + BLOCK);
+            }
+        }
+        return findNaNScalar(data, idx, size);
+    }
+
+    inline auto findNaNVector(const double* const data, const std::size_t size) noexcept -> std::size_t
     {
-        return NotNaN {std::tan(m_value)};
+        constexpr std::size_t LANES     = 2;
+        constexpr std::size_t BLOCK     = 4 * LANES;
+        const __m128i         ABS_MASK  = _mm_set1_epi64x(0x7FFF'FFFF'FFFF'FFFF);
+        const __m128i         INFINITY_ = _mm_set1_epi64x(0x7FF0'0000'0000'0000);
+        const auto            nanLanes  = [&](const std::size_t offset)
+        {
+            const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));    // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            return _mm_sub_epi64(INFINITY_, _mm_and_si128(bits, ABS_MASK));
+        };
+
+        std::size_t idx = 0;
+        for (; idx + BLOCK <= size; idx += BLOCK)
+        {
+            const __m128i mask = _mm_or_si128(
+              _mm_or_si128(nanLanes(idx), nanLanes(idx + LANES)), _mm_or_si128(nanLanes(idx + 2 * LANES), nanLanes(idx + 3 * LANES))
+            );
+            if (_mm_movemask_pd(_mm_castsi128_pd(mask)) != 0) [[unlikely]]
+            {
+                return findNaNScalar(data, idx, idx + BLOCK);
+            }
+        }
+        return findNaNScalar(data, idx, size);
     }
+#endif
 
-    [[nodiscard]]
-    constexpr auto asin() const -> NotNaN
+    // The 16 bit formats differ in the width of their exponent, so their kernel compares against the bits of the
+    // infinity of each format. With the sign cleared every lane is a positive 16 bit integer.
+#if defined(__AVX512BW__)
+    template <IsHalfPrecision T>
+    auto findNaNVector(const T* const data, const std::size_t size) noexcept -> std::size_t
     {
-        return NotNaN {std::asin(m_value)};
+        constexpr std::size_t LANES     = 32;
+        constexpr std::size_t BLOCK     = 4 * LANES;
+        const __m512i         ABS_MASK  = _mm512_set1_epi16(0x7FFF);
+        const __m512i         INFINITY_ = _mm512_set1_epi16(std::bit_cast<std::int16_t>(std::numeric_limits<T>::infinity()));
+        const auto            nanLanes  = [&](const std::size_t offset)
+        {
+            const __m512i bits = _mm512_loadu_si512(data + offset);
+            return _mm512_cmpgt_epi16_mask(_mm512_and_si512(bits, ABS_MASK), INFINITY_);
+        };
+
+        std::size_t idx = 0;
+        for (; idx + BLOCK <= size; idx += BLOCK)
+        {
+            const __mmask32 mask = nanLanes(idx) | nanLanes(idx + LANES) | nanLanes(idx + 2 * LANES)
+                                   | nanLanes(idx + 3 * LANES);
+            if (mask != 0) [[unlikely]]
+            {
+                return findNaNScalar(data, idx, idx + BLOCK);
+            }
+        }
+        return findNaNScalar(data, idx, size);
     }
+#elif defined(__AVX2__)
+    template <IsHalfPrecision T>
+    auto findNaNVector(const T* const data, const std::size_t size) noexcept -> std::size_t
+    {
+        constexpr std::size_t LANES     = 16;
+        constexpr std::size_t BLOCK     = 4 * LANES;
+        const __m256i         ABS_MASK  = _mm256_set1_epi16(0x7FFF);
+        const __m256i         INFINITY_ = _mm256_set1_epi16(std::bit_cast<std::int16_t>(std::numeric_limits<T>::infinity()));
+        const auto            nanLanes  = [&](const std::size_t offset)
+        {
+            const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));    // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            return _mm256_cmpgt_epi16(_mm256_and_si256(bits, ABS_MASK), INFINITY_);
+        };
 
-    [[nodiscard]]
-    constexpr auto acos() const -> NotNaN
+        std::size_t idx = 0;
+        for (; idx + BLOCK <= size; idx += BLOCK)
+        {
+            const __m256i mask = _mm256_or_si256(
+              _mm256_or_si256(nanLanes(idx), nanLanes(idx + LANES)),
+              _mm256_or_si256(nanLanes(idx + 2 * LANES), nanLanes(idx + 3 * LANES))
+            );
+            if (_mm256_movemask_epi8(mask) != 0) [[unlikely]]
+            {
+                return findNaNScalar(data, idx, idx + BLOCK);
+            }
+        }
+        return findNaNScalar(data, idx, size);
+    }
+#elif defined(__SSE2__)
+    template <IsHalfPrecision T>
+    auto findNaNVector(const T* const data, const std::size_t size) noexcept -> std::size_t
     {
-        return NotNaN {std::acos(m_value)};
+        constexpr std::size_t LANES     = 8;
+        constexpr std::size_t BLOCK     = 4 * LANES;
+        const __m128i         ABS_MASK  = _mm_set1_epi16(0x7FFF);
+        const __m128i         INFINITY_ = _mm_set1_epi16(std::bit_cast<std::int16_t>(std::numeric_limits<T>::infinity()));
+        const auto            nanLanes  = [&](const std::size_t offset)
+        {
+            const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));    // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            return _mm_cmpgt_epi16(_mm_and_si128(bits, ABS_MASK), INFINITY_);
+        };
+
+        std::size_t idx = 0;
+        for (; idx + BLOCK <= size; idx += BLOCK)
+        {
+            const __m128i mask = _mm_or_si128(
+              _mm_or_si128(nanLanes(idx), nanLanes(idx + LANES)), _mm_or_si128(nanLanes(idx + 2 * LANES), nanLanes(idx + 3 * LANES))
+            );
+            if (_mm_movemask_epi8(mask) != 0) [[unlikely]]
+            {
+                return findNaNScalar(data, idx, idx + BLOCK);
+            }
+        }
+        return findNaNScalar(data, idx, size);
     }
+#endif
 
-    [[nodiscard]]
-    constexpr auto atan() const -> NotNaN
+    // float to a 16 bit format, rounded to nearest like static_cast, NaN stays NaN. std::float16_t uses the
+    // conversion instructions of F16C or AVX-512F. VCVTNEPS2BF16 of AVX-512 BF16 flushes denormals to zero, so
+    // std::bfloat16_t takes the plain loop, which compilers vectorize.
+    template <IsHalfPrecision T>
+    void narrowFloats(const float* const in, T* const out, const std::size_t size) noexcept
     {
-        return NotNaN {std::atan(m_value)};
+        std::size_t idx = 0;
+        if constexpr (std::numeric_limits<T>::digits == 11)
+        {
+#if defined(__AVX512F__)
+            for (; idx + 16 <= size; idx += 16)
+            {
+                const __m256i half = _mm512_cvtps_ph(_mm512_loadu_ps(in + idx), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + idx), half);    // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            }
+#elif defined(__F16C__)
+            for (; idx + 8 <= size; idx += 8)
+            {
+                const __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(in + idx), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + idx), half);    // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            }
+#endif
+        }
+        for (; idx < size; ++idx)
+        {
+            out[idx] = static_cast<T>(in[idx]);
+        }
     }
 
-    [[nodiscard]]
-    constexpr auto atan2(const auto& y) const
-        requires std::is_arithmetic_v<std::remove_cvref_t<decltype(y)>>
+    // A 16 bit format to float, which is exact
+    template <IsHalfPrecision T>
+    void widenToFloats(const T* const in, float* const out, const std::size_t size) noexcept
     {
-        using CT = std::common_type_t<T, std::remove_cvref_t<decltype(y)>>;
-        if (std::isnan(y))
+        std::size_t idx = 0;
+        if constexpr (std::numeric_limits<T>::digits == 11)
+        {
+#if defined(__AVX512F__)
+            for (; idx + 16 <= size; idx += 16)
+            {
+                const __m256i half = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + idx));    // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                _mm512_storeu_ps(out + idx, _mm512_cvtph_ps(half));
+            }
+#elif defined(__F16C__)
+            for (; idx + 8 <= size; idx += 8)
+            {
+                const __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + idx));    // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                _mm256_storeu_ps(out + idx, _mm256_cvtph_ps(half));
+            }
+#endif
+        }
+        for (; idx < size; ++idx)
         {
-            throw std::invalid_argument(std::format("y is {}", y));
+            out[idx] = static_cast<float>(in[idx]);
         }
-        return NotNaN<CT> {std::atan2(static_cast<CT>(m_value), static_cast<CT>(y))};
     }
 
-    template <typename F>
-    [[nodiscard]]
-    constexpr auto atan2(const NotNaN<F>& y) const
+    template <typename T>
+    concept HasVectorKernel = requires (const T* data, std::size_t size) {
+        { findNaNVector(data, size) } -> std::same_as<std::size_t>;
+    };
+
+    template <std::floating_point T>
+    [[noreturn, gnu::cold, gnu::noinline]]
+    void throwInvalidElement(const T value, const std::size_t idx)
     {
-        using CT = std::common_type_t<T, F>;
-        return NotNaN<CT> {std::atan2(static_cast<CT>(m_value), static_cast<CT>(y))};
+        throw std::invalid_argument(
+          std::format("Can not construct with {} at index {}", static_cast<FormatType<T>>(value), idx)
+        );
     }
 
-    [[nodiscard]]
-    constexpr auto hypot(const auto& y) const
-        requires std::is_arithmetic_v<std::remove_cvref_t<decltype(y)>>
+    [[noreturn, gnu::cold, gnu::noinline]]
+    inline void throwSizeMismatch(const std::size_t lhs, const std::size_t rhs)
+    {
+        throw std::invalid_argument(std::format("Size mismatch: {} and {}", lhs, rhs));
+    }
+
+    inline void checkSizes(const std::size_t lhs, const std::size_t rhs)
     {
-        using CT = std::common_type_t<T, std::remove_cvref_t<decltype(y)>>;
-        if (std::isnan(y))
+        if (lhs != rhs) [[unlikely]]
         {
-            throw std::invalid_argument(std::format("y is {}", y));
+            throwSizeMismatch(lhs, rhs);
         }
-        return NotNaN<CT> {std::hypot(static_cast<CT>(m_value), static_cast<CT>(y))};
     }
 
-    template <typename F>
-    [[nodiscard]]
-    constexpr auto hypot(const NotNaN<F>& y) const
+    // Reports the NaN a bulk conversion found at idx through Policy, the default policy names the index
+    template <typename R, CheckPolicy Policy, std::floating_point T>
+    [[gnu::cold, gnu::noinline]]
+    auto invalidElement(const T value, const std::size_t idx) -> typename Policy::template Result<R>
     {
-        using CT = std::common_type_t<T, F>;
-        return NotNaN<CT> {std::hypot(static_cast<CT>(m_value), static_cast<CT>(y))};
+        if constexpr (std::same_as<Policy, ThrowPolicy>)
+        {
+            throwInvalidElement(value, idx);
+        }
+        else
+        {
+            return Policy::template failure<R>({Operation::Construct, Operand::Value});
+        }
     }
 
-    // error function and complementary error function
-    [[nodiscard]]
-    constexpr auto erf() const -> NotNaN
+    // Like invalidElement, where there is no result to carry the error (constructors, element access)
+    template <CheckPolicy Policy, std::floating_point T>
+    [[gnu::cold, gnu::noinline]]
+    void raiseInvalidElement(const T value, const std::size_t idx)
     {
-        return NotNaN(std::erf(m_value));
+        if constexpr (std::same_as<Policy, ThrowPolicy>)
+        {
+            throwInvalidElement(value, idx);
+        }
+        else
+        {
+            Policy::raise({Operation::Construct, Operand::Value});
+        }
     }
+
+    // NotNaN<T> is a plain T with an invariant, so arrays of one are viewed as arrays of the other in place.
+    // rawData and notNaNData are the only places that rely on it.
+    template <std::floating_point T, CheckPolicy Policy>
+    inline constexpr bool HAS_RAW_LAYOUT = sizeof(NotNaN<T, Policy>) == sizeof(T)
+                                           && alignof(NotNaN<T, Policy>) == alignof(T)
+                                           && std::is_standard_layout_v<NotNaN<T, Policy>>
+                                           && std::is_trivially_copyable_v<NotNaN<T, Policy>>;
+
+    // The raw values of NotNaN, for kernels on T
+    template <std::floating_point T, CheckPolicy Policy>
     [[nodiscard]]
-    constexpr auto erfc() const -> NotNaN
+    auto rawData(const std::span<NotNaN<T, Policy>> values) noexcept -> T*
     {
-        return NotNaN {std::erfc(m_value)};
+        static_assert(HAS_RAW_LAYOUT<T, Policy>);
+        return reinterpret_cast<T*>(values.data());    // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
     }
 
-    // gamma
+    template <std::floating_point T, CheckPolicy Policy>
     [[nodiscard]]
-    constexpr auto tgamma() const -> NotNaN
+    auto rawData(const std::span<const NotNaN<T, Policy>> values) noexcept -> const T*
     {
-        return NotNaN {std::tgamma(m_value)};
+        static_assert(HAS_RAW_LAYOUT<T, Policy>);
+        return reinterpret_cast<const T*>(values.data());    // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
     }
+
+    // Raw values viewed as NotNaN<T, Policy>, the caller has made sure that none of them is NaN
+    template <CheckPolicy Policy, typename T>
+        requires std::floating_point<std::remove_const_t<T>>
     [[nodiscard]]
-    constexpr auto lgamma() const -> NotNaN
+    auto notNaNData(const std::span<T> values) noexcept
     {
-        return NotNaN {std::lgamma(m_value)};
+        using F = std::remove_const_t<T>;
+        using N = std::conditional_t<std::is_const_v<T>, const NotNaN<F, Policy>, NotNaN<F, Policy>>;
+
+        static_assert(HAS_RAW_LAYOUT<F, Policy>);
+        return reinterpret_cast<N*>(values.data());    // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
     }
+}    // namespace detail
 
-    // midpoint
-    [[nodiscard]]
-    constexpr auto midpoint(const auto& rhs) const
-        requires std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
+// Returns the index of the first NaN in values, or values.size() if there is none.
+template <std::floating_point T>
+[[nodiscard]]
+constexpr auto findNaN(const std::span<const T> values) noexcept -> std::size_t
+{
+    if !consteval
     {
-        using CT = std::common_type_t<T, std::remove_cvref_t<decltype(rhs)>>;
-        if (std::isnan(rhs))
+        if constexpr (detail::HasVectorKernel<T>)
         {
-            throw std::invalid_argument(std::format("rhs is {}", rhs));
+            return detail::findNaNVector(values.data(), values.size());
         }
-        return NotNaN<CT> {std::midpoint(static_cast<CT>(m_value), static_cast<CT>(rhs))};
     }
+    return detail::findNaNScalar(values.data(), 0, values.size());
+}
 
-    template <typename F>
-    [[nodiscard]]
-    constexpr auto midpoint(const NotNaN<F>& rhs) const
-    {
-        using CT = std::common_type_t<T, F>;
-        return NotNaN<CT> {std::midpoint(static_cast<CT>(m_value), static_cast<CT>(rhs))};
-    }
+// Validates a whole buffer in one pass and views it as NotNaN without copying.
+// Throws std::invalid_argument naming the first offending index.
+template <typename T>
+    requires std::floating_point<std::remove_const_t<T>>
+[[nodiscard]]
+auto validate(const std::span<T> values)
+{
+    using F = std::remove_const_t<T>;
 
-    // Stream operators
-    friend auto operator<< (std::ostream& ostream, const NotNaN& value) -> std::ostream&
+    const std::size_t idx = findNaN(std::span<const F> {values});
+    if (idx != values.size()) [[unlikely]]
     {
-        ostream << *value;
-        return ostream;
+        detail::throwInvalidElement(values[idx], idx);
     }
-    friend auto operator>> (std::istream& istream, NotNaN value) -> std::istream&
+    return std::span {detail::notNaNData<ThrowPolicy>(values), values.size()};
+}
+
+// Converts floats to a 16 bit format in values, rounding to nearest like static_cast, with F16C where the target has
+// it. Values beyond the range of the format become infinity, so only a NaN float gives NaN: the floats are checked with
+// one findNaN scan before anything is written. Returns values through Policy's Result.
+// A NaN is reported through Policy and leaves values untouched, the default policy throws std::invalid_argument naming
+// its index. Throws std::invalid_argument if the sizes do not match.
+template <std::floating_point T, CheckPolicy Policy>
+    requires detail::IsHalfPrecision<T>
+auto fromFloats(const std::span<const float> floats, const std::span<NotNaN<T, Policy>> values)
+  -> typename Policy::template Result<std::span<NotNaN<T, Policy>>>
+{
+    using R = std::span<NotNaN<T, Policy>>;
+    detail::checkSizes(floats.size(), values.size());
+
+    if constexpr (Policy::CHECKED)
     {
-        T val;
-        istream >> val;
-        value = val;    // copy assignment checks for NaN
-        return istream;
+        const std::size_t idx = findNaN(floats);
+        if (idx != floats.size()) [[unlikely]]
+        {
+            return detail::invalidElement<R, Policy>(floats[idx], idx);
+        }
     }
-};
 
-// Formatter
-template <std::floating_point T>
-struct std::formatter<NotNaN<T>> : std::formatter<T>
+    detail::narrowFloats(floats.data(), detail::rawData(values), values.size());
+    return Policy::template success<R>(values);
+}
+
+// Converts values of a 16 bit format to float, which is exact and can't give NaN.
+// Throws std::invalid_argument if the sizes do not match.
+template <std::floating_point T, CheckPolicy Policy>
+    requires detail::IsHalfPrecision<T>
+void toFloats(const std::span<const NotNaN<T, Policy>> values, const std::span<NotNaN<float, Policy>> floats)
 {
-    template <class FormatContext>
-    auto format(const NotNaN<T>& t, FormatContext& ctx) const
+    detail::checkSizes(values.size(), floats.size());
+    detail::widenToFloats(detail::rawData(values), detail::rawData(floats), values.size());
+}
+
+// Writes toOrderedBytes of every value into bytes, which must hold ORDERED_SIZE bytes per value.
+// Throws std::invalid_argument if it does not.
+template <std::floating_point T, CheckPolicy Policy>
+    requires detail::HasOrderedBytes<T>
+void toOrderedBytes(const std::span<const NotNaN<T, Policy>> values, const std::span<std::byte> bytes)
+{
+    constexpr std::size_t SIZE = detail::ORDERED_SIZE<T>;
+    detail::checkSizes(values.size() * SIZE, bytes.size());
+    for (std::size_t idx = 0; idx < values.size(); ++idx)
+    {
+        detail::encodeOrdered(*values[idx], bytes.data() + (idx * SIZE));
+    }
+}
+
+// Decodes bytes written by toOrderedBytes into values, checking each value before it is written. Returns values
+// through Policy's Result.
+// A NaN is reported through Policy, the values before it are decoded and the ones from it on are left untouched.
+// The default policy throws std::invalid_argument naming its index. Throws std::invalid_argument if the sizes do not
+// match.
+template <std::floating_point T, CheckPolicy Policy>
+    requires detail::HasOrderedBytes<T>
+auto fromOrderedBytes(const std::span<const std::byte> bytes, const std::span<NotNaN<T, Policy>> values)
+  -> typename Policy::template Result<std::span<NotNaN<T, Policy>>>
+{
+    using R                    = std::span<NotNaN<T, Policy>>;
+    constexpr std::size_t SIZE = detail::ORDERED_SIZE<T>;
+    detail::checkSizes(bytes.size(), values.size() * SIZE);
+
+    for (std::size_t idx = 0; idx < values.size(); ++idx)
     {
-        return std::formatter<T>::format(*t, ctx);
+        const T value = detail::decodeOrdered<T>(bytes.data() + (idx * SIZE));
+        if (Policy::CHECKED && isNaN(value)) [[unlikely]]
+        {
+            return detail::invalidElement<R, Policy>(value, idx);
+        }
+        values[idx] = detail::UncheckedAccess::make<NotNaN<T, Policy>>(value);
     }
-};
+    return Policy::template success<R>(values);
+}
+}    // namespace notnan
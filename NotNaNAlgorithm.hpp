@@ -0,0 +1,710 @@
+#pragma once
+
+#include "NotNaN.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <execution>
+#include <format>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Reductions over contiguous ranges of NotNaN values.
+// They accumulate raw T in independent lanes the compiler vectorizes and check the result once at the end.
+// NaN is sticky under + and *, so a NaN partial sum always shows up in the final result.
+// The overloads taking an execution policy split the range into blocks reduced in parallel. Nothing inside a
+// parallel section can fail, the final check runs on the calling thread, so errors never reach std::terminate.
+//
+//   const NotNaN<double> sum = notnan::reduce(std::execution::par_unseq, values);
+//
+// notnan::transform and notnan::forEach run functions that may fail, e.g. NotNaN arithmetic under ThrowPolicy.
+// An exception escaping an element function of a standard parallel algorithm calls std::terminate, so they catch
+// it per element, skip the elements after it and throw a single ElementError for the lowest failing index on the
+// calling thread afterwards.
+namespace notnan
+{
+// A contiguous range of NotNaN, e.g. NotNaNVector, std::vector<NotNaN<T>> or std::span<const NotNaN<T>>.
+// Not std::ranges::contiguous_range, NotNaNVector::data() hands out the raw values.
+template <typename R>
+concept NotNaNRange = std::contiguous_iterator<std::ranges::iterator_t<R>> && std::ranges::sized_range<R>
+                      && IsNotNaN<std::remove_cvref_t<std::ranges::range_value_t<R>>>;
+
+template <NotNaNRange R>
+using RangeElement = std::remove_cvref_t<std::ranges::range_value_t<R>>;
+
+namespace detail
+{
+    template <typename E>
+    concept ExecutionPolicy = std::is_execution_policy_v<std::remove_cvref_t<E>>;
+
+    // elements per parallel task, large enough that the task overhead does not matter
+    constexpr std::size_t REDUCE_BLOCK = std::size_t {1} << 16;
+
+    // accumulators in flight, one cache line of T
+    template <typename T>
+    constexpr std::size_t LANES = 64 / sizeof(T);
+
+    // sum of element(i) for i in [first, last) in independent lanes
+    template <typename T, typename Element>
+    [[nodiscard]]
+    auto sumLanes(const std::size_t first, const std::size_t last, const Element& element) noexcept -> T
+    {
+        std::array<T, LANES<T>> lanes {};
+        std::size_t             idx = first;
+        for (; idx + LANES<T> <= last; idx += LANES<T>)
+        {
+            for (std::size_t lane = 0; lane < LANES<T>; ++lane)
+            {
+                lanes[lane] += element(idx + lane);
+            }
+        }
+        for (std::size_t lane = 0; idx < last; ++idx, ++lane)
+        {
+            lanes[lane] += element(idx);
+        }
+        return std::reduce(lanes.begin(), lanes.end());
+    }
+
+    template <typename R>
+    [[nodiscard]]
+    auto elements(const R& values) noexcept
+    {
+        return std::to_address(std::ranges::begin(values));
+    }
+
+    // The range [0, size) cut into blocks. block(first, last) reduces one of them, combine the block results.
+    // policy is passed on as an lvalue, libstdc++ 12 rejects rvalue policies in its parallel algorithms.
+    template <typename V, typename Combine, typename Block>
+    [[nodiscard]]
+    auto reduceBlocks(
+      ExecutionPolicy auto&& policy, const std::size_t size, const V init, const Combine& combine, const Block& block
+    ) -> V
+    {
+        std::vector<std::size_t> blocks((size + REDUCE_BLOCK - 1) / REDUCE_BLOCK);
+        for (std::size_t idx = 0; idx < blocks.size(); ++idx)
+        {
+            blocks[idx] = idx * REDUCE_BLOCK;
+        }
+        return std::transform_reduce(
+          policy, blocks.begin(), blocks.end(), init, combine,
+          [size, &block](const std::size_t first) noexcept { return block(first, std::min(first + REDUCE_BLOCK, size)); }
+        );
+    }
+
+    template <typename T, typename Element>
+    [[nodiscard]]
+    auto sumBlocks(ExecutionPolicy auto&& policy, const std::size_t size, const Element& element) -> T
+    {
+        return reduceBlocks(
+          policy, size, T {}, std::plus {},
+          [&element](const std::size_t first, const std::size_t last) noexcept
+          { return sumLanes<T>(first, last, element); }
+        );
+    }
+
+    // Index of the first element no other one is before in order, for a range that is not empty.
+    // The pick between two indices is associative and commutative, so blocks may be combined in any order.
+    template <typename R, typename Order>
+    [[nodiscard]]
+    auto extremeIndex(ExecutionPolicy auto&& policy, const R& values, const Order& order) -> std::size_t
+    {
+        const auto first = elements(values);
+        const auto pick  = [first, &order](const std::size_t lhs, const std::size_t rhs) noexcept
+        {
+            if (order(*first[rhs], *first[lhs]))
+            {
+                return rhs;
+            }
+            if (order(*first[lhs], *first[rhs]))
+            {
+                return lhs;
+            }
+            return std::min(lhs, rhs);
+        };
+        return reduceBlocks(
+          policy, std::ranges::size(values), std::size_t {0}, pick,
+          [&pick](const std::size_t begin, const std::size_t end) noexcept
+          {
+              std::size_t result = begin;
+              for (std::size_t idx = begin + 1; idx < end; ++idx)
+              {
+                  result = pick(result, idx);
+              }
+              return result;
+          }
+        );
+    }
+
+    // The final check of a reduction, on the calling thread.
+    // Deferred policies are checked as well, the flags of worker threads are not seen by a NaNGuardScope.
+    template <typename N>
+    [[nodiscard]]
+    auto reduceResult(const typename N::Type value) -> typename N::PolicyType::template Result<N>
+    {
+        using Policy = typename N::PolicyType;
+        if constexpr (Policy::CHECKED)
+        {
+            if (isNaN(value)) [[unlikely]]
+            {
+                return Policy::template failure<N>({Operation::Reduce, Operand::Result});
+            }
+        }
+        return Policy::template success<N>(UncheckedAccess::make<N>(value));
+    }
+}    // namespace detail
+
+// Sum of all values, 0 for an empty range
+template <NotNaNRange R>
+[[nodiscard]]
+auto reduce(const R& values)
+{
+    using N          = RangeElement<R>;
+    const auto first = detail::elements(values);
+    return detail::reduceResult<N>(detail::sumLanes<typename N::Type>(
+      0, std::ranges::size(values), [first](const std::size_t idx) noexcept { return *first[idx]; }
+    ));
+}
+
+template <NotNaNRange R>
+[[nodiscard]]
+auto reduce(detail::ExecutionPolicy auto&& policy, const R& values)
+{
+    using N          = RangeElement<R>;
+    const auto first = detail::elements(values);
+    return detail::reduceResult<N>(detail::sumBlocks<typename N::Type>(
+      policy, std::ranges::size(values), [first](const std::size_t idx) noexcept { return *first[idx]; }
+    ));
+}
+
+// Sum of lhs[i] * rhs[i], throws std::invalid_argument if the sizes differ
+template <NotNaNRange L, NotNaNRange R>
+    requires std::same_as<RangeElement<L>, RangeElement<R>>
+[[nodiscard]]
+auto dot(const L& lhs, const R& rhs)
+{
+    using N = RangeElement<L>;
+    detail::checkSizes(std::ranges::size(lhs), std::ranges::size(rhs));
+    const auto lhsFirst = detail::elements(lhs);
+    const auto rhsFirst = detail::elements(rhs);
+    return detail::reduceResult<N>(detail::sumLanes<typename N::Type>(
+      0, std::ranges::size(lhs),
+      [lhsFirst, rhsFirst](const std::size_t idx) noexcept { return *lhsFirst[idx] * *rhsFirst[idx]; }
+    ));
+}
+
+template <NotNaNRange L, NotNaNRange R>
+    requires std::same_as<RangeElement<L>, RangeElement<R>>
+[[nodiscard]]
+auto dot(detail::ExecutionPolicy auto&& policy, const L& lhs, const R& rhs)
+{
+    using N = RangeElement<L>;
+    detail::checkSizes(std::ranges::size(lhs), std::ranges::size(rhs));
+    const auto lhsFirst = detail::elements(lhs);
+    const auto rhsFirst = detail::elements(rhs);
+    return detail::reduceResult<N>(detail::sumBlocks<typename N::Type>(
+      policy, std::ranges::size(lhs),
+      [lhsFirst, rhsFirst](const std::size_t idx) noexcept { return *lhsFirst[idx] * *rhsFirst[idx]; }
+    ));
+}
+
+// Euclidean norm. Squares are never NaN and neither is their sum, so there is nothing to check, the result is
+// returned through the policy's Result like those of reduce and dot.
+// There is no scaling, the result overflows to infinity like the sum of squares does.
+template <NotNaNRange R>
+[[nodiscard]]
+auto norm2(const R& values)
+{
+    using N          = RangeElement<R>;
+    const auto first = detail::elements(values);
+    const auto sum   = detail::sumLanes<typename N::Type>(
+      0, std::ranges::size(values), [first](const std::size_t idx) noexcept { return *first[idx] * *first[idx]; }
+    );
+    return N::PolicyType::template success<N>(detail::UncheckedAccess::make<N>(std::sqrt(sum)));
+}
+
+template <NotNaNRange R>
+[[nodiscard]]
+auto norm2(detail::ExecutionPolicy auto&& policy, const R& values)
+{
+    using N          = RangeElement<R>;
+    const auto first = detail::elements(values);
+    const auto sum   = detail::sumBlocks<typename N::Type>(
+      policy, std::ranges::size(values), [first](const std::size_t idx) noexcept { return *first[idx] * *first[idx]; }
+    );
+    return N::PolicyType::template success<N>(detail::UncheckedAccess::make<N>(std::sqrt(sum)));
+}
+
+// Smallest and largest value, end of the range if it is empty.
+// NotNaN values are totally ordered, so the raw values are compared without any checks.
+template <NotNaNRange R>
+[[nodiscard]]
+auto minElement(R&& values)
+{
+    return std::ranges::min_element(values, std::less {}, [](const auto& value) noexcept { return *value; });
+}
+
+template <NotNaNRange R>
+[[nodiscard]]
+auto minElement(detail::ExecutionPolicy auto&& policy, R&& values) -> std::ranges::iterator_t<R>
+{
+    if (std::ranges::empty(values))
+    {
+        return std::ranges::end(values);
+    }
+    return std::ranges::begin(values) + detail::extremeIndex(policy, values, std::less {});
+}
+
+template <NotNaNRange R>
+[[nodiscard]]
+auto maxElement(R&& values)
+{
+    return std::ranges::max_element(values, std::less {}, [](const auto& value) noexcept { return *value; });
+}
+
+template <NotNaNRange R>
+[[nodiscard]]
+auto maxElement(detail::ExecutionPolicy auto&& policy, R&& values) -> std::ranges::iterator_t<R>
+{
+    if (std::ranges::empty(values))
+    {
+        return std::ranges::end(values);
+    }
+    return std::ranges::begin(values) + detail::extremeIndex(policy, values, std::greater {});
+}
+
+// The element function of notnan::transform or notnan::forEach threw for the element at index(), the lowest index it
+// threw for under any execution policy
+class ElementError : public std::runtime_error
+{
+  private:
+    std::size_t        m_index;
+    std::exception_ptr m_cause;
+
+    [[nodiscard]]
+    static auto describe(const std::exception_ptr& cause) -> std::string
+    {
+        try
+        {
+            std::rethrow_exception(cause);
+        }
+        catch (const std::exception& error)
+        {
+            return error.what();
+        }
+        catch (...)
+        {
+            return "Unknown exception";
+        }
+    }
+
+  public:
+    ElementError(const std::size_t index, std::exception_ptr cause)
+        : std::runtime_error {std::format("{} at index {}", describe(cause), index)}, m_index {index},
+          m_cause {std::move(cause)}
+    {
+        // empty
+    }
+
+    [[nodiscard]]
+    auto index() const noexcept -> std::size_t
+    {
+        return m_index;
+    }
+
+    // The exception the element function threw, for std::rethrow_exception
+    [[nodiscard]]
+    auto cause() const noexcept -> const std::exception_ptr&
+    {
+        return m_cause;
+    }
+};
+
+namespace detail
+{
+    // elements per task of transform and forEach, the element functions may be expensive
+    constexpr std::size_t TASK_BLOCK = 1024;
+
+    // The failure with the lowest index of a parallel algorithm.
+    // Workers skip the elements after the lowest failure recorded so far, the ones before it still run, so the failure
+    // left at the end is the lowest one. The index is lowered with compare and exchange and each block stops at its
+    // first failure, so its cause has a place of its own that only that block writes. Nothing takes a lock.
+    // The causes are only read after the algorithm returned, which orders them after the writes.
+    class FailureSlot
+    {
+      private:
+        static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+        std::atomic<std::size_t>        m_first {NONE};
+        std::vector<std::exception_ptr> m_causes;
+
+      public:
+        explicit FailureSlot(const std::size_t blocks) : m_causes(blocks)
+        {
+            // empty
+        }
+
+        [[nodiscard]]
+        auto skips(const std::size_t index) const noexcept -> bool
+        {
+            return index > m_first.load(std::memory_order_relaxed);
+        }
+
+        void record(const std::size_t index, std::exception_ptr cause) noexcept
+        {
+            m_causes[index / TASK_BLOCK] = std::move(cause);
+            std::size_t first            = m_first.load(std::memory_order_relaxed);
+            while (index < first && !m_first.compare_exchange_weak(first, index, std::memory_order_relaxed))
+            {
+                // first was reloaded, try again while index is still lower
+            }
+        }
+
+        void rethrow() const
+        {
+            const std::size_t first = m_first.load(std::memory_order_relaxed);
+            if (first != NONE) [[unlikely]]
+            {
+                throw ElementError {first, m_causes[first / TASK_BLOCK]};
+            }
+        }
+    };
+
+    // The blocks synchronize through the slot, which unsequenced policies do not allow
+    template <typename E>
+    [[nodiscard]]
+    auto synchronizingPolicy(const E& policy) noexcept
+    {
+        if constexpr (std::same_as<E, std::execution::parallel_unsequenced_policy>)
+        {
+            return std::execution::par;
+        }
+        else if constexpr (std::same_as<E, std::execution::unsequenced_policy>)
+        {
+            return std::execution::seq;
+        }
+        else
+        {
+            return policy;
+        }
+    }
+
+    // body(i) for all i in [0, size) under policy, throws ElementError for the lowest i body(i) threw for.
+    // The i after it may or may not have run.
+    template <typename Body>
+    void forEachIndex(const ExecutionPolicy auto& policy, const std::size_t size, const Body& body)
+    {
+        std::vector<std::size_t> blocks((size + TASK_BLOCK - 1) / TASK_BLOCK);
+        for (std::size_t idx = 0; idx < blocks.size(); ++idx)
+        {
+            blocks[idx] = idx * TASK_BLOCK;
+        }
+
+        const auto  blockPolicy = synchronizingPolicy(policy);
+        FailureSlot slot {blocks.size()};
+        std::for_each(
+          blockPolicy, blocks.begin(), blocks.end(),
+          [size, &body, &slot](const std::size_t first) noexcept
+          {
+              const std::size_t last = std::min(first + TASK_BLOCK, size);
+              std::size_t       idx  = first;
+              try
+              {
+                  for (; idx < last && !slot.skips(idx); ++idx)
+                  {
+                      body(idx);
+                  }
+              }
+              catch (...)
+              {
+                  slot.record(idx, std::current_exception());
+              }
+          }
+        );
+        slot.rethrow();
+    }
+}    // namespace detail
+
+// output[i] = function(input[i]) for every element, returns the end of the output.
+// Elements after a failure may or may not have been written.
+template <std::ranges::random_access_range R, std::random_access_iterator O, typename Function>
+    requires std::ranges::sized_range<R>
+             && std::indirectly_writable<O, std::invoke_result_t<Function&, std::ranges::range_reference_t<R>>>
+auto transform(detail::ExecutionPolicy auto&& policy, R&& input, O output, Function function) -> O
+{
+    const auto first = std::ranges::begin(input);
+    const auto size  = std::ranges::size(input);
+    detail::forEachIndex(
+      policy, size,
+      [&first, &output, &function](const std::size_t idx)
+      {
+          const auto offset = static_cast<std::iter_difference_t<O>>(idx);
+          output[offset]    = std::invoke(function, first[static_cast<std::ranges::range_difference_t<R>>(idx)]);
+      }
+    );
+    return output + static_cast<std::iter_difference_t<O>>(size);
+}
+
+template <std::ranges::random_access_range R, std::random_access_iterator O, typename Function>
+    requires std::ranges::sized_range<R>
+             && std::indirectly_writable<O, std::invoke_result_t<Function&, std::ranges::range_reference_t<R>>>
+auto transform(R&& input, O output, Function function) -> O
+{
+    return notnan::transform(std::execution::seq, input, output, std::move(function));
+}
+
+// function(element) for every element
+template <std::ranges::random_access_range R, typename Function>
+    requires std::ranges::sized_range<R> && std::invocable<Function&, std::ranges::range_reference_t<R>>
+void forEach(detail::ExecutionPolicy auto&& policy, R&& range, Function function)
+{
+    const auto first = std::ranges::begin(range);
+    detail::forEachIndex(
+      policy, std::ranges::size(range),
+      [&first, &function](const std::size_t idx)
+      { std::invoke(function, first[static_cast<std::ranges::range_difference_t<R>>(idx)]); }
+    );
+}
+
+template <std::ranges::random_access_range R, typename Function>
+    requires std::ranges::sized_range<R> && std::invocable<Function&, std::ranges::range_reference_t<R>>
+void forEach(R&& range, Function function)
+{
+    notnan::forEach(std::execution::seq, range, std::move(function));
+}
+
+// A NotNaNRange whose values can be changed, with a value type radixSort handles
+template <typename R>
+concept RadixSortableRange = NotNaNRange<R> && !std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<R>>>
+                             && detail::IsInterchangeFormat<typename RangeElement<R>::Type>
+                             && sizeof(typename RangeElement<R>::Type) <= sizeof(std::uint64_t);
+
+namespace detail
+{
+    // bits per digit: 3 passes for float, 6 for double, and 2048 counters still fit the L1 cache
+    constexpr unsigned    RADIX_BITS    = 11;
+    constexpr std::size_t RADIX_BUCKETS = std::size_t {1} << RADIX_BITS;
+    constexpr std::size_t RADIX_BLOCK   = std::size_t {1} << 18;    // elements per parallel task
+
+    template <typename T>
+    using RadixBits = typename UnsignedOfSize<sizeof(T)>::Type;
+
+    // A key with the index of its value, for radixSortByKey
+    template <typename Bits>
+    struct KeyIndex
+    {
+        Bits        key;
+        std::size_t index;
+    };
+
+    template <typename Bits>
+    [[nodiscard]]
+    constexpr auto radixKey(const Bits key) noexcept -> Bits
+    {
+        return key;
+    }
+
+    template <typename Bits>
+    [[nodiscard]]
+    constexpr auto radixKey(const KeyIndex<Bits>& item) noexcept -> Bits
+    {
+        return item.key;
+    }
+
+    template <typename Item>
+    [[nodiscard]]
+    constexpr auto radixDigit(const Item& item, const unsigned shift) noexcept -> std::size_t
+    {
+        return static_cast<std::size_t>(radixKey(item) >> shift) & (RADIX_BUCKETS - 1);
+    }
+
+    // LSD radix sort of items by their unsigned keys of keyBits bits, stable.
+    // Under a parallel policy every pass counts and scatters blocks of the items in parallel, the blocks scatter to
+    // disjoint ranges, so the order within each digit stays the order of the blocks.
+    template <typename Item>
+    void radixSortItems(const ExecutionPolicy auto& policy, std::vector<Item>& items, const unsigned keyBits)
+    {
+        using E = std::remove_cvref_t<decltype(policy)>;
+
+        const std::size_t size = items.size();
+        if (size < 2)
+        {
+            return;
+        }
+        constexpr bool    PARALLEL = std::same_as<E, std::execution::parallel_policy>
+                                  || std::same_as<E, std::execution::parallel_unsequenced_policy>;
+        const std::size_t blocks   = PARALLEL ? std::max<std::size_t>(1, size / RADIX_BLOCK) : 1;
+        const unsigned    passes   = (keyBits + RADIX_BITS - 1) / RADIX_BITS;
+
+        std::vector<Item>        buffer(size);
+        std::vector<std::size_t> counts(blocks * RADIX_BUCKETS);
+        std::vector<std::size_t> blockIndices(blocks);
+        std::iota(blockIndices.begin(), blockIndices.end(), std::size_t {0});
+
+        const auto blockFirst = [size, blocks](const std::size_t block) { return block * size / blocks; };
+
+        // a single block counts the digits of all passes in one go, the counts do not change between passes
+        std::vector<std::size_t> allCounts;
+        if (blocks == 1)
+        {
+            allCounts.resize(passes * RADIX_BUCKETS);
+            for (const Item& item : items)
+            {
+                for (unsigned pass = 0; pass < passes; ++pass)
+                {
+                    ++allCounts[(pass * RADIX_BUCKETS) + radixDigit(item, pass * RADIX_BITS)];
+                }
+            }
+        }
+
+        Item* from = items.data();
+        Item* to   = buffer.data();
+        for (unsigned pass = 0; pass < passes; ++pass)
+        {
+            const unsigned shift = pass * RADIX_BITS;
+            if (blocks == 1)
+            {
+                std::copy_n(allCounts.begin() + (pass * RADIX_BUCKETS), RADIX_BUCKETS, counts.begin());
+            }
+            else
+            {
+                std::ranges::fill(counts, 0);
+                std::for_each(
+                  policy, blockIndices.begin(), blockIndices.end(),
+                  [&](const std::size_t block) noexcept
+                  {
+                      std::size_t* const blockCounts = counts.data() + (block * RADIX_BUCKETS);
+                      for (std::size_t idx = blockFirst(block); idx < blockFirst(block + 1); ++idx)
+                      {
+                          ++blockCounts[radixDigit(from[idx], shift)];
+                      }
+                  }
+                );
+            }
+
+            // counts to offsets, digit by digit and within a digit block by block
+            std::size_t offset = 0;
+            bool        skip   = false;
+            for (std::size_t digit = 0; digit < RADIX_BUCKETS; ++digit)
+            {
+                const std::size_t digitFirst = offset;
+                for (std::size_t block = 0; block < blocks; ++block)
+                {
+                    offset += std::exchange(counts[(block * RADIX_BUCKETS) + digit], offset);
+                }
+                skip = skip || offset - digitFirst == size;
+            }
+            // all items have the same digit, the pass would not move anything
+            if (skip)
+            {
+                continue;
+            }
+
+            std::for_each(
+              policy, blockIndices.begin(), blockIndices.end(),
+              [&](const std::size_t block) noexcept
+              {
+                  std::size_t* const blockOffsets = counts.data() + (block * RADIX_BUCKETS);
+                  for (std::size_t idx = blockFirst(block); idx < blockFirst(block + 1); ++idx)
+                  {
+                      to[blockOffsets[radixDigit(from[idx], shift)]++] = from[idx];
+                  }
+              }
+            );
+            std::swap(from, to);
+        }
+
+        if (from != items.data())
+        {
+            items.swap(buffer);
+        }
+    }
+}    // namespace detail
+
+// Sorts the values ascending in linear time, by an LSD radix sort of their bits with the sign flipped so that the
+// unsigned order of the bits is the order of the values. No comparisons, so no NaN checks either.
+// -0.0 ends up before +0.0. Takes twice the memory of the values.
+// Under a parallel policy each pass counts and scatters blocks in parallel.
+template <RadixSortableRange R>
+void radixSort(detail::ExecutionPolicy auto&& policy, R&& values)
+{
+    using T    = RangeElement<R>::Type;
+    using Bits = detail::RadixBits<T>;
+
+    const std::size_t size  = std::ranges::size(values);
+    // the sorted bits are written back as T
+    T* const          first = detail::rawData(std::span {std::to_address(std::ranges::begin(values)), size});
+
+    std::vector<Bits> keys(size);
+    std::transform(
+      policy, first, first + size, keys.begin(), [](const T value) noexcept { return detail::orderedBits(value); }
+    );
+    detail::radixSortItems(policy, keys, 8 * sizeof(T));
+    std::transform(
+      policy, keys.begin(), keys.end(), first, [](const Bits key) noexcept { return detail::fromOrderedBits<T>(key); }
+    );
+}
+
+template <RadixSortableRange R>
+void radixSort(R&& values)
+{
+    notnan::radixSort(std::execution::seq, values);
+}
+
+// Sorts keys ascending like radixSort and moves values[i] along with keys[i]. Stable, values with equal keys keep
+// their order. Throws std::invalid_argument if the sizes differ.
+template <RadixSortableRange K, std::ranges::random_access_range V>
+    requires std::ranges::sized_range<V> && std::movable<std::ranges::range_value_t<V>>
+void radixSortByKey(detail::ExecutionPolicy auto&& policy, K&& keys, V&& values)
+{
+    using T     = RangeElement<K>::Type;
+    using Item  = detail::KeyIndex<detail::RadixBits<T>>;
+    using Value = std::ranges::range_value_t<V>;
+
+    const std::size_t size = std::ranges::size(keys);
+    detail::checkSizes(size, std::ranges::size(values));
+
+    RangeElement<K>* const keyFirst   = std::to_address(std::ranges::begin(keys));
+    const auto             valueFirst = std::ranges::begin(values);
+
+    std::vector<Item> items(size);
+    for (std::size_t idx = 0; idx < size; ++idx)
+    {
+        items[idx] = {detail::orderedBits(*keyFirst[idx]), idx};
+    }
+    detail::radixSortItems(policy, items, 8 * sizeof(T));
+
+    // gather through the sorted indices
+    std::vector<RangeElement<K>> sortedKeys;
+    std::vector<Value>           sortedValues;
+    sortedKeys.reserve(size);
+    sortedValues.reserve(size);
+    for (const Item& item : items)
+    {
+        sortedKeys.push_back(keyFirst[item.index]);
+        sortedValues.push_back(std::move(valueFirst[static_cast<std::ranges::range_difference_t<V>>(item.index)]));
+    }
+    std::ranges::copy(sortedKeys, keyFirst);
+    std::ranges::move(sortedValues, valueFirst);
+}
+
+template <RadixSortableRange K, std::ranges::random_access_range V>
+    requires std::ranges::sized_range<V> && std::movable<std::ranges::range_value_t<V>>
+void radixSortByKey(K&& keys, V&& values)
+{
+    notnan::radixSortByKey(std::execution::seq, keys, values);
+}
+}    // namespace notnan
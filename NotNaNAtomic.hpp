@@ -0,0 +1,224 @@
+#pragma once
+
+#include "NotNaN.hpp"
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+
+namespace notnan
+{
+namespace detail
+{
+    // std::hardware_destructive_interference_size may change between compiler versions, GCC warns about it in headers
+    inline constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    // The order of the loads of a read-modify-write, like the failure order compare_exchange derives from a single one
+    [[nodiscard]]
+    constexpr auto loadOrder(const std::memory_order order) noexcept -> std::memory_order
+    {
+        switch (order)
+        {
+            case std::memory_order_release: return std::memory_order_relaxed;
+            case std::memory_order_acq_rel: return std::memory_order_acquire;
+            default: return order;
+        }
+    }
+}    // namespace detail
+}    // namespace notnan
+
+// A NotNaN<T, Policy> shared between threads, lock-free like std::atomic<T>. Updates whose result would be NaN are
+// refused through Policy before they are published, so no thread ever sees one. Unlike NotNaN, policies that defer
+// the check of results (HardwarePolicy) are checked here as well, other threads would see the NaN before the scope
+// reports it. fetch_add, fetch_sub, fetch_min and fetch_max are compare and exchange loops returning the previous
+// value.
+//
+//   AtomicNotNaN<double> total {NotNaN<double> {0.0}};
+//   total.fetch_add(NotNaN<double> {sample});    // from any thread, throws instead of storing inf + -inf
+template <std::floating_point T, notnan::CheckPolicy Policy = notnan::ThrowPolicy>
+    requires std::atomic<T>::is_always_lock_free
+class AtomicNotNaN
+{
+  public:
+    using Type       = T;
+    using PolicyType = Policy;
+    using ValueType  = NotNaN<T, Policy>;
+
+    static constexpr bool is_always_lock_free = true;
+
+  private:
+    std::atomic<T> m_value;
+
+    template <typename R>
+    using Result = typename Policy::template Result<R>;
+
+    [[nodiscard]]
+    static auto wrap(const T value) noexcept -> ValueType
+    {
+        return notnan::detail::UncheckedAccess::make<ValueType>(value);
+    }
+
+    // The failure path of the updates, out of line like that of NotNaN
+    template <typename R>
+    [[nodiscard, gnu::cold, gnu::noinline]]
+    static auto failure(const notnan::NaNError error) -> Result<R>
+    {
+        return Policy::template failure<R>(error);
+    }
+
+    // Nothing is stored when the result is NaN
+    template <typename BinaryOp>
+    auto update(const ValueType& operand, const BinaryOp& operation, const std::memory_order order) -> Result<ValueType>
+    {
+        constexpr notnan::Operation OPERATION = notnan::detail::OPERATION_OF<BinaryOp>;
+
+        const std::memory_order loadOrder = notnan::detail::loadOrder(order);
+        T                       current   = m_value.load(loadOrder);
+        while (true)
+        {
+            const T desired = notnan::detail::compute<T>(operation, current, *operand);
+            if (Policy::CHECKED && notnan::isNaN(desired)) [[unlikely]]
+            {
+                return failure<ValueType>({OPERATION, notnan::Operand::Result});
+            }
+            if (m_value.compare_exchange_weak(current, desired, order, loadOrder))
+            {
+                return Policy::template success<ValueType>(wrap(current));
+            }
+        }
+    }
+
+    // Only stores when operand replaces the value, otherwise it is just a load
+    template <typename Compare>
+    auto replaceIf(
+      const ValueType& operand, const Compare& replaces, const std::memory_order order
+    ) noexcept -> ValueType
+    {
+        const std::memory_order loadOrder = notnan::detail::loadOrder(order);
+        T                       current   = m_value.load(loadOrder);
+        while (replaces(*operand, current) && !m_value.compare_exchange_weak(current, *operand, order, loadOrder))
+        {
+            // current was reloaded
+        }
+        return wrap(current);
+    }
+
+  public:
+    AtomicNotNaN()  = delete;    // force initialization
+    ~AtomicNotNaN() = default;
+
+    explicit constexpr AtomicNotNaN(const ValueType& value) noexcept : m_value {*value}
+    {
+        // empty
+    }
+
+    AtomicNotNaN(const AtomicNotNaN& other)                     = delete;
+    AtomicNotNaN(AtomicNotNaN&& other)                          = delete;
+    auto operator= (const AtomicNotNaN& other) -> AtomicNotNaN& = delete;
+    auto operator= (AtomicNotNaN&& other) -> AtomicNotNaN&      = delete;
+
+    [[nodiscard]]
+    auto is_lock_free() const noexcept -> bool
+    {
+        return m_value.is_lock_free();
+    }
+
+    [[nodiscard]]
+    auto load(const std::memory_order order = std::memory_order_seq_cst) const noexcept -> ValueType
+    {
+        return wrap(m_value.load(order));
+    }
+
+    void store(const ValueType& value, const std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        m_value.store(*value, order);
+    }
+
+    auto exchange(
+      const ValueType& value, const std::memory_order order = std::memory_order_seq_cst
+    ) noexcept -> ValueType
+    {
+        return wrap(m_value.exchange(*value, order));
+    }
+
+    // Like std::atomic the values are compared by their bits, 0.0 and -0.0 differ
+    auto compare_exchange_weak(
+      ValueType& expected, const ValueType& desired, const std::memory_order success, const std::memory_order failure
+    ) noexcept -> bool
+    {
+        T raw = *expected;
+        if (m_value.compare_exchange_weak(raw, *desired, success, failure))
+        {
+            return true;
+        }
+        expected = wrap(raw);
+        return false;
+    }
+
+    auto compare_exchange_weak(
+      ValueType& expected, const ValueType& desired, const std::memory_order order = std::memory_order_seq_cst
+    ) noexcept -> bool
+    {
+        return compare_exchange_weak(expected, desired, order, notnan::detail::loadOrder(order));
+    }
+
+    auto compare_exchange_strong(
+      ValueType& expected, const ValueType& desired, const std::memory_order success, const std::memory_order failure
+    ) noexcept -> bool
+    {
+        T raw = *expected;
+        if (m_value.compare_exchange_strong(raw, *desired, success, failure))
+        {
+            return true;
+        }
+        expected = wrap(raw);
+        return false;
+    }
+
+    auto compare_exchange_strong(
+      ValueType& expected, const ValueType& desired, const std::memory_order order = std::memory_order_seq_cst
+    ) noexcept -> bool
+    {
+        return compare_exchange_strong(expected, desired, order, notnan::detail::loadOrder(order));
+    }
+
+    // Read-modify-write, returning the value from before
+    auto fetch_add(
+      const ValueType& operand, const std::memory_order order = std::memory_order_seq_cst
+    ) -> Result<ValueType>
+    {
+        return update(operand, std::plus {}, order);
+    }
+
+    auto fetch_sub(
+      const ValueType& operand, const std::memory_order order = std::memory_order_seq_cst
+    ) -> Result<ValueType>
+    {
+        return update(operand, std::minus {}, order);
+    }
+
+    // Can't give NaN, they only ever store operand
+    auto fetch_min(
+      const ValueType& operand, const std::memory_order order = std::memory_order_seq_cst
+    ) noexcept -> ValueType
+    {
+        return replaceIf(operand, std::less {}, order);
+    }
+
+    auto fetch_max(
+      const ValueType& operand, const std::memory_order order = std::memory_order_seq_cst
+    ) noexcept -> ValueType
+    {
+        return replaceIf(operand, std::greater {}, order);
+    }
+};
+
+// An AtomicNotNaN alone on its cache line, so that updates to its neighbours in an array don't slow it down
+template <std::floating_point T, notnan::CheckPolicy Policy = notnan::ThrowPolicy>
+    requires std::atomic<T>::is_always_lock_free
+class alignas(notnan::detail::CACHE_LINE_SIZE) PaddedAtomicNotNaN : public AtomicNotNaN<T, Policy>
+{
+  public:
+    using AtomicNotNaN<T, Policy>::AtomicNotNaN;
+};
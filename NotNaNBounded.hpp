@@ -0,0 +1,827 @@
+#pragma once
+
+#include "NotNaN.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <expected>
+#include <format>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <type_traits>
+
+// NotNaN with bounds known at compile time.
+// BoundedNotNaN<T, Lo, Hi> holds values in [Lo, Hi]. Arithmetic computes the bounds of its result at compile time,
+// and only checks for NaN where the bounds of the operands don't rule it out: inf - inf needs infinite bounds,
+// 0 * inf a zero and an infinite bound, sqrt and log a negative lower bound, asin and acos bounds beyond [-1, 1].
+// Elsewhere the result is the raw operation or std:: call.
+//
+//   BoundedNotNaN<double, 0, 1>  gain {0.5};
+//   BoundedNotNaN<double, -5, 5> error {x};             // range checked
+//   auto u = gain * error;                              // BoundedNotNaN<double, -5, 5>, not checked
+//   auto s = (gain * gain).sqrt();                      // BoundedNotNaN<double, 0, 1>, not checked
+//
+// Values are range checked on construction and when converted to narrower bounds, widening is free.
+// A result without any finite bound is plain NotNaN.
+// The bounds of + - * / are computed with the same rounding as the values, and a bound that was rounded is moved
+// outward by one ulp. Since rounding is monotonic they then also hold where a * b + c is contracted into a fused
+// multiply-add, which skips the rounding of a * b: constant<0.1> * constant<0.1> - constant<0.010000000000000002> is
+// bounded by [-5e-324, 5e-324], not [0, 0], and the sqrt of it is checked. Don't change the rounding mode, and don't
+// build with -ffast-math.
+// The bounds of the math members are widened by a few ulp, because std::log, std::asin and std::acos need not be
+// correctly rounded.
+namespace notnan
+{
+template <std::floating_point T, T Lo, T Hi, CheckPolicy Policy = ThrowPolicy>
+class Bounded;
+
+namespace detail
+{
+    template <std::floating_point T>
+    inline constexpr T INF = std::numeric_limits<T>::infinity();
+
+    // -0.0 and +0.0 bound the same values, so that every interval is spelled by exactly one type
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto normalizedBound(const T bound) noexcept -> T
+    {
+        return bound == T {0} ? T {0} : bound;
+    }
+
+    // The bounds of a result, and whether values within the bounds of the operands can still produce NaN
+    template <std::floating_point T>
+    struct Interval
+    {
+        T    lo;
+        T    hi;
+        bool check = false;
+
+        [[nodiscard]]
+        constexpr auto containsZero() const noexcept -> bool
+        {
+            return lo <= T {0} && T {0} <= hi;
+        }
+
+        [[nodiscard]]
+        constexpr auto mayBeInfinity() const noexcept -> bool
+        {
+            return lo == -INF<T> || hi == INF<T>;
+        }
+
+        [[nodiscard]]
+        constexpr auto normalized() const noexcept -> Interval
+        {
+            return {normalizedBound(lo), normalizedBound(hi), check};
+        }
+    };
+
+    // Bounds that come from approximations are moved outward by at least two ulp
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto below(const T bound) noexcept -> T
+    {
+        constexpr T EPSILON = std::numeric_limits<T>::epsilon();
+        return bound - ((bound < T {0} ? -bound : bound) * 2 * EPSILON);
+    }
+
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto above(const T bound) noexcept -> T
+    {
+        return -below(-bound);
+    }
+
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto isInfinity(const T value) noexcept -> bool
+    {
+        return value == INF<T> || value == -INF<T>;
+    }
+
+    // Whether lhs + rhs gave sum without rounding, with Knuth's two-sum. A finite sum never rounds to infinity.
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto isExactSum(const T lhs, const T rhs, const T sum) noexcept -> bool
+    {
+        if (isInfinity(sum))
+        {
+            return isInfinity(lhs) || isInfinity(rhs);
+        }
+        const T rhsPart = sum - lhs;
+        const T lhsPart = sum - rhsPart;
+        return (lhs - lhsPart) + (rhs - rhsPart) == T {0};
+    }
+
+    // Whether lhs * rhs gave product without rounding, with Dekker's exact product. Products near the ends of the
+    // range can't be split and count as rounded.
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto isExactProduct(const T lhs, const T rhs, const T product) noexcept -> bool
+    {
+        using L                 = std::numeric_limits<T>;
+        constexpr T       SPLIT = static_cast<T>(1ULL << ((L::digits + 1) / 2)) + 1;
+        if (lhs == T {0} || rhs == T {0} || isInfinity(lhs) || isInfinity(rhs))
+        {
+            return true;
+        }
+        const T x = lhs < T {0} ? -lhs : lhs;
+        const T y = rhs < T {0} ? -rhs : rhs;
+        const T p = product < T {0} ? -product : product;
+        if (x > L::max() / SPLIT || y > L::max() / SPLIT || p > L::max() / 2 || p < L::min() * SPLIT * SPLIT)
+        {
+            return false;
+        }
+        const T scaledX = SPLIT * x;
+        const T highX   = scaledX - (scaledX - x);
+        const T lowX    = x - highX;
+        const T scaledY = SPLIT * y;
+        const T highY   = scaledY - (scaledY - y);
+        const T lowY    = y - highY;
+        return (((highX * highY - p) + (highX * lowY)) + (lowX * highY)) + (lowX * lowY) == T {0};
+    }
+
+    // The bounds of the exact result of an operation that gave value, one ulp to either side unless it was exact
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto roundingBounds(const T value, const bool exact) noexcept -> Interval<T>
+    {
+        if (exact)
+        {
+            return {value, value};
+        }
+        return {std::nextafter(value, -INF<T>), std::nextafter(value, INF<T>)};
+    }
+
+    // A constant expression can't produce NaN, so inf + -inf is caught before it is computed
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto addBound(const T lhs, const T rhs, const T fallback) noexcept -> T
+    {
+        if (isInfinity(lhs) && lhs == -rhs)
+        {
+            return fallback;
+        }
+        const T           sum    = lhs + rhs;
+        const Interval<T> bounds = roundingBounds(sum, isExactSum(lhs, rhs, sum));
+        return fallback < T {0} ? bounds.lo : bounds.hi;
+    }
+
+    // inf + -inf
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto addBounds(const Interval<T> lhs, const Interval<T> rhs) noexcept -> Interval<T>
+    {
+        return Interval<T> {
+          addBound(lhs.lo, rhs.lo, -INF<T>),
+          addBound(lhs.hi, rhs.hi, INF<T>),
+          (lhs.hi == INF<T> && rhs.lo == -INF<T>) || (lhs.lo == -INF<T> && rhs.hi == INF<T>)
+        }.normalized();
+    }
+
+    // inf - inf, -inf - -inf
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto subtractBounds(const Interval<T> lhs, const Interval<T> rhs) noexcept -> Interval<T>
+    {
+        return Interval<T> {
+          addBound(lhs.lo, -rhs.hi, -INF<T>),
+          addBound(lhs.hi, -rhs.lo, INF<T>),
+          (lhs.hi == INF<T> && rhs.hi == INF<T>) || (lhs.lo == -INF<T> && rhs.lo == -INF<T>)
+        }.normalized();
+    }
+
+    // The extremes of a product or quotient are at the corners, operation gives the bounds of each. Where a corner is
+    // undefined (0 * inf, inf / inf), the values next to it give anything from 0 to an infinity, with the sign of the
+    // values inside the intervals.
+    template <std::floating_point T, typename BinaryOp, typename Undefined>
+    [[nodiscard]]
+    constexpr auto cornerBounds(
+      const Interval<T> lhs, const Interval<T> rhs, const BinaryOp& operation, const Undefined& undefined
+    ) noexcept -> Interval<T>
+    {
+        struct Corner
+        {
+            T value;
+            T inward;    // +1 at a lower bound, -1 at an upper bound
+        };
+
+        Interval<T> result {INF<T>, -INF<T>};
+        const auto  include = [&result](const T value)
+        {
+            result.lo = std::min(result.lo, value);
+            result.hi = std::max(result.hi, value);
+        };
+        const auto  sign    = [](const Corner corner)
+        { return corner.value == T {0} ? corner.inward : (corner.value < T {0} ? T {-1} : T {1}); };
+
+        for (const Corner x : {Corner {lhs.lo, 1}, Corner {lhs.hi, -1}})
+        {
+            for (const Corner y : {Corner {rhs.lo, 1}, Corner {rhs.hi, -1}})
+            {
+                if (undefined(x.value, y.value))
+                {
+                    include(T {0});
+                    include(sign(x) * sign(y) * INF<T>);
+                }
+                else
+                {
+                    const Interval<T> corner = operation(x.value, y.value);
+                    include(corner.lo);
+                    include(corner.hi);
+                }
+            }
+        }
+        return result;
+    }
+
+    // 0 * inf
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto multiplyBounds(const Interval<T> lhs, const Interval<T> rhs) noexcept -> Interval<T>
+    {
+        Interval<T> result = cornerBounds(
+          lhs, rhs,
+          [](const T x, const T y)
+          {
+              const T product = x * y;
+              return roundingBounds(product, isExactProduct(x, y, product));
+          },
+          [](const T x, const T y) { return (x == T {0} && isInfinity(y)) || (isInfinity(x) && y == T {0}); }
+        );
+        result.check       = (lhs.containsZero() && rhs.mayBeInfinity()) || (lhs.mayBeInfinity() && rhs.containsZero());
+        return result.normalized();
+    }
+
+    // 0 / 0, inf / inf. A divisor bounded by 0 may be -0.0 or +0.0, so the result may be either infinity.
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto divideBounds(const Interval<T> lhs, const Interval<T> rhs) noexcept -> Interval<T>
+    {
+        Interval<T> result {-INF<T>, INF<T>};
+        if (!rhs.containsZero())
+        {
+            result = cornerBounds(
+              lhs, rhs,
+              [](const T x, const T y)
+              {
+                  // x / y is exact where y times it gives x back exactly
+                  const T quotient = x / y;
+                  const T product  = quotient * y;
+                  return roundingBounds(quotient, isInfinity(x) || (product == x && isExactProduct(quotient, y, product)));
+              },
+              [](const T x, const T y) { return isInfinity(x) && isInfinity(y); }
+            );
+        }
+        result.check       = (lhs.containsZero() && rhs.containsZero()) || (lhs.mayBeInfinity() && rhs.mayBeInfinity());
+        return result.normalized();
+    }
+
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto negateBounds(const Interval<T> value) noexcept -> Interval<T>
+    {
+        return Interval<T> {-value.hi, -value.lo}.normalized();
+    }
+
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto absBounds(const Interval<T> value) noexcept -> Interval<T>
+    {
+        if (value.lo >= T {0})
+        {
+            return value;
+        }
+        if (value.hi <= T {0})
+        {
+            return negateBounds(value);
+        }
+        return Interval<T> {0, std::max(-value.lo, value.hi)};
+    }
+
+    // Newton's method from above, within an ulp of the square root of a positive finite value
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto approximateSqrt(const T value) noexcept -> T
+    {
+        T root = std::max(value, T {1});
+        while (true)
+        {
+            const T next = (root + (value / root)) / 2;
+            if (next >= root)
+            {
+                return root;
+            }
+            root = next;
+        }
+    }
+
+    // std::sqrt is correctly rounded, so exact roots stay exact and the others are widened
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto sqrtBound(const T value, const bool upper) noexcept -> T
+    {
+        if (value <= T {0} || value == INF<T>)
+        {
+            return value <= T {0} ? T {0} : value;
+        }
+        const T root = approximateSqrt(value);
+        if (root * root == value && isExactProduct(root, root, value))
+        {
+            return root;
+        }
+        return upper ? above(root) : std::max(below(root), T {0});
+    }
+
+    // sqrt(-x), sqrt(-0.0) is -0.0
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto sqrtBounds(const Interval<T> value) noexcept -> Interval<T>
+    {
+        return Interval<T> {sqrtBound(value.lo, false), sqrtBound(value.hi, true), value.lo < T {0}}.normalized();
+    }
+
+    // log(x) for x in [2^e, 2^(e + 1)) is in [e * ln 2, (e + 1) * ln 2], and never above x - 1
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto logBound(const T value, const bool upper) noexcept -> T
+    {
+        if (value <= T {0} || value == INF<T>)
+        {
+            return value <= T {0} ? -INF<T> : value;
+        }
+        int exponent = 0;
+        for (T mantissa = value; mantissa >= T {2}; mantissa /= 2)
+        {
+            ++exponent;
+        }
+        for (T mantissa = value; mantissa < T {1}; mantissa *= 2)
+        {
+            --exponent;
+        }
+        const T bound = static_cast<T>(exponent + (upper ? 1 : 0)) * std::numbers::ln2_v<T>;
+        return upper ? std::min(above(bound), above(value - T {1})) : below(bound);
+    }
+
+    // log(-x), log(0) is -inf
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto logBounds(const Interval<T> value) noexcept -> Interval<T>
+    {
+        return Interval<T> {logBound(value.lo, false), logBound(value.hi, true), value.lo < T {0}}.normalized();
+    }
+
+    // |x| <= |asin(x)| <= pi / 2 * |x|, the lower one holds exactly for a faithfully rounded std::asin
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto asinBound(const T value, const bool upper) noexcept -> T
+    {
+        const T clamped = std::clamp(value, T {-1}, T {1});
+        if ((clamped >= T {0}) != upper)
+        {
+            return clamped;
+        }
+        const T bound = std::numbers::pi_v<T> / 2 * clamped;
+        return upper ? above(bound) : below(bound);
+    }
+
+    // asin(x) and acos(x) for |x| > 1
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto asinBounds(const Interval<T> value) noexcept -> Interval<T>
+    {
+        return Interval<T> {asinBound(value.lo, false), asinBound(value.hi, true), value.lo < T {-1} || value.hi > T {1}}
+          .normalized();
+    }
+
+    // acos(x) = pi / 2 - asin(x), in [0, pi]
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto acosBounds(const Interval<T> value) noexcept -> Interval<T>
+    {
+        constexpr T       HALF_PI = std::numbers::pi_v<T> / 2;
+        const Interval<T> asin    = asinBounds(value);
+        return Interval<T> {
+          std::max(below(HALF_PI - asin.hi), T {0}),
+          std::min(above(HALF_PI - asin.lo), above(std::numbers::pi_v<T>)),
+          asin.check
+        }.normalized();
+    }
+
+    // sin(inf), cos(inf)
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto trigBounds(const Interval<T> value) noexcept -> Interval<T>
+    {
+        return {-1, 1, value.mayBeInfinity()};
+    }
+
+    [[nodiscard, gnu::cold]]
+    inline auto describeBounds(const auto value, const auto lo, const auto hi) -> std::string
+    {
+        return std::format("{} is not in [{}, {}]", value, lo, hi);
+    }
+
+    template <std::floating_point T>
+    [[noreturn, gnu::cold, gnu::noinline]]
+    void throwBoundsError(const T value, const T lo, const T hi)
+    {
+        throw std::invalid_argument(describeBounds(value, lo, hi));
+    }
+
+    // Reports a value outside the bounds through Policy, the default policy names the value and the bounds.
+    // The other policies only know NaNError, to them it is a bad value given to a constructor.
+    template <CheckPolicy Policy, std::floating_point T>
+    [[gnu::cold, gnu::noinline]]
+    void raiseBoundsError(const T value, const T lo, const T hi)
+    {
+        if constexpr (std::same_as<Policy, ThrowPolicy>)
+        {
+            throwBoundsError(value, lo, hi);
+        }
+        else
+        {
+            Policy::raise({Operation::Construct, Operand::Value});
+        }
+    }
+
+    // Like raiseBoundsError, through Policy's Result where there is one
+    template <typename Out, CheckPolicy Policy, std::floating_point T>
+    [[gnu::cold, gnu::noinline]]
+    auto boundsFailure(const T value, const T lo, const T hi) -> typename Policy::template Result<Out>
+    {
+        if constexpr (std::same_as<Policy, ThrowPolicy>)
+        {
+            throwBoundsError(value, lo, hi);
+        }
+        else
+        {
+            return Policy::template failure<Out>({Operation::Construct, Operand::Value});
+        }
+    }
+
+    // Results without any finite bound are plain NotNaN
+    template <std::floating_point T, T Lo, T Hi, CheckPolicy Policy, bool UNBOUNDED = (Lo == -INF<T> && Hi == INF<T>)>
+    struct BoundedType
+    {
+        using Type = Bounded<T, Lo, Hi, Policy>;
+    };
+
+    template <std::floating_point T, T Lo, T Hi, CheckPolicy Policy>
+    struct BoundedType<T, Lo, Hi, Policy, true>
+    {
+        using Type = NotNaN<T, Policy>;
+    };
+
+    template <typename U>
+    inline constexpr bool IS_BOUNDED = false;
+
+    template <std::floating_point T, T Lo, T Hi, CheckPolicy Policy>
+    inline constexpr bool IS_BOUNDED<Bounded<T, Lo, Hi, Policy>> = true;
+
+    // NotNaN is bounded by the infinities
+    template <typename U>
+    inline constexpr Interval<typename U::Type> BOUNDS_OF {-INF<typename U::Type>, INF<typename U::Type>};
+
+    template <std::floating_point T, T Lo, T Hi, CheckPolicy Policy>
+    inline constexpr Interval<T> BOUNDS_OF<Bounded<T, Lo, Hi, Policy>> {Lo, Hi};
+
+    template <typename U>
+    concept BoundedOperand = IS_BOUNDED<U> || IsNotNaN<U>;
+
+    // At least one operand is bounded, NotNaN with NotNaN keeps the operators of NotNaN
+    template <typename L, typename R>
+    concept BoundedOperands = BoundedOperand<L> && BoundedOperand<R> && (IS_BOUNDED<L> || IS_BOUNDED<R>)
+                              && std::same_as<typename L::Type, typename R::Type>
+                              && std::same_as<typename L::PolicyType, typename R::PolicyType>;
+
+    template <CheckPolicy Policy, auto RESULT>
+    [[nodiscard]]
+    constexpr auto makeBounded(const auto value, const Operation operation)
+    {
+        using T = std::remove_cvref_t<decltype(RESULT.lo)>;
+        return makeProven<typename BoundedType<T, RESULT.lo, RESULT.hi, Policy>::Type, Policy, RESULT.check>(
+          static_cast<T>(value), operation
+        );
+    }
+
+    // Lets in-place operations exist where they need no check and stay within the bounds of the lhs
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto keepsBounds(const Interval<T> lhs, const Interval<T> result) noexcept -> bool
+    {
+        return !result.check && lhs.lo <= result.lo && result.hi <= lhs.hi;
+    }
+}    // namespace detail
+
+// Satisfied by the Bounded specializations only
+template <typename U>
+concept IsBounded = detail::IS_BOUNDED<U>;
+
+// NotNaN<T, Policy> whose values are in [Lo, Hi], usually spelled BoundedNotNaN<T, Lo, Hi>.
+// Converts implicitly to NotNaN and to wider bounds, explicitly and checked to narrower ones.
+// NaN and values outside the bounds are reported through Policy, the default policy throws std::invalid_argument
+// naming the bounds.
+// Like NotNaN, policies without checks trust the caller.
+template <std::floating_point T, T Lo, T Hi, CheckPolicy Policy>
+class Bounded
+{
+    static_assert(!isNaN(Lo) && !isNaN(Hi) && Lo <= Hi, "Bounds have to be numbers with Lo <= Hi");
+
+  private:
+    T m_value;
+
+    friend struct detail::UncheckedAccess;
+
+    static constexpr detail::Interval<T> BOUNDS {Lo, Hi};
+
+    constexpr Bounded(detail::UncheckedTag /* tag */, const T& value) noexcept : m_value {value}
+    {
+        // empty
+    }
+
+    static constexpr void checkBounds(const T& value)
+    {
+        if constexpr (Policy::CHECKED)
+        {
+            if (value < Lo || Hi < value) [[unlikely]]
+            {
+                detail::raiseBoundsError<Policy>(value, Lo, Hi);
+            }
+        }
+    }
+
+    template <detail::Interval<T> RESULT>
+    [[nodiscard]]
+    static constexpr auto makeResult(const T& value, const Operation operation)
+    {
+        return detail::makeBounded<Policy, RESULT>(value, operation);
+    }
+
+  public:
+    using Type       = T;
+    using PolicyType = Policy;
+
+    static constexpr T LOWER = Lo;
+    static constexpr T UPPER = Hi;
+
+    Bounded() = delete;    // force initialization
+
+    constexpr explicit Bounded(const T& value) : m_value {value}
+    {
+        if constexpr (Policy::CHECKED)
+        {
+            if (isNaN(value)) [[unlikely]]
+            {
+                Policy::raise({Operation::Construct, Operand::Value});
+            }
+        }
+        checkBounds(value);
+    }
+
+    constexpr explicit Bounded(const NotNaN<T, Policy>& value) : m_value {*value}
+    {
+        checkBounds(m_value);
+    }
+
+    // Widening is free, narrowing is checked
+    template <T L, T H>
+    constexpr explicit(L < Lo || Hi < H) Bounded(const Bounded<T, L, H, Policy>& other) : m_value {*other}
+    {
+        if constexpr (L < Lo || Hi < H)
+        {
+            checkBounds(m_value);
+        }
+    }
+
+    // Construction that reports NaN and values outside the bounds through the policy's result type instead of raising.
+    // The default policy still throws, naming the bounds.
+    [[nodiscard]]
+    static constexpr auto fromValue(const T& value) -> typename Policy::template Result<Bounded>
+    {
+        if constexpr (Policy::CHECKED)
+        {
+            if (isNaN(value)) [[unlikely]]
+            {
+                return detail::provenFailure<Bounded, Policy>({Operation::Construct, Operand::Value});
+            }
+            if (value < Lo || Hi < value) [[unlikely]]
+            {
+                return detail::boundsFailure<Bounded, Policy>(value, Lo, Hi);
+            }
+        }
+        return Policy::template success<Bounded>(Bounded {detail::UncheckedTag {}, value});
+    }
+
+    // Construction that reports NaN and values outside the bounds through std::expected, whatever the policy
+    [[nodiscard]]
+    static constexpr auto tryFromValue(const T& value) noexcept -> std::expected<Bounded, NaNError>
+    {
+        if (Policy::CHECKED && (isNaN(value) || value < Lo || Hi < value)) [[unlikely]]
+        {
+            return std::unexpected(NaNError {Operation::Construct, Operand::Value});
+        }
+        return Bounded {detail::UncheckedTag {}, value};
+    }
+
+    // Getting the value
+    [[nodiscard]]
+    constexpr auto operator* () const noexcept -> T
+    {
+        return m_value;
+    }
+
+    [[nodiscard]]
+    constexpr auto value() const noexcept -> NotNaN<T, Policy>
+    {
+        return detail::UncheckedAccess::make<NotNaN<T, Policy>>(m_value);
+    }
+
+    [[nodiscard]]
+    constexpr operator NotNaN<T, Policy> () const noexcept    // NOLINT(google-explicit-constructor)
+    {
+        return value();
+    }
+
+    // Comparison
+    template <typename U>
+        requires detail::BoundedOperands<Bounded, U>
+    [[nodiscard]]
+    constexpr auto operator<=> (const U& rhs) const noexcept -> std::strong_ordering
+    {
+        return value() <=> static_cast<NotNaN<T, Policy>>(rhs);
+    }
+    template <typename U>
+        requires detail::BoundedOperands<Bounded, U>
+    [[nodiscard]]
+    constexpr auto operator== (const U& rhs) const noexcept -> bool
+    {
+        return m_value == *rhs;
+    }
+
+    // Raw values may be NaN, they are checked like in comparisons with NotNaN
+    [[nodiscard]]
+    constexpr auto operator<=> (const auto& rhs) const
+        requires std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
+    {
+        return value() <=> rhs;
+    }
+    [[nodiscard]]
+    constexpr auto operator== (const auto& rhs) const -> bool
+        requires std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
+    {
+        return value() == rhs;
+    }
+
+    // In-place arithmetic exists where it needs no check and stays within the bounds, e.g. [0, 1] *= [0, 1]
+    template <typename U>
+        requires (
+          detail::BoundedOperands<Bounded, U>
+          && detail::keepsBounds(BOUNDS, detail::addBounds(BOUNDS, detail::BOUNDS_OF<U>))
+        )
+    constexpr auto operator+= (const U& rhs) noexcept -> Bounded&
+    {
+        m_value += *rhs;
+        return *this;
+    }
+    template <typename U>
+        requires (
+          detail::BoundedOperands<Bounded, U>
+          && detail::keepsBounds(BOUNDS, detail::subtractBounds(BOUNDS, detail::BOUNDS_OF<U>))
+        )
+    constexpr auto operator-= (const U& rhs) noexcept -> Bounded&
+    {
+        m_value -= *rhs;
+        return *this;
+    }
+    template <typename U>
+        requires (
+          detail::BoundedOperands<Bounded, U>
+          && detail::keepsBounds(BOUNDS, detail::multiplyBounds(BOUNDS, detail::BOUNDS_OF<U>))
+        )
+    constexpr auto operator*= (const U& rhs) noexcept -> Bounded&
+    {
+        m_value *= *rhs;
+        return *this;
+    }
+    template <typename U>
+        requires (
+          detail::BoundedOperands<Bounded, U>
+          && detail::keepsBounds(BOUNDS, detail::divideBounds(BOUNDS, detail::BOUNDS_OF<U>))
+        )
+    constexpr auto operator/= (const U& rhs) noexcept -> Bounded&
+    {
+        m_value /= *rhs;
+        return *this;
+    }
+
+    // Unary operators
+    constexpr auto operator+ () const noexcept -> Bounded { return *this; }
+    constexpr auto operator- () const noexcept { return makeResult<detail::negateBounds(BOUNDS)>(-m_value, Operation::Construct); }
+
+    // Math members, the raw std:: call where the bounds prove the domain and checked like those of NotNaN elsewhere
+    [[nodiscard]]
+    constexpr auto sqrt() const
+    {
+        return makeResult<detail::sqrtBounds(BOUNDS)>(std::sqrt(m_value), Operation::Sqrt);
+    }
+
+    [[nodiscard]]
+    constexpr auto log() const
+    {
+        return makeResult<detail::logBounds(BOUNDS)>(std::log(m_value), Operation::Log);
+    }
+
+    [[nodiscard]]
+    constexpr auto asin() const
+    {
+        return makeResult<detail::asinBounds(BOUNDS)>(std::asin(m_value), Operation::Asin);
+    }
+
+    [[nodiscard]]
+    constexpr auto acos() const
+    {
+        return makeResult<detail::acosBounds(BOUNDS)>(std::acos(m_value), Operation::Acos);
+    }
+
+    [[nodiscard]]
+    constexpr auto sin() const
+    {
+        return makeResult<detail::trigBounds(BOUNDS)>(std::sin(m_value), Operation::Sin);
+    }
+
+    [[nodiscard]]
+    constexpr auto cos() const
+    {
+        return makeResult<detail::trigBounds(BOUNDS)>(std::cos(m_value), Operation::Cos);
+    }
+
+    [[nodiscard]]
+    constexpr auto abs() const
+    {
+        return makeResult<detail::absBounds(BOUNDS)>(std::abs(m_value), Operation::Abs);
+    }
+};
+
+// Binary operators on two bounded types, or a bounded type and NotNaN
+template <typename L, typename R>
+    requires detail::BoundedOperands<L, R>
+[[nodiscard]]
+constexpr auto operator+ (const L& lhs, const R& rhs)
+{
+    constexpr auto RESULT = detail::addBounds(detail::BOUNDS_OF<L>, detail::BOUNDS_OF<R>);
+    return detail::makeBounded<typename L::PolicyType, RESULT>(*lhs + *rhs, Operation::Add);
+}
+
+template <typename L, typename R>
+    requires detail::BoundedOperands<L, R>
+[[nodiscard]]
+constexpr auto operator- (const L& lhs, const R& rhs)
+{
+    constexpr auto RESULT = detail::subtractBounds(detail::BOUNDS_OF<L>, detail::BOUNDS_OF<R>);
+    return detail::makeBounded<typename L::PolicyType, RESULT>(*lhs - *rhs, Operation::Subtract);
+}
+
+template <typename L, typename R>
+    requires detail::BoundedOperands<L, R>
+[[nodiscard]]
+constexpr auto operator* (const L& lhs, const R& rhs)
+{
+    constexpr auto RESULT = detail::multiplyBounds(detail::BOUNDS_OF<L>, detail::BOUNDS_OF<R>);
+    return detail::makeBounded<typename L::PolicyType, RESULT>(*lhs * *rhs, Operation::Multiply);
+}
+
+template <typename L, typename R>
+    requires detail::BoundedOperands<L, R>
+[[nodiscard]]
+constexpr auto operator/ (const L& lhs, const R& rhs)
+{
+    constexpr auto RESULT = detail::divideBounds(detail::BOUNDS_OF<L>, detail::BOUNDS_OF<R>);
+    return detail::makeBounded<typename L::PolicyType, RESULT>(*lhs / *rhs, Operation::Divide);
+}
+
+// A compile time constant as its own interval, for use in bounded arithmetic
+template <auto VALUE>
+    requires std::floating_point<decltype(VALUE)>
+inline constexpr Bounded<decltype(VALUE), detail::normalizedBound(VALUE), detail::normalizedBound(VALUE)> constant =
+  detail::UncheckedAccess::make<Bounded<decltype(VALUE), detail::normalizedBound(VALUE), detail::normalizedBound(VALUE)>>(VALUE);
+}    // namespace notnan
+
+// The bounds may be given as any arithmetic constants, BoundedNotNaN<double, 0, 1> is BoundedNotNaN<double, 0.0, 1.0>
+template <std::floating_point T, auto Lo, auto Hi, notnan::CheckPolicy Policy = notnan::ThrowPolicy>
+    requires (std::is_arithmetic_v<decltype(Lo)> && std::is_arithmetic_v<decltype(Hi)>)
+using BoundedNotNaN = notnan::Bounded<
+  T, notnan::detail::normalizedBound(static_cast<T>(Lo)), notnan::detail::normalizedBound(static_cast<T>(Hi)), Policy>;
+
+template <std::floating_point T, T Lo, T Hi, notnan::CheckPolicy Policy>
+struct std::formatter<notnan::Bounded<T, Lo, Hi, Policy>> : std::formatter<T>
+{
+    template <class FormatContext>
+    auto format(const notnan::Bounded<T, Lo, Hi, Policy>& t, FormatContext& ctx) const
+    {
+        return std::formatter<T>::format(*t, ctx);
+    }
+};
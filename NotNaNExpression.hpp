@@ -0,0 +1,330 @@
+#pragma once
+
+#include "NotNaN.hpp"
+
+#include <cmath>
+#include <concepts>
+#include <format>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Lazy arithmetic on NotNaN.
+// notnan::lazy(x) starts an expression whose + - * / build a tree instead of computing and checking each step.
+// The tree is evaluated and checked once when it is converted to a NotNaN. Since NaN propagates through the
+// arithmetic operators, checking the final result is enough to keep the invariant.
+// Only the error path walks the tree again to find the sub-expression that first produced NaN.
+//
+//   NotNaN<double> r = notnan::lazy(a) * b + c / d - e;
+//
+// The eager operators of NotNaN are unchanged, a chain only becomes lazy once one operand is an expression.
+namespace notnan::expression
+{
+struct NodeBase
+{
+};
+
+template <typename N>
+concept Node = std::derived_from<std::remove_cvref_t<N>, NodeBase>;
+
+template <typename U>
+concept Operand = Node<U> || IsNotNaN<std::remove_cvref_t<U>> || std::is_arithmetic_v<std::remove_cvref_t<U>>;
+
+namespace detail
+{
+    template <typename BinaryOp>
+    inline constexpr char SYMBOL = '?';
+    template <>
+    inline constexpr char SYMBOL<std::plus<>> = '+';
+    template <>
+    inline constexpr char SYMBOL<std::minus<>> = '-';
+    template <>
+    inline constexpr char SYMBOL<std::multiplies<>> = '*';
+    template <>
+    inline constexpr char SYMBOL<std::divides<>> = '/';
+
+    // Where a NaN came from, found on the error path only
+    struct Failure
+    {
+        NaNError    error;
+        std::string where;
+    };
+}    // namespace detail
+
+// A NotNaN operand, known to be a number
+template <std::floating_point T>
+class Leaf : public NodeBase
+{
+  private:
+    T m_value;
+
+  public:
+    using ValueType = T;
+
+    template <CheckPolicy Policy>
+    constexpr explicit Leaf(const NotNaN<T, Policy>& value) noexcept : m_value {*value}
+    {
+        // empty
+    }
+
+    [[nodiscard]]
+    constexpr auto value() const noexcept -> T
+    {
+        return m_value;
+    }
+
+    [[nodiscard]]
+    constexpr auto isBadOperand() const noexcept -> bool
+    {
+        return false;
+    }
+
+    [[nodiscard]]
+    auto describe() const -> std::string
+    {
+        return std::format("{}", m_value);
+    }
+
+    [[nodiscard]]
+    auto findFailure() const -> std::optional<detail::Failure>
+    {
+        return std::nullopt;
+    }
+};
+
+// A raw arithmetic operand, which may be NaN
+template <typename T>
+    requires std::is_arithmetic_v<T>
+class Scalar : public NodeBase
+{
+  private:
+    T m_value;
+
+  public:
+    using ValueType = T;
+
+    constexpr explicit Scalar(const T& value) noexcept : m_value {value}
+    {
+        // empty
+    }
+
+    [[nodiscard]]
+    constexpr auto value() const noexcept -> T
+    {
+        return m_value;
+    }
+
+    [[nodiscard]]
+    auto describe() const -> std::string
+    {
+        return std::format("{}", m_value);
+    }
+
+    [[nodiscard]]
+    constexpr auto isBadOperand() const noexcept -> bool
+    {
+        if constexpr (std::floating_point<T>)
+        {
+            return isNaN(m_value);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    [[nodiscard]]
+    auto findFailure() const -> std::optional<detail::Failure>
+    {
+        return std::nullopt;
+    }
+};
+
+template <Node L, Node R, typename BinaryOp>
+class Binary : public NodeBase
+{
+  private:
+    L m_lhs;
+    R m_rhs;
+
+  public:
+    using ValueType = std::common_type_t<typename L::ValueType, typename R::ValueType>;
+
+    constexpr Binary(const L& lhs, const R& rhs) noexcept : m_lhs {lhs}, m_rhs {rhs}
+    {
+        // empty
+    }
+
+    [[nodiscard]]
+    constexpr auto value() const noexcept -> ValueType
+    {
+        // no static_cast<ValueType>(lhs | rhs) to force compiler warnings on caller site for incompatible types
+        return BinaryOp {}(m_lhs.value(), m_rhs.value());
+    }
+
+    [[nodiscard]]
+    constexpr auto isBadOperand() const noexcept -> bool
+    {
+        return false;
+    }
+
+    [[nodiscard]]
+    auto describe() const -> std::string
+    {
+        return std::format("({} {} {})", m_lhs.describe(), detail::SYMBOL<BinaryOp>, m_rhs.describe());
+    }
+
+    // Operands are searched in evaluation order before the operation itself, so the innermost sub-expression
+    // that turned numbers into NaN is reported
+    [[nodiscard]]
+    auto findFailure() const -> std::optional<detail::Failure>
+    {
+        constexpr Operation OPERATION = notnan::detail::OPERATION_OF<BinaryOp>;
+        if (auto failure = m_lhs.findFailure())
+        {
+            return failure;
+        }
+        if (auto failure = m_rhs.findFailure())
+        {
+            return failure;
+        }
+        if (m_lhs.isBadOperand())
+        {
+            return detail::Failure {.error = {OPERATION, Operand::Lhs}, .where = m_lhs.describe()};
+        }
+        if (m_rhs.isBadOperand())
+        {
+            return detail::Failure {.error = {OPERATION, Operand::Rhs}, .where = m_rhs.describe()};
+        }
+        if (isNaN(value()))
+        {
+            return detail::Failure {.error = {OPERATION, Operand::Result}, .where = describe()};
+        }
+        return std::nullopt;
+    }
+
+    // Evaluates the whole expression with a single NaN check.
+    // There is no result to carry an error, so policies that return errors treat NaN like their constructor does.
+    template <std::floating_point F, CheckPolicy Policy>
+    [[nodiscard]]
+    constexpr operator NotNaN<F, Policy> () const
+    {
+        const ValueType result = value();
+        if constexpr (Policy::CHECKED)
+        {
+            if (isNaN(result)) [[unlikely]]
+            {
+                reportFailure<Policy>();
+            }
+        }
+        // no static_cast<F>(result) to force compiler warnings on caller site for incompatible types.
+        // Converting can't give NaN, so the checked value is wrapped without checking it again.
+        const F converted = result;
+        return notnan::detail::UncheckedAccess::make<NotNaN<F, Policy>>(converted);
+    }
+
+    template <CheckPolicy Policy = ThrowPolicy>
+    [[nodiscard]]
+    constexpr auto eval() const -> NotNaN<ValueType, Policy>
+    {
+        return *this;
+    }
+
+  private:
+    template <CheckPolicy Policy>
+    [[noreturn, gnu::cold, gnu::noinline]]
+    void reportFailure() const
+    {
+        const detail::Failure failure = *findFailure();
+        if constexpr (std::same_as<Policy, ThrowPolicy>)
+        {
+            if (failure.error.operand != Operand::Result)
+            {
+                throw std::invalid_argument(std::format("Operand {} is NaN in {}", failure.where, describe()));
+            }
+            throw std::runtime_error(std::format("Result of {} is NaN in {}", failure.where, describe()));
+        }
+        else
+        {
+            Policy::raise(failure.error);
+        }
+    }
+};
+
+namespace detail
+{
+    template <typename U>
+    [[nodiscard]]
+    constexpr auto toNode(const U& operand)
+    {
+        using V = std::remove_cvref_t<U>;
+        if constexpr (Node<V>)
+        {
+            return operand;
+        }
+        else if constexpr (IsNotNaN<V>)
+        {
+            return Leaf<typename V::Type> {operand};
+        }
+        else
+        {
+            return Scalar<V> {operand};
+        }
+    }
+
+    template <typename BinaryOp, typename L, typename R>
+    [[nodiscard]]
+    constexpr auto makeBinary(const L& lhs, const R& rhs)
+    {
+        using LN = decltype(toNode(lhs));
+        using RN = decltype(toNode(rhs));
+        return Binary<LN, RN, BinaryOp> {toNode(lhs), toNode(rhs)};
+    }
+}    // namespace detail
+
+// At least one side has to be an expression already, everything else stays eager
+template <Operand L, Operand R>
+    requires (Node<L> || Node<R>)
+[[nodiscard]]
+constexpr auto operator+ (const L& lhs, const R& rhs)
+{
+    return detail::makeBinary<std::plus<>>(lhs, rhs);
+}
+
+template <Operand L, Operand R>
+    requires (Node<L> || Node<R>)
+[[nodiscard]]
+constexpr auto operator- (const L& lhs, const R& rhs)
+{
+    return detail::makeBinary<std::minus<>>(lhs, rhs);
+}
+
+template <Operand L, Operand R>
+    requires (Node<L> || Node<R>)
+[[nodiscard]]
+constexpr auto operator* (const L& lhs, const R& rhs)
+{
+    return detail::makeBinary<std::multiplies<>>(lhs, rhs);
+}
+
+template <Operand L, Operand R>
+    requires (Node<L> || Node<R>)
+[[nodiscard]]
+constexpr auto operator/ (const L& lhs, const R& rhs)
+{
+    return detail::makeBinary<std::divides<>>(lhs, rhs);
+}
+}    // namespace notnan::expression
+
+namespace notnan
+{
+// Starts a lazily evaluated expression
+template <std::floating_point T, CheckPolicy Policy>
+[[nodiscard]]
+constexpr auto lazy(const NotNaN<T, Policy>& value) noexcept -> expression::Leaf<T>
+{
+    return expression::Leaf<T> {value};
+}
+}    // namespace notnan
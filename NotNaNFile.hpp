@@ -0,0 +1,673 @@
+#pragma once
+
+#include "NotNaN.hpp"
+#include "NotNaNAlgorithm.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Files of NotNaN values.
+//
+// The binary array format stores NotNaN values that were validated when written, so that the next stage of a
+// pipeline can map them back as NotNaN without checking every value again:
+//
+//   notnan::writeArray("grid.nnan", values);
+//   const notnan::MappedArray<double> grid {"grid.nnan"};            // O(1), the header is checked
+//   const std::span<const NotNaN<double>> view = grid.values();      // no copy
+//
+// A file is a 64 byte header followed by the raw values, 64 byte aligned. The header records the element type,
+// the count, the byte order of the writer and a checksum of the values. Files from untrusted sources can be opened
+// with Verification::Checksum or Verification::Full to check the values before they are handed out.
+//
+// Raw files that were never validated can be viewed with LazyNotNaNView, which validates each page on first access.
+namespace notnan
+{
+#if __has_include(<sys/mman.h>)
+// A whole file mapped read-only into memory, for parsing files larger than one would like to copy.
+// Throws std::system_error if the file can not be opened or mapped.
+class MappedFile
+{
+  private:
+    void*       m_data {nullptr};
+    std::size_t m_size {0};
+
+  public:
+    explicit MappedFile(const std::filesystem::path& path)
+    {
+        const int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);    // NOLINT(cppcoreguidelines-pro-type-vararg)
+        if (file < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), path.string());
+        }
+        struct stat status {};
+        if (::fstat(file, &status) != 0)
+        {
+            const int error = errno;
+            ::close(file);
+            throw std::system_error(error, std::generic_category(), path.string());
+        }
+        m_size = static_cast<std::size_t>(status.st_size);
+        if (m_size != 0)
+        {
+            m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+        }
+        const int error = errno;
+        ::close(file);
+        if (m_data == MAP_FAILED)
+        {
+            m_data = nullptr;
+            m_size = 0;
+            throw std::system_error(error, std::generic_category(), path.string());
+        }
+        if (m_data != nullptr)
+        {
+            ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+        }
+    }
+
+    MappedFile(const MappedFile&)                     = delete;
+    auto operator= (const MappedFile&) -> MappedFile& = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : m_data {std::exchange(other.m_data, nullptr)}, m_size {std::exchange(other.m_size, 0)}
+    {
+        // empty
+    }
+
+    auto operator= (MappedFile&& other) noexcept -> MappedFile&
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        return *this;
+    }
+
+    ~MappedFile()
+    {
+        if (m_data != nullptr)
+        {
+            ::munmap(m_data, m_size);
+        }
+    }
+
+    [[nodiscard]]
+    auto text() const noexcept -> std::string_view
+    {
+        return {static_cast<const char*>(m_data), m_size};
+    }
+
+    // The mapping is page aligned
+    [[nodiscard]]
+    auto bytes() const noexcept -> std::span<const std::byte>
+    {
+        return {static_cast<const std::byte*>(m_data), m_size};
+    }
+
+    // The whole file as raw values, for files of nothing but values.
+    // Throws std::invalid_argument if the size is not a multiple of sizeof(T).
+    template <std::floating_point T>
+    [[nodiscard]]
+    auto values() const -> std::span<const T>
+    {
+        if (m_size % sizeof(T) != 0) [[unlikely]]
+        {
+            throw std::invalid_argument(std::format("A file of {} bytes does not hold values of {} bytes", m_size, sizeof(T)));
+        }
+        // the mapping is page aligned, so aligned for T
+        return {static_cast<const T*>(m_data), m_size / sizeof(T)};
+    }
+};
+#endif
+
+// The element types of the binary array format. long double is left out, its layout differs between platforms.
+template <typename T>
+concept ArrayElement = (std::same_as<T, float> || std::same_as<T, double>) && std::numeric_limits<T>::is_iec559;
+
+// How much of a binary array file is checked when it is opened
+enum class Verification : std::uint8_t
+{
+    Header,      // only the header, O(1). The values are trusted to be the ones that were written.
+    Checksum,    // the header and the checksum of the values, catches truncated and corrupted files
+    Full,        // the header, the checksum and every value scanned for NaN, for files from untrusted sources
+};
+
+namespace detail
+{
+    constexpr std::array<char, 8> ARRAY_MAGIC {'N', 'O', 'T', 'N', 'A', 'N', 'A', 'R'};
+    constexpr std::uint32_t       ARRAY_VERSION = 1;
+    constexpr std::size_t         ARRAY_OFFSET  = 64;    // offset of the values, a cache line
+
+    enum class ArrayType : std::uint8_t
+    {
+        Float32 = 1,
+        Float64 = 2,
+    };
+
+    template <ArrayElement T>
+    constexpr ArrayType ARRAY_TYPE = std::same_as<T, float> ? ArrayType::Float32 : ArrayType::Float64;
+
+    // the byte order of the writer, one byte so that it can be read before knowing the byte order
+    constexpr std::uint8_t ARRAY_ENDIAN = std::endian::native == std::endian::little ? 1 : 2;
+
+    struct ArrayHeader
+    {
+        std::array<char, 8>          magic;
+        std::uint32_t                version;
+        std::uint8_t                 endian;
+        ArrayType                    type;
+        std::uint16_t                elementSize;
+        std::uint64_t                count;
+        std::uint64_t                offset;
+        std::uint64_t                checksum;
+        std::array<std::uint64_t, 3> reserved;
+    };
+
+    static_assert(sizeof(ArrayHeader) == ARRAY_OFFSET && std::is_trivially_copyable_v<ArrayHeader>);
+
+    // 64 bit checksum in the style of xxHash64: four independent lanes of 8 byte words, so that it runs at memory
+    // speed, then a final avalanche. Not compatible with xxHash64.
+    [[nodiscard]]
+    inline auto checksum(const std::span<const std::byte> bytes) noexcept -> std::uint64_t
+    {
+        constexpr std::uint64_t PRIME1 = 0x9E37'79B1'85EB'CA87;
+        constexpr std::uint64_t PRIME2 = 0xC2B2'AE3D'27D4'EB4F;
+        constexpr std::uint64_t PRIME3 = 0x1656'67B1'9E37'79F9;
+        constexpr std::size_t   WORD   = sizeof(std::uint64_t);
+        constexpr std::size_t   STRIPE = 4 * WORD;
+
+        const auto round = [](const std::uint64_t lane, const std::uint64_t word) noexcept
+        { return std::rotl(lane + (word * PRIME2), 31) * PRIME1; };
+        const auto load = [&bytes](const std::size_t idx) noexcept
+        {
+            std::uint64_t word = 0;
+            std::memcpy(&word, bytes.data() + idx, WORD);
+            return word;
+        };
+
+        std::array<std::uint64_t, 4> lanes {PRIME1 + PRIME2, PRIME2, 0, 0 - PRIME1};
+        std::size_t                  idx = 0;
+        for (; idx + STRIPE <= bytes.size(); idx += STRIPE)
+        {
+            for (std::size_t lane = 0; lane < lanes.size(); ++lane)
+            {
+                lanes[lane] = round(lanes[lane], load(idx + (lane * WORD)));
+            }
+        }
+
+        std::uint64_t hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12)
+                           + std::rotl(lanes[3], 18) + bytes.size();
+        for (; idx + WORD <= bytes.size(); idx += WORD)
+        {
+            hash = (std::rotl(hash ^ round(0, load(idx)), 27) * PRIME1) + PRIME3;
+        }
+        for (; idx < bytes.size(); ++idx)
+        {
+            hash = std::rotl(hash ^ (std::to_integer<std::uint64_t>(bytes[idx]) * PRIME3), 11) * PRIME1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= PRIME2;
+        hash ^= hash >> 29;
+        hash *= PRIME3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    [[noreturn, gnu::cold, gnu::noinline]]
+    inline void throwArrayError(const std::filesystem::path& path, const std::string_view what)
+    {
+        throw std::runtime_error(std::format("{}: {}", path.string(), what));
+    }
+}    // namespace detail
+
+// Writes values to path in the binary array format, replacing the file.
+// Throws std::runtime_error if the file can not be written.
+template <NotNaNRange R>
+    requires ArrayElement<typename RangeElement<R>::Type>
+void writeArray(const std::filesystem::path& path, const R& values)
+{
+    using T = RangeElement<R>::Type;
+
+    const std::span<const RangeElement<R>> view {detail::elements(values), std::ranges::size(values)};
+    const std::span<const std::byte>       bytes = std::as_bytes(view);
+
+    const detail::ArrayHeader header {
+      .magic       = detail::ARRAY_MAGIC,
+      .version     = detail::ARRAY_VERSION,
+      .endian      = detail::ARRAY_ENDIAN,
+      .type        = detail::ARRAY_TYPE<T>,
+      .elementSize = sizeof(T),
+      .count       = view.size(),
+      .offset      = detail::ARRAY_OFFSET,
+      .checksum    = detail::checksum(bytes),
+      .reserved    = {},
+    };
+
+    std::ofstream file {path, std::ios::binary | std::ios::trunc};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    file.close();
+    if (!file) [[unlikely]]
+    {
+        detail::throwArrayError(path, "can not be written");
+    }
+}
+
+#if __has_include(<sys/mman.h>)
+// A binary array file written by writeArray, mapped read-only and viewed as NotNaN without copying.
+// Throws std::system_error if the file can not be mapped, std::runtime_error if it is not an array of T written on a
+// machine of the same byte order, or fails the verification. A NaN found by Verification::Full is reported through
+// Policy, the default policy throws std::invalid_argument naming its index. Policies without checks skip that scan.
+template <ArrayElement T, CheckPolicy Policy = ThrowPolicy>
+class MappedArray
+{
+  private:
+    MappedFile  m_file;
+    std::size_t m_size {0};
+
+    [[nodiscard]]
+    auto raw() const noexcept -> const T*
+    {
+        return reinterpret_cast<const T*>(m_file.bytes().data() + detail::ARRAY_OFFSET);
+    }
+
+  public:
+    using value_type     = NotNaN<T, Policy>;
+    using const_iterator = std::span<const value_type>::iterator;
+
+    explicit MappedArray(const std::filesystem::path& path, const Verification verification = Verification::Header)
+        : m_file {path}
+    {
+        const std::span<const std::byte> bytes = m_file.bytes();
+        detail::ArrayHeader              header {};
+        if (bytes.size() < sizeof(header)) [[unlikely]]
+        {
+            detail::throwArrayError(path, "is not a NotNaN array file");
+        }
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (header.magic != detail::ARRAY_MAGIC) [[unlikely]]
+        {
+            detail::throwArrayError(path, "is not a NotNaN array file");
+        }
+        if (header.version != detail::ARRAY_VERSION) [[unlikely]]
+        {
+            detail::throwArrayError(path, "has an unsupported version");
+        }
+        if (header.endian != detail::ARRAY_ENDIAN) [[unlikely]]
+        {
+            detail::throwArrayError(path, "was written with a different byte order");
+        }
+        if (header.type != detail::ARRAY_TYPE<T> || header.elementSize != sizeof(T)) [[unlikely]]
+        {
+            detail::throwArrayError(path, "holds a different element type");
+        }
+        if (header.offset != detail::ARRAY_OFFSET || header.count != (bytes.size() - detail::ARRAY_OFFSET) / sizeof(T)
+            || (bytes.size() - detail::ARRAY_OFFSET) % sizeof(T) != 0) [[unlikely]]
+        {
+            detail::throwArrayError(path, "is truncated");
+        }
+        m_size = header.count;
+
+        if (verification != Verification::Header
+            && detail::checksum(bytes.subspan(detail::ARRAY_OFFSET)) != header.checksum) [[unlikely]]
+        {
+            detail::throwArrayError(path, "fails the checksum");
+        }
+        if (Policy::CHECKED && verification == Verification::Full)
+        {
+            const std::size_t idx = findNaN(std::span {raw(), m_size});
+            if (idx != m_size) [[unlikely]]
+            {
+                detail::raiseInvalidElement<Policy>(raw()[idx], idx);
+            }
+        }
+    }
+
+    [[nodiscard]]
+    auto values() const noexcept -> std::span<const value_type>
+    {
+        return {detail::notNaNData<Policy>(std::span {raw(), m_size}), m_size};
+    }
+
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t
+    {
+        return m_size;
+    }
+
+    [[nodiscard]]
+    auto empty() const noexcept -> bool
+    {
+        return m_size == 0;
+    }
+
+    [[nodiscard]]
+    auto operator[] (const std::size_t idx) const noexcept -> const value_type&
+    {
+        return values()[idx];
+    }
+
+    [[nodiscard]]
+    auto begin() const noexcept -> const_iterator
+    {
+        return values().begin();
+    }
+
+    [[nodiscard]]
+    auto end() const noexcept -> const_iterator
+    {
+        return values().end();
+    }
+};
+#endif
+namespace detail
+{
+    constexpr std::size_t LAZY_CHUNK_BYTES = 4096;    // one page
+}
+
+// A view of raw values, typically a mapped file, validated a chunk (one page) at a time on first access.
+// Creating the view is O(1) apart from a bitmap of one bit per chunk, so only the values that are actually used are
+// ever scanned. Validated chunks are recorded in the bitmap and handed out as NotNaN without further checks.
+// Accessing a chunk with a NaN reports it through Policy, the default policy throws std::invalid_argument naming the
+// index of the first NaN in it. Policies without checks scan nothing.
+//
+//   const notnan::MappedFile            file {"samples.f32"};
+//   const notnan::LazyNotNaNView<float> samples {file.values<float>()};
+//   const NotNaN<float>                 x = samples[123'456'789];    // validates one page
+//
+// The view does not own the values. It may be used from several threads, a chunk is then possibly scanned twice.
+template <std::floating_point T, CheckPolicy Policy = ThrowPolicy>
+class LazyNotNaNView
+{
+  public:
+    using value_type = NotNaN<T, Policy>;
+
+    // values per chunk
+    static constexpr std::size_t CHUNK = detail::LAZY_CHUNK_BYTES / sizeof(T);
+
+  private:
+    using Word                             = std::uint64_t;
+    static constexpr std::size_t WORD_BITS = std::numeric_limits<Word>::digits;
+
+    std::span<const T>                   m_values;
+    std::unique_ptr<std::atomic<Word>[]> m_validated;    // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+    [[nodiscard]]
+    auto isChunkValidated(const std::size_t chunk) const noexcept -> bool
+    {
+        return ((m_validated[chunk / WORD_BITS].load(std::memory_order_acquire) >> (chunk % WORD_BITS)) & 1U) != 0;
+    }
+
+    // Scans one chunk and records it as validated. Returns the index of its first NaN, or size() if there is none.
+    auto scanChunk(const std::size_t chunk) const noexcept -> std::size_t
+    {
+        const std::size_t first = chunk * CHUNK;
+        const std::size_t count = std::min(CHUNK, m_values.size() - first);
+        const std::size_t idx   = findNaN(m_values.subspan(first, count));
+        if (idx != count) [[unlikely]]
+        {
+            return first + idx;
+        }
+        m_validated[chunk / WORD_BITS].fetch_or(Word {1} << (chunk % WORD_BITS), std::memory_order_release);
+        return m_values.size();
+    }
+
+    // Under a policy without checks the values are trusted as they are and nothing is scanned
+    void validateChunk(const std::size_t chunk) const
+    {
+        if constexpr (Policy::CHECKED)
+        {
+            if (!isChunkValidated(chunk)) [[unlikely]]
+            {
+                const std::size_t idx = scanChunk(chunk);
+                if (idx != m_values.size()) [[unlikely]]
+                {
+                    detail::raiseInvalidElement<Policy>(m_values[idx], idx);
+                }
+            }
+        }
+    }
+
+    [[nodiscard]]
+    auto view(const std::size_t first, const std::size_t count) const noexcept -> std::span<const value_type>
+    {
+        return {detail::notNaNData<Policy>(m_values.subspan(first, count)), count};
+    }
+
+  public:
+    // Forward iterator validating each chunk when it gets there, for sequential scans
+    class Iterator
+    {
+      private:
+        const LazyNotNaNView* m_view {nullptr};
+        std::size_t           m_idx {0};
+        mutable std::size_t   m_validEnd {0};    // end of the chunk of m_idx once it is validated
+
+      public:
+        using value_type      = NotNaN<T, Policy>;
+        using difference_type = std::ptrdiff_t;
+        using reference       = const value_type&;
+
+        Iterator() = default;
+
+        Iterator(const LazyNotNaNView& view, const std::size_t idx) noexcept : m_view {&view}, m_idx {idx}
+        {
+            // empty
+        }
+
+        [[nodiscard]]
+        auto operator* () const -> reference
+        {
+            if (m_idx >= m_validEnd) [[unlikely]]
+            {
+                const std::size_t chunk = m_idx / CHUNK;
+                m_view->validateChunk(chunk);
+                m_validEnd = (chunk + 1) * CHUNK;
+            }
+            return *m_view->view(m_idx, 1).data();
+        }
+
+        auto operator++ () noexcept -> Iterator&
+        {
+            ++m_idx;
+            return *this;
+        }
+
+        auto operator++ (int) noexcept -> Iterator
+        {
+            Iterator copy = *this;
+            ++m_idx;
+            return copy;
+        }
+
+        [[nodiscard]]
+        auto operator== (const Iterator& other) const noexcept -> bool
+        {
+            return m_idx == other.m_idx;
+        }
+    };
+
+    // Validates the chunks of a range on background threads, in order, so that a sequential scan behind it finds
+    // them validated. Chunks with a NaN are left alone, the scan reports them when it gets there.
+    // Destroying it stops and joins the threads. The view must not be moved or destroyed before.
+    class Prefetch
+    {
+      private:
+        std::unique_ptr<std::atomic<std::size_t>> m_next;
+        std::vector<std::jthread>                 m_threads;
+
+      public:
+        Prefetch(const LazyNotNaNView& view, const std::size_t firstChunk, const std::size_t lastChunk, const unsigned threads)
+            : m_next {std::make_unique<std::atomic<std::size_t>>(firstChunk)}
+        {
+            if constexpr (!Policy::CHECKED)
+            {
+                return;
+            }
+            m_threads.reserve(threads);
+            for (unsigned thread = 0; thread < threads; ++thread)
+            {
+                m_threads.emplace_back(
+                  [&view, next = m_next.get(), lastChunk](const std::stop_token& stop)
+                  {
+                      for (std::size_t chunk = next->fetch_add(1); chunk < lastChunk && !stop.stop_requested();
+                           chunk             = next->fetch_add(1))
+                      {
+                          if (!view.isChunkValidated(chunk))
+                          {
+                              static_cast<void>(view.scanChunk(chunk));
+                          }
+                      }
+                  }
+                );
+            }
+        }
+
+        // Blocks until all chunks are scanned
+        void wait()
+        {
+            for (std::jthread& thread : m_threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+        }
+    };
+
+    using const_iterator = Iterator;
+
+    explicit LazyNotNaNView(const std::span<const T> values)
+        : m_values {values}, m_validated {std::make_unique<std::atomic<Word>[]>((chunks() + WORD_BITS - 1) / WORD_BITS)}
+    {
+        // empty
+    }
+
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t
+    {
+        return m_values.size();
+    }
+
+    [[nodiscard]]
+    auto empty() const noexcept -> bool
+    {
+        return m_values.empty();
+    }
+
+    [[nodiscard]]
+    auto chunks() const noexcept -> std::size_t
+    {
+        return (m_values.size() + CHUNK - 1) / CHUNK;
+    }
+
+    [[nodiscard]]
+    auto isValidated(const std::size_t idx) const noexcept -> bool
+    {
+        return isChunkValidated(idx / CHUNK);
+    }
+
+    // The number of chunks validated so far
+    [[nodiscard]]
+    auto validatedChunks() const noexcept -> std::size_t
+    {
+        std::size_t count = 0;
+        for (std::size_t word = 0; word < (chunks() + WORD_BITS - 1) / WORD_BITS; ++word)
+        {
+            count += static_cast<std::size_t>(std::popcount(m_validated[word].load(std::memory_order_relaxed)));
+        }
+        return count;
+    }
+
+    [[nodiscard]]
+    auto operator[] (const std::size_t idx) const -> const value_type&
+    {
+        validateChunk(idx / CHUNK);
+        return view(idx, 1).front();
+    }
+
+    // Throws std::out_of_range if idx is out of range
+    [[nodiscard]]
+    auto at(const std::size_t idx) const -> const value_type&
+    {
+        if (idx >= m_values.size()) [[unlikely]]
+        {
+            throw std::out_of_range(std::format("Index {} is out of range for size {}", idx, m_values.size()));
+        }
+        return (*this)[idx];
+    }
+
+    // The validated chunk holding idx, for inner loops without a check per value
+    [[nodiscard]]
+    auto chunk(const std::size_t idx) const -> std::span<const value_type>
+    {
+        const std::size_t chunk = idx / CHUNK;
+        validateChunk(chunk);
+        const std::size_t first = chunk * CHUNK;
+        return view(first, std::min(CHUNK, m_values.size() - first));
+    }
+
+    // Validates all chunks not validated yet and views all values
+    [[nodiscard]]
+    auto values() const -> std::span<const value_type>
+    {
+        for (std::size_t chunk = 0; chunk < chunks(); ++chunk)
+        {
+            validateChunk(chunk);
+        }
+        return view(0, m_values.size());
+    }
+
+    // Starts validating the values of [first, last) on threads background threads
+    [[nodiscard]]
+    auto prefetch(
+      const std::size_t first, const std::size_t last, const unsigned threads = std::max(1U, std::thread::hardware_concurrency())
+    ) const -> Prefetch
+    {
+        return Prefetch {*this, first / CHUNK, (std::min(last, m_values.size()) + CHUNK - 1) / CHUNK, threads};
+    }
+
+    [[nodiscard]]
+    auto prefetch() const -> Prefetch
+    {
+        return prefetch(0, m_values.size());
+    }
+
+    [[nodiscard]]
+    auto begin() const noexcept -> Iterator
+    {
+        return {*this, 0};
+    }
+
+    [[nodiscard]]
+    auto end() const noexcept -> Iterator
+    {
+        return {*this, m_values.size()};
+    }
+};
+}    // namespace notnan
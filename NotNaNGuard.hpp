@@ -0,0 +1,138 @@
+#pragma once
+
+#include "NotNaN.hpp"
+
+#include <cfenv>
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Checking whole blocks of arithmetic through the IEEE invalid flag.
+// Any operation that turns numbers into NaN (inf - inf, 0 * inf, 0 / 0, sqrt(-1), ...) raises FE_INVALID.
+// Inside a NaNGuardScope, NotNaN<T, notnan::HardwarePolicy> skips the per operation result check and the scope tests
+// the flag once when it ends. Tight loops then pay for a single flag test instead of a branch per operation.
+// notnan::guarded(function) runs function inside such a scope and returns its result.
+//
+//   const N total = notnan::guarded(
+//     [&]
+//     {
+//         N sum {0.0};
+//         for (...) { sum += x * y; }
+//         return sum;
+//     }
+//   );    // throws std::runtime_error here if any operation produced NaN
+//
+// Prefer guarded over a block with a NaNGuardScope. The compiler may move the operations of the block across the flag
+// test, guarded calls function out of line so all of them are done before the flag is tested.
+// Values assigned inside a scope that reported NaN may be NaN themselves and must be discarded. Declare them inside
+// the scope or the function like sum above, so they don't outlive the error.
+//
+// Raw arithmetic values given to a NotNaN are still checked on the spot, a quiet NaN passes through an operation
+// without raising the flag.
+// Outside of a NaNGuardScope results are checked after each operation like with ThrowPolicy.
+// The flag is per thread, so is the scope.
+// Results that are never used may be optimized away, NaN that nobody sees does not raise the flag either.
+// GCC and clang do not implement #pragma STDC FENV_ACCESS, don't build with -ffast-math or -fno-trapping-math.
+namespace notnan
+{
+namespace detail
+{
+    // How many scopes of the calling thread check results through the invalid flag (NaNGuardScope, trapInvalid)
+    inline thread_local int t_guardDepth = 0;
+}    // namespace detail
+
+// Like ThrowPolicy, but results of operations are checked by an enclosing NaNGuardScope
+struct HardwarePolicy : detail::RaisingPolicy<HardwarePolicy>
+{
+    static constexpr bool CHECKED               = true;
+    static constexpr bool DEFERRED_RESULT_CHECK = true;
+
+    // Whether a scope checks the results of this thread
+    [[nodiscard]]
+    static auto deferring() noexcept -> bool
+    {
+        return detail::t_guardDepth != 0;
+    }
+
+    [[noreturn, gnu::cold, gnu::noinline]]
+    static void raise(const NaNError error)
+    {
+        ThrowPolicy::raise(error);
+    }
+};
+
+// Clears FE_INVALID on construction and reports through Policy if it is set when the scope ends.
+// The flag state from before the scope is restored afterwards, so scopes can be nested.
+// Nothing is reported while unwinding from another exception. Where the destructor must not throw at all, call check()
+// as the last statement of the scope, the destructor has nothing left to report then.
+template <CheckPolicy Policy = ThrowPolicy>
+class NaNGuardScope
+{
+  private:
+    std::fexcept_t m_saved {};
+    int            m_uncaught;
+
+  public:
+    NaNGuardScope() noexcept : m_uncaught {std::uncaught_exceptions()}
+    {
+        std::fegetexceptflag(&m_saved, FE_INVALID);
+        std::feclearexcept(FE_INVALID);
+        ++detail::t_guardDepth;
+    }
+
+    NaNGuardScope(const NaNGuardScope&)                     = delete;
+    NaNGuardScope(NaNGuardScope&&)                          = delete;
+    auto operator= (const NaNGuardScope&) -> NaNGuardScope& = delete;
+    auto operator= (NaNGuardScope&&) -> NaNGuardScope&      = delete;
+
+    ~NaNGuardScope() noexcept(noexcept(Policy::raise(std::declval<NaNError>())))
+    {
+        --detail::t_guardDepth;
+        const bool failed = invalid();
+        std::fesetexceptflag(&m_saved, FE_INVALID);
+        // only when no exception started unwinding since the scope began, throwing then would terminate
+        if (failed && std::uncaught_exceptions() <= m_uncaught) [[unlikely]]
+        {
+            Policy::raise({Operation::Scope, Operand::Result});
+        }
+    }
+
+    // Whether any operation in the scope produced NaN so far
+    [[nodiscard]]
+    static auto invalid() noexcept -> bool
+    {
+        return std::fetestexcept(FE_INVALID) != 0;
+    }
+
+    // Reports early, e.g. at the end of each iteration, and starts over with a clear flag
+    void check() const
+    {
+        if (invalid()) [[unlikely]]
+        {
+            std::feclearexcept(FE_INVALID);
+            Policy::raise({Operation::Scope, Operand::Result});
+        }
+    }
+};
+
+namespace detail
+{
+    // Like invokeTrapped, an inlined function could still be computed after the flag test of the scope
+    template <typename Function>
+    [[gnu::noinline]]
+    auto invokeGuarded(Function& function) -> std::invoke_result_t<Function&>
+    {
+        return std::invoke(function);
+    }
+}    // namespace detail
+
+// Runs function inside a NaNGuardScope<Policy>, which reports when function returns
+template <CheckPolicy Policy = ThrowPolicy, typename Function>
+    requires std::invocable<Function&>
+auto guarded(Function&& function) -> std::invoke_result_t<Function&>
+{
+    const NaNGuardScope<Policy> scope;
+    return detail::invokeGuarded(function);
+}
+}    // namespace notnan
@@ -0,0 +1,471 @@
+#pragma once
+
+#include "NotNaN.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+// exp, log, sin and cos of whole spans of NotNaN, for bulk feature computations.
+// Each block of inputs is first checked against the domain of the function in one branch free pass: x >= 0 for log,
+// finite x for sin and cos, exp takes everything. Inputs in the domain can't give NaN, so the results are not
+// checked again. Under a policy without checks the domain is not checked either.
+//
+//   notnan::log(std::span<const NotNaN<double>> {prices}, std::span {logPrices});    // throws on a negative price
+//
+// Values outside the domain are reported through the policy, the spans are returned through its Result.
+//
+// The kernels are branch free polynomials in double, over lanes that the compiler vectorizes like the reductions of
+// NotNaNAlgorithm.hpp. They are used when the target has AVX2, elsewhere the std:: functions are called element by
+// element after the same check, as they are for long double. float and the 16 bit formats are computed in double and
+// rounded once. Measured against long double, the double kernels are within
+//
+//   exp  0.95 ulp, 1 ulp for subnormal results
+//   log  0.75 ulp
+//   sin  0.94 ulp, the worst case being the doubles closest to multiples of pi / 2
+//   cos  0.94 ulp
+//
+// and float rounded correctly in a sweep over every 997th float. sin and cos reduce |x| < 2^20 with a four part
+// pi / 2, larger arguments are rare and go to std::sin and std::cos. The bounds assume that each operation is rounded
+// to nearest on its own: don't change the rounding mode and don't build with -ffast-math, which would also fold away
+// the rounding constants. Contracting a * b + c into a fused multiply-add is switched off for the kernels.
+namespace notnan
+{
+namespace detail
+{
+    // values per vectorized group, one cache line of double
+    constexpr std::size_t MATH_LANES = 8;
+
+    // values per domain check, small enough to stay in L1 for the computation that follows
+    constexpr std::size_t MATH_BLOCK = 1024;
+
+    // The kernels only beat the std:: functions where GCC vectorizes them, which takes 64 bit vector compares and is
+    // worth it from AVX2 on
+#if defined(__AVX2__)
+    constexpr bool MATH_KERNELS = true;
+#else
+    constexpr bool MATH_KERNELS = false;
+#endif
+
+    template <typename T>
+    concept HasMathKernel = std::same_as<T, float> || std::same_as<T, double> || IsHalfPrecision<T>;
+
+    // Adding and subtracting 1.5 * 2^52 rounds to an integer. The integer is then also in the low bits of the sum.
+    constexpr double ROUNDING_SHIFT = 0x1.8p52;
+
+    constexpr double EXP_MIN   = -746.0;    // exp rounds to 0 below
+    constexpr double EXP_MAX   = 710.0;     // and to infinity above
+    constexpr double LN2_HIGH  = 0x1.62e42fee00000p-1;    // 32 bits, n * LN2_HIGH is exact
+    constexpr double LN2_LOW   = 0x1.a39ef35793c76p-33;
+    constexpr double EXPONENTS = 0x1p52;
+
+    // pi / 2 in four parts, the first three with at most 33 bits so that n * part is exact for n < 2^20
+    constexpr double PI_2_1    = 0x1.921fb54400000p0;
+    constexpr double PI_2_2    = 0x1.0b4611a600000p-34;
+    constexpr double PI_2_3    = 0x1.3198a2e000000p-69;
+    constexpr double PI_2_4    = 0x1.b839a252049c1p-104;
+    constexpr double TRIG_MAX  = 0x1p20;
+
+// The bounds above need every operation rounded on its own, whatever the code including this header is built with.
+// Contraction is switched off from here to computeKernel, which is where GCC inlines the kernels. GCC does not inline
+// computeKernel into callers built with other options, clang decides contraction per expression.
+#if defined(__clang__)
+#pragma float_control(push)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+    [[nodiscard, gnu::always_inline]]
+    inline auto roundToInteger(const double value) noexcept -> double
+    {
+        return (value + ROUNDING_SHIFT) - ROUNDING_SHIFT;
+    }
+
+    // coefficients[0] * x^n + ... + coefficients[n], unrolled so that the lane loops around it stay vectorizable
+    template <std::same_as<double>... Coefficients>
+    [[nodiscard, gnu::always_inline]]
+    inline auto horner(const double x, const double first, const Coefficients... coefficients) noexcept -> double
+    {
+        double result = first;
+        ((result = result * x + coefficients), ...);
+        return result;
+    }
+
+    // condition ? ifTrue : ifFalse with bit masks. GCC only vectorizes a choice between two doubles when it can also
+    // evaluate both sides, which it does not assume for floating point comparisons without -fno-trapping-math.
+    [[nodiscard, gnu::always_inline]]
+    inline auto select(const bool condition, const double ifTrue, const double ifFalse) noexcept -> double
+    {
+        const std::uint64_t mask = std::uint64_t {0} - std::uint64_t {condition};
+        return std::bit_cast<double>(
+          (std::bit_cast<std::uint64_t>(ifTrue) & mask) | (std::bit_cast<std::uint64_t>(ifFalse) & ~mask)
+        );
+    }
+
+    // 2^n for an integer n in [-1022, 1023], from the bits of n + 1023 in the low bits of the rounding sum
+    [[nodiscard, gnu::always_inline]]
+    inline auto powerOfTwo(const double n) noexcept -> double
+    {
+        return std::bit_cast<double>(std::bit_cast<std::uint64_t>(n + (ROUNDING_SHIFT + 1023.0)) << 52U);
+    }
+
+    // exp(x) = 2^n * exp(r), |r| <= ln 2 / 2, with the Taylor polynomial of exp(r) up to r^13.
+    // 2^n is applied in two halves, so that results down to the subnormals are rounded only once.
+    [[nodiscard, gnu::always_inline]]
+    inline auto expKernel(const double x) noexcept -> double
+    {
+        const double above   = select(x < EXP_MIN, EXP_MIN, x);
+        const double clamped = select(above > EXP_MAX, EXP_MAX, above);
+        const double n       = roundToInteger(clamped * std::numbers::log2e);
+        const double r       = (clamped - n * LN2_HIGH) - n * LN2_LOW;
+
+        const double polynomial = horner(
+          r, 1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0, 1.0 / 40320.0,
+          1.0 / 5040.0, 1.0 / 720.0, 1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5
+        );
+        const double expR = 1.0 + (r + r * r * polynomial);
+
+        const double half = roundToInteger(n * 0.5);
+        return expR * powerOfTwo(half) * powerOfTwo(n - half);
+    }
+
+    // log(x) = k * ln 2 + log(m), m in [sqrt(2) / 2, sqrt(2)), with log(m) = log(1 + f) = 2 atanh(s), s = f / (2 + f).
+    // The Taylor polynomial of atanh up to s^21 is arranged like fdlibm, so that f is added last.
+    [[nodiscard, gnu::always_inline]]
+    inline auto logKernel(const double x) noexcept -> double
+    {
+        constexpr std::uint64_t MANTISSA = (std::uint64_t {1} << 52U) - 1;
+        constexpr std::uint64_t ONE      = std::uint64_t {1023} << 52U;
+
+        const bool   subnormal = x < std::numeric_limits<double>::min();
+        const double scaled    = select(subnormal, x * 0x1p54, x);
+        const auto   bits      = std::bit_cast<std::uint64_t>(scaled);
+
+        // the exponent field as a double, without an integer conversion that not every vector unit has
+        const double exponent = std::bit_cast<double>((bits >> 52U) | std::bit_cast<std::uint64_t>(EXPONENTS))
+                                - (EXPONENTS + 1023.0);
+        const double mantissa = std::bit_cast<double>((bits & MANTISSA) | ONE);
+        const bool   large    = mantissa > std::numbers::sqrt2;
+        const double m        = select(large, mantissa * 0.5, mantissa);
+        const double k        = exponent + select(large, 1.0, 0.0) - select(subnormal, 54.0, 0.0);
+
+        const double f    = m - 1.0;
+        const double hfsq = 0.5 * f * f;
+        const double s    = f / (2.0 + f);
+        const double z    = s * s;
+
+        const double polynomial = horner(
+          z, 2.0 / 21.0, 2.0 / 19.0, 2.0 / 17.0, 2.0 / 15.0, 2.0 / 13.0, 2.0 / 11.0, 2.0 / 9.0, 2.0 / 7.0, 2.0 / 5.0,
+          2.0 / 3.0
+        );
+        const double result = k * LN2_HIGH - ((hfsq - (s * (hfsq + z * polynomial) + k * LN2_LOW)) - f);
+
+        const double special = select(x == 0.0, -std::numeric_limits<double>::infinity(), x);
+        return select((x == 0.0) | (x == std::numeric_limits<double>::infinity()), special, result);
+    }
+
+    // hi + lo = a + b exactly, for any a and b
+    [[nodiscard, gnu::always_inline]]
+    inline auto twoSum(const double a, const double b, double& low) noexcept -> double
+    {
+        const double high    = a + b;
+        const double partOfB = high - a;
+        low                  = (a - (high - partOfB)) + (b - partOfB);
+        return high;
+    }
+
+    // sin or cos of x = q * pi / 2 + r, |r| <= pi / 4, from the Taylor polynomials of sin(r) up to r^17 and of
+    // cos(r) up to r^18. For |x| < 2^20 the products q * part are exact, and r is kept in two doubles, y + tail,
+    // which the polynomials take in like fdlibm's __kernel_sin and __kernel_cos.
+    template <bool COSINE>
+    [[nodiscard, gnu::always_inline]]
+    inline auto trigKernel(const double x) noexcept -> double
+    {
+        const double shifted  = x * std::numbers::inv_pi * 2.0 + ROUNDING_SHIFT;
+        const double q        = shifted - ROUNDING_SHIFT;
+        const auto   quadrant = (std::bit_cast<std::uint64_t>(shifted) + (COSINE ? 1U : 0U)) & 3U;
+
+        double       lowOfFirst  = 0.0;
+        double       lowOfSecond = 0.0;
+        const double first       = twoSum(x - q * PI_2_1, -(q * PI_2_2), lowOfFirst);
+        const double second      = twoSum(first, -(q * PI_2_3 + q * PI_2_4), lowOfSecond);
+        const double y           = second + (lowOfFirst + lowOfSecond);
+        const double tail        = (lowOfFirst + lowOfSecond) - (y - second);
+        const double z           = y * y;
+
+        // y - y^3 / 6 + y^5 * sinePolynomial + tail * cos(y), with cos(y) ~ 1 - y^2 / 2
+        const double sinePolynomial = horner(
+          z, 1.0 / 355687428096000.0, -1.0 / 1307674368000.0, 1.0 / 6227020800.0, -1.0 / 39916800.0, 1.0 / 362880.0,
+          -1.0 / 5040.0, 1.0 / 120.0
+        );
+        const double sine = y - (((z * (0.5 * tail - y * z * sinePolynomial)) - tail) - y * z * (-1.0 / 6.0));
+
+        // 1 - y^2 / 2 + y^4 * cosinePolynomial - tail * sin(y), with the rounding of 1 - y^2 / 2 added back
+        const double cosinePolynomial = horner(
+          z, -1.0 / 6402373705728000.0, 1.0 / 20922789888000.0, -1.0 / 87178291200.0, 1.0 / 479001600.0,
+          -1.0 / 3628800.0, 1.0 / 40320.0, -1.0 / 720.0, 1.0 / 24.0
+        );
+        const double half   = 0.5 * z;
+        const double w      = 1.0 - half;
+        const double cosine = w + (((1.0 - w) - half) + (z * z * cosinePolynomial - y * tail));
+
+        // cos(x) = sin(x + pi / 2), so the cosine starts one quadrant later
+        const double value  = select((quadrant & 1U) != 0, cosine, sine);
+        const double result = std::bit_cast<double>(std::bit_cast<std::uint64_t>(value) ^ ((quadrant & 2U) << 62U));
+        return COSINE ? result : select(x == 0.0, x, result);    // sin(-0) is -0
+    }
+
+    struct ExpFunction
+    {
+        static constexpr Operation OPERATION = Operation::Exp;
+
+        template <std::floating_point T>
+        static auto outsideDomain(const T /* x */) noexcept -> bool
+        {
+            return false;
+        }
+
+        [[gnu::always_inline]]
+        static auto kernel(const double x) noexcept -> double
+        {
+            return expKernel(x);
+        }
+
+        template <std::floating_point T>
+        static auto fallback(const T x) noexcept -> T
+        {
+            return std::exp(x);
+        }
+
+        static auto needsFallback(const double /* x */) noexcept -> bool
+        {
+            return false;
+        }
+    };
+
+    struct LogFunction
+    {
+        static constexpr Operation OPERATION = Operation::Log;
+
+        template <std::floating_point T>
+        static auto outsideDomain(const T x) noexcept -> bool
+        {
+            return x < T {0};
+        }
+
+        [[gnu::always_inline]]
+        static auto kernel(const double x) noexcept -> double
+        {
+            return logKernel(x);
+        }
+
+        template <std::floating_point T>
+        static auto fallback(const T x) noexcept -> T
+        {
+            return std::log(x);
+        }
+
+        static auto needsFallback(const double /* x */) noexcept -> bool
+        {
+            return false;
+        }
+    };
+
+    template <bool COSINE>
+    struct TrigFunction
+    {
+        static constexpr Operation OPERATION = COSINE ? Operation::Cos : Operation::Sin;
+
+        template <std::floating_point T>
+        static auto outsideDomain(const T x) noexcept -> bool
+        {
+            return x - x != T {0};    // inf - inf is NaN
+        }
+
+        [[gnu::always_inline]]
+        static auto kernel(const double x) noexcept -> double
+        {
+            return trigKernel<COSINE>(x);
+        }
+
+        template <std::floating_point T>
+        static auto fallback(const T x) noexcept -> T
+        {
+            return COSINE ? std::cos(x) : std::sin(x);
+        }
+
+        static auto needsFallback(const double x) noexcept -> bool
+        {
+            return !(std::abs(x) < TRIG_MAX);
+        }
+    };
+
+    template <std::floating_point T>
+    [[noreturn, gnu::cold, gnu::noinline]]
+    void throwDomainError(const Operation operation, const T value, const std::size_t idx)
+    {
+        throw std::invalid_argument(std::format(
+          "{} of {} at index {} is NaN", toString(operation), static_cast<FormatType<T>>(value), idx
+        ));
+    }
+
+    // Reports the value outside the domain found at idx through Policy, like the math members report a NaN result.
+    // The default policy names the value and its index.
+    template <typename R, CheckPolicy Policy, std::floating_point T>
+    [[gnu::cold, gnu::noinline]]
+    auto domainFailure(const Operation operation, const T value, const std::size_t idx) -> typename Policy::template Result<R>
+    {
+        if constexpr (std::same_as<Policy, ThrowPolicy>)
+        {
+            throwDomainError(operation, value, idx);
+        }
+        else
+        {
+            return Policy::template failure<R>({operation, Operand::Result});
+        }
+    }
+
+    // Checks in[0, count) against the domain of Function in one pass without branches. The flags are collected in an
+    // integer, GCC does not vectorize an or of comparisons into a bool. Returns the index of the first value outside the
+    // domain, or count if there is none.
+    template <typename Function, std::floating_point T>
+    [[nodiscard]]
+    auto findOutsideDomain(const T* const in, const std::size_t count) noexcept -> std::size_t
+    {
+        std::size_t outside = 0;
+        for (std::size_t idx = 0; idx < count; ++idx)
+        {
+            outside |= Function::outsideDomain(in[idx]) ? 1U : 0U;
+        }
+        if (outside != 0) [[unlikely]]
+        {
+            return static_cast<std::size_t>(std::find_if(in, in + count, [](const T x) { return Function::outsideDomain(x); }) - in);
+        }
+        return count;
+    }
+
+    // out[i] = Function(in[i]) for i in [0, count). The lanes are computed into a local array, which keeps the
+    // vectorized part independent of whether in and out overlap. Lanes the kernel does not cover are redone after.
+    template <typename Function, HasMathKernel T>
+    void computeKernel(const T* const in, T* const out, const std::size_t count) noexcept
+    {
+        std::size_t idx = 0;
+        for (; idx + MATH_LANES <= count; idx += MATH_LANES)
+        {
+            std::array<double, MATH_LANES> lanes;    // NOLINT(cppcoreguidelines-pro-type-member-init)
+            std::size_t                    fallback = 0;
+            for (std::size_t lane = 0; lane < MATH_LANES; ++lane)
+            {
+                const auto x = static_cast<double>(in[idx + lane]);
+                lanes[lane]  = Function::kernel(x);
+                fallback |= Function::needsFallback(x) ? 1U : 0U;
+            }
+            if (fallback != 0) [[unlikely]]
+            {
+                for (std::size_t lane = 0; lane < MATH_LANES; ++lane)
+                {
+                    const auto x = static_cast<double>(in[idx + lane]);
+                    lanes[lane]  = Function::needsFallback(x) ? Function::fallback(x) : lanes[lane];
+                }
+            }
+            for (std::size_t lane = 0; lane < MATH_LANES; ++lane)
+            {
+                out[idx + lane] = static_cast<T>(lanes[lane]);
+            }
+        }
+        for (; idx < count; ++idx)
+        {
+            const auto x = static_cast<double>(in[idx]);
+            out[idx]     = static_cast<T>(Function::needsFallback(x) ? Function::fallback(x) : Function::kernel(x));
+        }
+    }
+
+#if defined(__clang__)
+#pragma float_control(pop)
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+    template <typename Function, std::floating_point T, CheckPolicy Policy>
+    auto applyMath(const std::span<const NotNaN<T, Policy>> values, const std::span<NotNaN<T, Policy>> results)
+      -> typename Policy::template Result<std::span<NotNaN<T, Policy>>>
+    {
+        using R = std::span<NotNaN<T, Policy>>;
+        checkSizes(values.size(), results.size());
+
+        const T* const in  = rawData(values);
+        T* const       out = rawData(results);
+        for (std::size_t offset = 0; offset < values.size(); offset += MATH_BLOCK)
+        {
+            const std::size_t count = std::min(MATH_BLOCK, values.size() - offset);
+            if constexpr (Policy::CHECKED)
+            {
+                const std::size_t idx = findOutsideDomain<Function>(in + offset, count);
+                if (idx != count) [[unlikely]]
+                {
+                    return domainFailure<R, Policy>(Function::OPERATION, in[offset + idx], offset + idx);
+                }
+            }
+            if constexpr (MATH_KERNELS && HasMathKernel<T>)
+            {
+                computeKernel<Function>(in + offset, out + offset, count);
+            }
+            else
+            {
+                for (std::size_t idx = offset; idx < offset + count; ++idx)
+                {
+                    out[idx] = Function::fallback(in[idx]);
+                }
+            }
+        }
+        return Policy::template success<R>(results);
+    }
+}    // namespace detail
+
+// results[i] = exp(values[i]), returns results through Policy's Result. Never fails apart from a size mismatch,
+// which throws std::invalid_argument. values and results may be the same span.
+template <std::floating_point T, CheckPolicy Policy>
+auto exp(const std::span<const NotNaN<T, Policy>> values, const std::span<NotNaN<T, Policy>> results)
+  -> typename Policy::template Result<std::span<NotNaN<T, Policy>>>
+{
+    return detail::applyMath<detail::ExpFunction>(values, results);
+}
+
+// results[i] = log(values[i]), log(0) is -inf. The first negative value is reported through Policy like a NaN result of
+// NotNaN::log, the default policy throws std::invalid_argument naming it and its index. The blocks of results before
+// that index are written already. Throws std::invalid_argument on a size mismatch.
+template <std::floating_point T, CheckPolicy Policy>
+auto log(const std::span<const NotNaN<T, Policy>> values, const std::span<NotNaN<T, Policy>> results)
+  -> typename Policy::template Result<std::span<NotNaN<T, Policy>>>
+{
+    return detail::applyMath<detail::LogFunction>(values, results);
+}
+
+// results[i] = sin(values[i]). The first infinite value is reported like a negative one of log.
+template <std::floating_point T, CheckPolicy Policy>
+auto sin(const std::span<const NotNaN<T, Policy>> values, const std::span<NotNaN<T, Policy>> results)
+  -> typename Policy::template Result<std::span<NotNaN<T, Policy>>>
+{
+    return detail::applyMath<detail::TrigFunction<false>>(values, results);
+}
+
+// results[i] = cos(values[i]). The first infinite value is reported like a negative one of log.
+template <std::floating_point T, CheckPolicy Policy>
+auto cos(const std::span<const NotNaN<T, Policy>> values, const std::span<NotNaN<T, Policy>> results)
+  -> typename Policy::template Result<std::span<NotNaN<T, Policy>>>
+{
+    return detail::applyMath<detail::TrigFunction<true>>(values, results);
+}
+}    // namespace notnan
@@ -0,0 +1,432 @@
+#pragma once
+
+#include "NotNaN.hpp"
+#include "NotNaNAlgorithm.hpp"
+#include "NotNaNFile.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <execution>
+#include <expected>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Bulk parsing of delimited text (CSV, TSV, ...) into NotNaN values with std::from_chars.
+// No streams and no locale, every field is a number in the C locale format. NaN fields are reported through the
+// policy, so a NaN never makes it into the result. ThrowPolicy throws ParseError with the position of the field.
+// Text that is not a number and rows with the wrong number of fields throw ParseError under every policy.
+//
+//   const auto values  = notnan::parse<double>(text);                          // all fields, row by row
+//   const auto columns = notnan::parseColumns<double>(std::execution::par, text, {.delimiter = '\t'});
+//
+// The overloads taking an execution policy cut the text into chunks of whole lines parsed in parallel.
+namespace notnan
+{
+struct ParseOptions
+{
+    char delimiter = ',';
+    bool header    = false;    // skip the first line
+};
+
+// One vector per column
+template <std::floating_point T, CheckPolicy Policy = ThrowPolicy>
+using Columns = std::vector<std::vector<NotNaN<T, Policy>>>;
+
+// A field that is not a number, a row with the wrong number of fields, or NaN under ThrowPolicy.
+// Lines and columns count from 1.
+class ParseError : public std::invalid_argument
+{
+  private:
+    std::size_t m_line;
+    std::size_t m_column;
+
+  public:
+    ParseError(const std::string_view problem, const std::size_t line, const std::size_t column)
+        : std::invalid_argument {std::format("{} at line {}, column {}", problem, line, column)}, m_line {line},
+          m_column {column}
+    {
+        // empty
+    }
+
+    [[nodiscard]]
+    auto line() const noexcept -> std::size_t
+    {
+        return m_line;
+    }
+
+    [[nodiscard]]
+    auto column() const noexcept -> std::size_t
+    {
+        return m_column;
+    }
+};
+
+namespace detail
+{
+    // bytes per parallel chunk, rounded up to the next end of line
+    constexpr std::size_t PARSE_CHUNK = std::size_t {1} << 20;
+
+    enum class ParseProblem : std::uint8_t
+    {
+        None,
+        Invalid,
+        OutOfRange,
+        NaN,
+        FieldCount,
+    };
+
+    // Where parsing stopped, line is counted from the start of the parsed piece of text
+    struct ParseFailure
+    {
+        ParseProblem     problem;
+        std::size_t      line;
+        std::size_t      column;
+        std::string_view field;
+        std::size_t      fields;    // the expected number of fields for FieldCount
+    };
+
+    [[nodiscard]]
+    constexpr auto trim(std::string_view field) noexcept -> std::string_view
+    {
+        while (!field.empty() && (field.front() == ' ' || field.front() == '\t'))
+        {
+            field.remove_prefix(1);
+        }
+        while (!field.empty() && (field.back() == ' ' || field.back() == '\t'))
+        {
+            field.remove_suffix(1);
+        }
+        return field;
+    }
+
+    // Takes the next line off text, without its line break
+    [[nodiscard]]
+    constexpr auto nextRow(std::string_view& text) noexcept -> std::string_view
+    {
+        const std::size_t newline = text.find('\n');
+        std::string_view  row     = text.substr(0, newline);
+        text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+        if (!row.empty() && row.back() == '\r')
+        {
+            row.remove_suffix(1);
+        }
+        return row;
+    }
+
+    // from_chars takes neither surrounding blanks nor a leading '+', both are accepted here
+    template <std::floating_point T>
+    [[nodiscard]]
+    auto parseField(std::string_view field, T& value) noexcept -> ParseProblem
+    {
+        field = trim(field);
+        if (field.size() > 1 && field.front() == '+' && field[1] != '+' && field[1] != '-')
+        {
+            field.remove_prefix(1);
+        }
+        const char* const last     = field.data() + field.size();
+        const auto [end, errorCode] = std::from_chars(field.data(), last, value);
+        if (errorCode == std::errc::result_out_of_range) [[unlikely]]
+        {
+            return ParseProblem::OutOfRange;
+        }
+        if (errorCode != std::errc {} || end != last) [[unlikely]]
+        {
+            return ParseProblem::Invalid;
+        }
+        if (isNaN(value)) [[unlikely]]
+        {
+            return ParseProblem::NaN;
+        }
+        return ParseProblem::None;
+    }
+
+    // Calls sink(column, value) for every field of text, column counting from 0.
+    // fields is the number of fields every row must have, 0 for any number. Blank lines are skipped.
+    template <std::floating_point T, typename Sink>
+    [[nodiscard]]
+    auto parseLines(std::string_view text, const char delimiter, const std::size_t fields, const Sink& sink)
+      -> std::optional<ParseFailure>
+    {
+        for (std::size_t line = 1; !text.empty(); ++line)
+        {
+            std::string_view row = nextRow(text);
+            if (trim(row).empty())
+            {
+                continue;
+            }
+
+            std::size_t column = 0;
+            for (bool more = true; more; ++column)
+            {
+                const std::size_t      end   = row.find(delimiter);
+                const std::string_view field = row.substr(0, end);
+                more                         = end != std::string_view::npos;
+                if (more)
+                {
+                    row.remove_prefix(end + 1);
+                }
+
+                if (fields != 0 && column == fields) [[unlikely]]
+                {
+                    return ParseFailure {ParseProblem::FieldCount, line, column + 1, field, fields};
+                }
+                T                  value {};
+                const ParseProblem problem = parseField(field, value);
+                if (problem != ParseProblem::None) [[unlikely]]
+                {
+                    return ParseFailure {problem, line, column + 1, trim(field), fields};
+                }
+                sink(column, value);
+            }
+            if (fields != 0 && column != fields) [[unlikely]]
+            {
+                return ParseFailure {ParseProblem::FieldCount, line, column + 1, {}, fields};
+            }
+        }
+        return std::nullopt;
+    }
+
+    [[noreturn, gnu::cold, gnu::noinline]]
+    inline void throwParseError(const ParseFailure& failure, const std::size_t lineOffset)
+    {
+        const std::size_t line = lineOffset + failure.line;
+        switch (failure.problem)
+        {
+            case ParseProblem::Invalid:
+                throw ParseError {std::format("Invalid number '{}'", failure.field), line, failure.column};
+            case ParseProblem::OutOfRange:
+                throw ParseError {std::format("Number '{}' out of range", failure.field), line, failure.column};
+            case ParseProblem::NaN:
+                throw ParseError {std::format("NaN '{}'", failure.field), line, failure.column};
+            case ParseProblem::FieldCount:
+                throw ParseError {std::format("Expected {} fields", failure.fields), line, failure.column};
+            case ParseProblem::None:
+                break;
+        }
+        throw std::logic_error("Parse failure without a problem");
+    }
+
+    // NaN fields are reported through Policy, ThrowPolicy gets a ParseError with the position. Everything else is no
+    // NaN, but text that can't be parsed, and throws ParseError under every policy.
+    template <typename R, CheckPolicy Policy>
+    [[gnu::cold, gnu::noinline]]
+    auto parseFailure(const ParseFailure& failure, const std::size_t lineOffset) -> typename Policy::template Result<R>
+    {
+        if constexpr (!std::same_as<Policy, ThrowPolicy>)
+        {
+            if (failure.problem == ParseProblem::NaN)
+            {
+                return Policy::template failure<R>({Operation::Construct, Operand::Value});
+            }
+        }
+        throwParseError(failure, lineOffset);
+    }
+
+    // The text after the header line, and the number of lines dropped
+    [[nodiscard]]
+    constexpr auto skipHeader(const std::string_view text, const ParseOptions& options) noexcept
+      -> std::pair<std::string_view, std::size_t>
+    {
+        if (!options.header)
+        {
+            return {text, 0};
+        }
+        const std::size_t newline = text.find('\n');
+        return {newline == std::string_view::npos ? std::string_view {} : text.substr(newline + 1), 1};
+    }
+
+    // The number of fields in the first row that is not blank
+    [[nodiscard]]
+    constexpr auto countFields(std::string_view text, const char delimiter) noexcept -> std::size_t
+    {
+        while (!text.empty())
+        {
+            const std::string_view row = nextRow(text);
+            if (!trim(row).empty())
+            {
+                return static_cast<std::size_t>(std::ranges::count(row, delimiter)) + 1;
+            }
+        }
+        return 0;
+    }
+
+    // text cut into pieces of whole lines of about PARSE_CHUNK bytes
+    [[nodiscard]]
+    inline auto splitLines(std::string_view text) -> std::vector<std::string_view>
+    {
+        std::vector<std::string_view> chunks;
+        while (!text.empty())
+        {
+            const std::size_t newline = text.size() <= PARSE_CHUNK ? std::string_view::npos : text.find('\n', PARSE_CHUNK);
+            const std::size_t size    = newline == std::string_view::npos ? text.size() : newline + 1;
+            chunks.push_back(text.substr(0, size));
+            text.remove_prefix(size);
+        }
+        return chunks;
+    }
+
+    template <std::floating_point T, CheckPolicy Policy>
+    struct ParsedChunk
+    {
+        std::string_view            text;
+        Columns<T, Policy>          columns;
+        std::optional<ParseFailure> failure;
+        std::exception_ptr          exception;
+    };
+
+    // Parses the chunks of text under policy into width columns, fields is passed on to parseLines.
+    // Failures are kept per chunk and the first one in text order is returned, with its line counted from the start
+    // of text. Exceptions are rethrown on the calling thread.
+    template <std::floating_point T, CheckPolicy Policy>
+    [[nodiscard]]
+    auto parseChunks(
+      const ExecutionPolicy auto& policy, const std::string_view text, const char delimiter, const std::size_t width,
+      const std::size_t fields
+    ) -> std::expected<Columns<T, Policy>, ParseFailure>
+    {
+        std::vector<ParsedChunk<T, Policy>> chunks;
+        for (const std::string_view chunk : splitLines(text))
+        {
+            chunks.push_back({.text = chunk, .columns = Columns<T, Policy>(width), .failure = {}, .exception = {}});
+        }
+
+        const auto chunkPolicy = synchronizingPolicy(policy);
+        std::for_each(
+          chunkPolicy, chunks.begin(), chunks.end(),
+          [delimiter, fields](ParsedChunk<T, Policy>& chunk) noexcept
+          {
+              try
+              {
+                  chunk.failure = parseLines<T>(
+                    chunk.text, delimiter, fields,
+                    [&chunk, fields](const std::size_t column, const T value)
+                    {
+                        chunk.columns[fields == 0 ? 0 : column].emplace_back(
+                          UncheckedAccess::make<NotNaN<T, Policy>>(value)
+                        );
+                    }
+                  );
+              }
+              catch (...)
+              {
+                  chunk.exception = std::current_exception();
+              }
+          }
+        );
+
+        Columns<T, Policy> result(width);
+        for (const ParsedChunk<T, Policy>& chunk : chunks)
+        {
+            if (chunk.exception) [[unlikely]]
+            {
+                std::rethrow_exception(chunk.exception);
+            }
+            if (chunk.failure) [[unlikely]]
+            {
+                const auto   before  = std::ranges::count(text.substr(0, chunk.text.data() - text.data()), '\n');
+                ParseFailure failure = *chunk.failure;
+                failure.line += static_cast<std::size_t>(before);
+                return std::unexpected(failure);
+            }
+        }
+        for (std::size_t column = 0; column < width; ++column)
+        {
+            std::size_t size = 0;
+            for (const ParsedChunk<T, Policy>& chunk : chunks)
+            {
+                size += chunk.columns[column].size();
+            }
+            result[column].reserve(size);
+            for (const ParsedChunk<T, Policy>& chunk : chunks)
+            {
+                result[column].insert(result[column].end(), chunk.columns[column].begin(), chunk.columns[column].end());
+            }
+        }
+        return result;
+    }
+}    // namespace detail
+
+// All fields of text row by row, rows may have any number of fields
+template <std::floating_point T, CheckPolicy Policy = ThrowPolicy>
+[[nodiscard]]
+auto parse(const std::string_view text, const ParseOptions& options = {})
+  -> typename Policy::template Result<std::vector<NotNaN<T, Policy>>>
+{
+    using R                       = std::vector<NotNaN<T, Policy>>;
+    const auto [body, lineOffset] = detail::skipHeader(text, options);
+    R          values;
+    const auto failure = detail::parseLines<T>(
+      body, options.delimiter, 0,
+      [&values](const std::size_t /* column */, const T value)
+      { values.emplace_back(detail::UncheckedAccess::make<NotNaN<T, Policy>>(value)); }
+    );
+    if (failure) [[unlikely]]
+    {
+        return detail::parseFailure<R, Policy>(*failure, lineOffset);
+    }
+    return Policy::template success<R>(std::move(values));
+}
+
+template <std::floating_point T, CheckPolicy Policy = ThrowPolicy>
+[[nodiscard]]
+auto parse(detail::ExecutionPolicy auto&& policy, const std::string_view text, const ParseOptions& options = {})
+  -> typename Policy::template Result<std::vector<NotNaN<T, Policy>>>
+{
+    using R                       = std::vector<NotNaN<T, Policy>>;
+    const auto [body, lineOffset] = detail::skipHeader(text, options);
+    auto columns                  = detail::parseChunks<T, Policy>(policy, body, options.delimiter, 1, 0);
+    if (!columns) [[unlikely]]
+    {
+        return detail::parseFailure<R, Policy>(columns.error(), lineOffset);
+    }
+    return Policy::template success<R>(std::move(columns->front()));
+}
+
+// One vector per column, every row must have as many fields as the first one
+template <std::floating_point T, CheckPolicy Policy = ThrowPolicy>
+[[nodiscard]]
+auto parseColumns(const std::string_view text, const ParseOptions& options = {})
+  -> typename Policy::template Result<Columns<T, Policy>>
+{
+    using R                       = Columns<T, Policy>;
+    const auto [body, lineOffset] = detail::skipHeader(text, options);
+    const std::size_t width       = detail::countFields(body, options.delimiter);
+    R                 columns(width);
+    const auto        failure = detail::parseLines<T>(
+      body, options.delimiter, width,
+      [&columns](const std::size_t column, const T value)
+      { columns[column].emplace_back(detail::UncheckedAccess::make<NotNaN<T, Policy>>(value)); }
+    );
+    if (failure) [[unlikely]]
+    {
+        return detail::parseFailure<R, Policy>(*failure, lineOffset);
+    }
+    return Policy::template success<R>(std::move(columns));
+}
+
+template <std::floating_point T, CheckPolicy Policy = ThrowPolicy>
+[[nodiscard]]
+auto parseColumns(
+  detail::ExecutionPolicy auto&& policy, const std::string_view text, const ParseOptions& options = {}
+) -> typename Policy::template Result<Columns<T, Policy>>
+{
+    using R                       = Columns<T, Policy>;
+    const auto [body, lineOffset] = detail::skipHeader(text, options);
+    const std::size_t width       = detail::countFields(body, options.delimiter);
+    auto              columns     = detail::parseChunks<T, Policy>(policy, body, options.delimiter, width, width);
+    if (!columns) [[unlikely]]
+    {
+        return detail::parseFailure<R, Policy>(columns.error(), lineOffset);
+    }
+    return Policy::template success<R>(std::move(*columns));
+}
+
+}    // namespace notnan
@@ -0,0 +1,620 @@
+#pragma once
+
+#include "NotNaN.hpp"
+
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <expected>
+#include <format>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Refinement types: NotNaN that also knows a bit more about its values.
+// Most operations can only produce NaN from particular operands (inf - inf, 0 * inf, 0 / 0, inf / inf, sqrt(-1)).
+// When the refinements of both operands rule those out, the result is not checked at all, e.g.
+// Finite * Finite, NonNegative + NonNegative or sqrt of NonNegative.
+// Every operation returns the tightest refinement it can prove for its result, or plain NotNaN if it can't prove any.
+// Only operations that can still produce NaN check their result, like NotNaN does for all of them.
+//
+//   notnan::UnitInterval<double> w {0.25};
+//   notnan::Finite<double>       a {1.0}, b {3.0};
+//   NotNaN<double>               r = w * a + (notnan::UnitInterval<double> {1.0} - w) * b;    // no checks
+//
+// Values are range checked once, when they are constructed or a refinement is narrowed explicitly.
+namespace notnan
+{
+// What a refined type knows about its values, besides not being NaN
+using Refinements = unsigned;
+
+namespace refinement
+{
+    inline constexpr Refinements FINITE       = 1U << 0U;    // neither inf nor -inf
+    inline constexpr Refinements NON_NEGATIVE = 1U << 1U;    // >= 0, which includes -0.0
+    inline constexpr Refinements POSITIVE     = 1U << 2U;    // > 0, implies NON_NEGATIVE
+    inline constexpr Refinements UNIT_BOUNDED = 1U << 3U;    // in [-1, 1], implies FINITE
+}    // namespace refinement
+
+template <std::floating_point T, Refinements R, CheckPolicy Policy = ThrowPolicy>
+class Refined;
+
+namespace detail
+{
+    [[nodiscard]]
+    constexpr auto has(const Refinements refinements, const Refinements flags) noexcept -> bool
+    {
+        return (refinements & flags) == flags;
+    }
+
+    // Adds the refinements implied by others, so that every set of facts is spelled by exactly one type
+    [[nodiscard]]
+    constexpr auto closure(Refinements refinements) noexcept -> Refinements
+    {
+        if (has(refinements, refinement::POSITIVE))
+        {
+            refinements |= refinement::NON_NEGATIVE;
+        }
+        if (has(refinements, refinement::UNIT_BOUNDED))
+        {
+            refinements |= refinement::FINITE;
+        }
+        return refinements;
+    }
+
+    // The values an operand may hold that can turn an operation into NaN
+    [[nodiscard]]
+    constexpr auto mayBeInfinity(const Refinements refinements) noexcept -> bool
+    {
+        return !has(refinements, refinement::FINITE);
+    }
+
+    [[nodiscard]]
+    constexpr auto mayBeMinusInfinity(const Refinements refinements) noexcept -> bool
+    {
+        return mayBeInfinity(refinements) && !has(refinements, refinement::NON_NEGATIVE);
+    }
+
+    [[nodiscard]]
+    constexpr auto mayBeZero(const Refinements refinements) noexcept -> bool
+    {
+        return !has(refinements, refinement::POSITIVE);
+    }
+
+    // What is known about a result, and whether the operands can still produce NaN
+    struct Propagation
+    {
+        Refinements refinements;
+        bool        check;
+    };
+
+    [[nodiscard]]
+    constexpr auto onlyIf(const bool condition, const Refinements refinements) noexcept -> Refinements
+    {
+        return condition ? refinements : Refinements {0};
+    }
+
+    // The refinements of the results of + - * / and the math members, derived from the IEEE 754 special cases.
+    // They have to hold after rounding: products and quotients of positive values may underflow to 0,
+    // sums and products of finite values may overflow to inf.
+    [[nodiscard]]
+    constexpr auto propagate(const Operation operation, const Refinements lhs, const Refinements rhs = 0) noexcept
+      -> Propagation
+    {
+        using namespace refinement;
+
+        const bool nonNegative = has(lhs, NON_NEGATIVE) && has(rhs, NON_NEGATIVE);
+        const bool unit        = has(lhs, UNIT_BOUNDED) && has(rhs, UNIT_BOUNDED);
+
+        switch (operation)
+        {
+            // inf + -inf
+            case Operation::Add:
+                return {
+                  closure(
+                    onlyIf(nonNegative, NON_NEGATIVE)
+                    | onlyIf(nonNegative && (has(lhs, POSITIVE) || has(rhs, POSITIVE)), POSITIVE)
+                    | onlyIf(unit, FINITE)
+                  ),
+                  (mayBeInfinity(lhs) && mayBeMinusInfinity(rhs)) || (mayBeMinusInfinity(lhs) && mayBeInfinity(rhs))
+                };
+            // inf - inf, -inf - -inf
+            case Operation::Subtract:
+                return {
+                  closure(onlyIf(unit, FINITE) | onlyIf(unit && nonNegative, UNIT_BOUNDED)),
+                  mayBeInfinity(lhs) && mayBeInfinity(rhs)
+                };
+            // 0 * inf
+            case Operation::Multiply:
+                return {
+                  closure(
+                    onlyIf(nonNegative, NON_NEGATIVE) | onlyIf(unit, UNIT_BOUNDED)
+                    | onlyIf(has(lhs, UNIT_BOUNDED) && has(rhs, FINITE), FINITE)
+                    | onlyIf(has(lhs, FINITE) && has(rhs, UNIT_BOUNDED), FINITE)
+                  ),
+                  (mayBeZero(lhs) && mayBeInfinity(rhs)) || (mayBeInfinity(lhs) && mayBeZero(rhs))
+                };
+            // 0 / 0, inf / inf. A non-negative divisor may be -0.0, only a positive one keeps the sign.
+            case Operation::Divide:
+                return {
+                  onlyIf(has(lhs, NON_NEGATIVE) && has(rhs, POSITIVE), NON_NEGATIVE),
+                  (mayBeZero(lhs) && mayBeZero(rhs)) || (mayBeInfinity(lhs) && mayBeInfinity(rhs))
+                };
+            // sqrt(-x), sqrt(-0.0) is -0.0
+            case Operation::Sqrt:
+                return {closure(NON_NEGATIVE | (lhs & (POSITIVE | FINITE | UNIT_BOUNDED))), !has(lhs, NON_NEGATIVE)};
+            // log(-x), log(0) is -inf
+            case Operation::Log:
+                return {onlyIf(has(lhs, POSITIVE | FINITE), FINITE), !has(lhs, NON_NEGATIVE)};
+            // exp(-inf) is 0, exp(inf) is inf
+            case Operation::Exp:
+                return {
+                  closure(
+                    NON_NEGATIVE | onlyIf(has(lhs, NON_NEGATIVE) || has(lhs, UNIT_BOUNDED), POSITIVE)
+                    | onlyIf(has(lhs, UNIT_BOUNDED), FINITE)
+                  ),
+                  false
+                };
+            // sin(inf), cos(inf)
+            case Operation::Sin:
+            case Operation::Cos: return {closure(UNIT_BOUNDED), !has(lhs, FINITE)};
+            // asin(x) and acos(x) for |x| > 1
+            case Operation::Asin:
+                return {closure(FINITE | (lhs & NON_NEGATIVE)), !has(lhs, UNIT_BOUNDED)};
+            case Operation::Acos: return {closure(FINITE | NON_NEGATIVE), !has(lhs, UNIT_BOUNDED)};
+            case Operation::Abs:  return {closure(NON_NEGATIVE | lhs), false};
+            default:              return {0, true};
+        }
+    }
+
+    // In-place operations need no check and keep all refinements of the lhs, e.g. NonNegative += NonNegative
+    [[nodiscard]]
+    constexpr auto keeps(const Operation operation, const Refinements lhs, const Refinements rhs) noexcept -> bool
+    {
+        const Propagation result = propagate(operation, lhs, rhs);
+        return !result.check && has(result.refinements, lhs);
+    }
+
+    // Whether a value has the refinements. NaN has none of them.
+    template <std::floating_point T>
+    [[nodiscard]]
+    constexpr auto satisfies(const T value, const Refinements refinements) noexcept -> bool
+    {
+        using namespace refinement;
+        constexpr T MAX = std::numeric_limits<T>::max();
+
+        if (isNaN(value))
+        {
+            return false;
+        }
+        return (!has(refinements, FINITE) || (-MAX <= value && value <= MAX))
+               && (!has(refinements, NON_NEGATIVE) || value >= T {0})
+               && (!has(refinements, POSITIVE) || value > T {0})
+               && (!has(refinements, UNIT_BOUNDED) || (T {-1} <= value && value <= T {1}));
+    }
+
+    [[nodiscard, gnu::cold]]
+    inline auto describeRefinements(const Refinements refinements) -> std::string
+    {
+        using namespace refinement;
+
+        std::string result;
+        const auto  append = [&result](const char* part)
+        {
+            result += result.empty() ? "" : " and ";
+            result += part;
+        };
+        if (has(refinements, FINITE) && !has(refinements, UNIT_BOUNDED))
+        {
+            append("finite");
+        }
+        if (has(refinements, POSITIVE))
+        {
+            append("positive");
+        }
+        else if (has(refinements, NON_NEGATIVE))
+        {
+            append("non-negative");
+        }
+        if (has(refinements, UNIT_BOUNDED))
+        {
+            append("in [-1, 1]");
+        }
+        return result;
+    }
+
+    template <std::floating_point T>
+    [[noreturn, gnu::cold, gnu::noinline]]
+    void throwRefinementError(const T value, const Refinements refinements)
+    {
+        throw std::invalid_argument(std::format("{} is not {}", value, describeRefinements(refinements)));
+    }
+
+    // Reports a value without the refinements through Policy, the default policy names the value and the refinements.
+    // The other policies only know NaNError, to them it is a bad value given to a constructor.
+    template <CheckPolicy Policy, std::floating_point T>
+    [[gnu::cold, gnu::noinline]]
+    void raiseRefinementError(const T value, const Refinements refinements)
+    {
+        if constexpr (std::same_as<Policy, ThrowPolicy>)
+        {
+            throwRefinementError(value, refinements);
+        }
+        else
+        {
+            Policy::raise({Operation::Construct, Operand::Value});
+        }
+    }
+
+    // Like raiseRefinementError, through Policy's Result where there is one
+    template <typename Out, CheckPolicy Policy, std::floating_point T>
+    [[gnu::cold, gnu::noinline]]
+    auto refinementFailure(const T value, const Refinements refinements) -> typename Policy::template Result<Out>
+    {
+        if constexpr (std::same_as<Policy, ThrowPolicy>)
+        {
+            throwRefinementError(value, refinements);
+        }
+        else
+        {
+            return Policy::template failure<Out>({Operation::Construct, Operand::Value});
+        }
+    }
+
+    // Results without any refinement left are plain NotNaN
+    template <std::floating_point T, Refinements R, CheckPolicy Policy>
+    struct RefinedType
+    {
+        using Type = Refined<T, R, Policy>;
+    };
+
+    template <std::floating_point T, CheckPolicy Policy>
+    struct RefinedType<T, 0, Policy>
+    {
+        using Type = NotNaN<T, Policy>;
+    };
+
+    template <typename U>
+    inline constexpr bool IS_REFINED = false;
+
+    template <std::floating_point T, Refinements R, CheckPolicy Policy>
+    inline constexpr bool IS_REFINED<Refined<T, R, Policy>> = true;
+
+    // NotNaN is the refined type without refinements
+    template <typename U>
+    inline constexpr Refinements REFINEMENTS_OF = 0;
+
+    template <std::floating_point T, Refinements R, CheckPolicy Policy>
+    inline constexpr Refinements REFINEMENTS_OF<Refined<T, R, Policy>> = R;
+
+    template <typename U>
+    concept RefinedOperand = IS_REFINED<U> || IsNotNaN<U>;
+
+    // At least one operand is refined, NotNaN with NotNaN keeps the operators of NotNaN
+    template <typename L, typename R>
+    concept RefinedOperands = RefinedOperand<L> && RefinedOperand<R> && (IS_REFINED<L> || IS_REFINED<R>)
+                              && std::same_as<typename L::Type, typename R::Type>
+                              && std::same_as<typename L::PolicyType, typename R::PolicyType>;
+
+    template <std::floating_point T, CheckPolicy Policy, Propagation RESULT>
+    [[nodiscard]]
+    constexpr auto makeRefined(const T value, const Operation operation)
+    {
+        return makeProven<typename RefinedType<T, RESULT.refinements, Policy>::Type, Policy, RESULT.check>(value, operation);
+    }
+
+    template <typename L, typename R, typename BinaryOp>
+    [[nodiscard]]
+    constexpr auto refinedArithmetic(const L& lhs, const R& rhs, const BinaryOp& operation)
+    {
+        constexpr Operation OPERATION = OPERATION_OF<BinaryOp>;
+        constexpr Propagation RESULT  = propagate(OPERATION, REFINEMENTS_OF<L>, REFINEMENTS_OF<R>);
+        return makeRefined<typename L::Type, typename L::PolicyType, RESULT>(operation(*lhs, *rhs), OPERATION);
+    }
+}    // namespace detail
+
+// Satisfied by the Refined specializations only
+template <typename U>
+concept IsRefined = detail::IS_REFINED<U>;
+
+// NotNaN<T, Policy> whose values also have the refinements R, usually spelled with the aliases below.
+// Converts implicitly to NotNaN and to refined types with fewer refinements, explicitly and checked to more.
+// NaN and values without the refinements are reported through Policy, the default policy throws
+// std::invalid_argument naming the refinements the value lacks.
+// Like NotNaN, policies without checks trust the caller.
+template <std::floating_point T, Refinements R, CheckPolicy Policy>
+class Refined
+{
+    static_assert(R != 0, "Refined without refinements is NotNaN");
+    static_assert(R == detail::closure(R), "Implied refinements have to be spelled out, e.g. POSITIVE | NON_NEGATIVE");
+
+  private:
+    T m_value;
+
+    friend struct detail::UncheckedAccess;
+
+    constexpr Refined(detail::UncheckedTag /* tag */, const T& value) noexcept : m_value {value}
+    {
+        // empty
+    }
+
+    static constexpr void checkRefinements(const T& value)
+    {
+        if constexpr (Policy::CHECKED)
+        {
+            if (!detail::satisfies(value, R)) [[unlikely]]
+            {
+                detail::raiseRefinementError<Policy>(value, R);
+            }
+        }
+    }
+
+    template <Operation OPERATION>
+    [[nodiscard]]
+    static constexpr auto makeResult(const T& value)
+    {
+        return detail::makeRefined<T, Policy, detail::propagate(OPERATION, R)>(value, OPERATION);
+    }
+
+  public:
+    using Type       = T;
+    using PolicyType = Policy;
+
+    static constexpr Refinements REFINEMENTS = R;
+
+    Refined() = delete;    // force initialization
+
+    constexpr explicit Refined(const T& value) : m_value {value}
+    {
+        if constexpr (Policy::CHECKED)
+        {
+            if (isNaN(value)) [[unlikely]]
+            {
+                Policy::raise({Operation::Construct, Operand::Value});
+            }
+        }
+        checkRefinements(value);
+    }
+
+    constexpr explicit Refined(const NotNaN<T, Policy>& value) : m_value {*value}
+    {
+        checkRefinements(m_value);
+    }
+
+    // Dropping refinements is free, adding them is checked
+    template <Refinements S>
+    constexpr explicit(!detail::has(S, R)) Refined(const Refined<T, S, Policy>& other) : m_value {*other}
+    {
+        if constexpr (!detail::has(S, R))
+        {
+            checkRefinements(m_value);
+        }
+    }
+
+    // Construction that reports NaN and values without the refinements through the policy's result type instead of
+    // raising. The default policy still throws, naming the refinements the value lacks.
+    [[nodiscard]]
+    static constexpr auto fromValue(const T& value) -> typename Policy::template Result<Refined>
+    {
+        if constexpr (Policy::CHECKED)
+        {
+            if (isNaN(value)) [[unlikely]]
+            {
+                return detail::provenFailure<Refined, Policy>({Operation::Construct, Operand::Value});
+            }
+            if (!detail::satisfies(value, R)) [[unlikely]]
+            {
+                return detail::refinementFailure<Refined, Policy>(value, R);
+            }
+        }
+        return Policy::template success<Refined>(Refined {detail::UncheckedTag {}, value});
+    }
+
+    // Construction that reports NaN and values without the refinements through std::expected, whatever the policy
+    [[nodiscard]]
+    static constexpr auto tryFromValue(const T& value) noexcept -> std::expected<Refined, NaNError>
+    {
+        if (Policy::CHECKED && !detail::satisfies(value, R)) [[unlikely]]
+        {
+            return std::unexpected(NaNError {Operation::Construct, Operand::Value});
+        }
+        return Refined {detail::UncheckedTag {}, value};
+    }
+
+    // Getting the value
+    [[nodiscard]]
+    constexpr auto operator* () const noexcept -> T
+    {
+        return m_value;
+    }
+
+    [[nodiscard]]
+    constexpr auto value() const noexcept -> NotNaN<T, Policy>
+    {
+        return detail::UncheckedAccess::make<NotNaN<T, Policy>>(m_value);
+    }
+
+    [[nodiscard]]
+    constexpr operator NotNaN<T, Policy> () const noexcept    // NOLINT(google-explicit-constructor)
+    {
+        return value();
+    }
+
+    // Comparison
+    template <typename U>
+        requires detail::RefinedOperands<Refined, U>
+    [[nodiscard]]
+    constexpr auto operator<=> (const U& rhs) const noexcept -> std::strong_ordering
+    {
+        return value() <=> static_cast<NotNaN<T, Policy>>(rhs);
+    }
+    template <typename U>
+        requires detail::RefinedOperands<Refined, U>
+    [[nodiscard]]
+    constexpr auto operator== (const U& rhs) const noexcept -> bool
+    {
+        return m_value == *rhs;
+    }
+
+    // Raw values may be NaN, they are checked like in comparisons with NotNaN
+    [[nodiscard]]
+    constexpr auto operator<=> (const auto& rhs) const
+        requires std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
+    {
+        return value() <=> rhs;
+    }
+    [[nodiscard]]
+    constexpr auto operator== (const auto& rhs) const -> bool
+        requires std::is_arithmetic_v<std::remove_cvref_t<decltype(rhs)>>
+    {
+        return value() == rhs;
+    }
+
+    // In-place arithmetic exists where it needs no check and keeps the refinements, e.g. NonNegative += NonNegative
+    template <typename U>
+        requires (detail::RefinedOperands<Refined, U> && detail::keeps(Operation::Add, R, detail::REFINEMENTS_OF<U>))
+    constexpr auto operator+= (const U& rhs) noexcept -> Refined&
+    {
+        m_value += *rhs;
+        return *this;
+    }
+    template <typename U>
+        requires (detail::RefinedOperands<Refined, U> && detail::keeps(Operation::Subtract, R, detail::REFINEMENTS_OF<U>))
+    constexpr auto operator-= (const U& rhs) noexcept -> Refined&
+    {
+        m_value -= *rhs;
+        return *this;
+    }
+    template <typename U>
+        requires (detail::RefinedOperands<Refined, U> && detail::keeps(Operation::Multiply, R, detail::REFINEMENTS_OF<U>))
+    constexpr auto operator*= (const U& rhs) noexcept -> Refined&
+    {
+        m_value *= *rhs;
+        return *this;
+    }
+    template <typename U>
+        requires (detail::RefinedOperands<Refined, U> && detail::keeps(Operation::Divide, R, detail::REFINEMENTS_OF<U>))
+    constexpr auto operator/= (const U& rhs) noexcept -> Refined&
+    {
+        m_value /= *rhs;
+        return *this;
+    }
+
+    // Unary operators, negation keeps only the refinements that are symmetric around 0
+    constexpr auto operator+ () const noexcept -> Refined { return *this; }
+    constexpr auto operator- () const noexcept
+    {
+        constexpr Refinements NEGATED = R & (refinement::FINITE | refinement::UNIT_BOUNDED);
+        return detail::UncheckedAccess::make<typename detail::RefinedType<T, NEGATED, Policy>::Type>(-m_value);
+    }
+
+    // Math members, checked like those of NotNaN where the refinements can't rule out NaN
+    [[nodiscard]]
+    constexpr auto sqrt() const
+    {
+        return makeResult<Operation::Sqrt>(std::sqrt(m_value));
+    }
+
+    [[nodiscard]]
+    constexpr auto log() const
+    {
+        return makeResult<Operation::Log>(std::log(m_value));
+    }
+
+    [[nodiscard]]
+    constexpr auto exp() const
+    {
+        return makeResult<Operation::Exp>(std::exp(m_value));
+    }
+
+    [[nodiscard]]
+    constexpr auto abs() const
+    {
+        return makeResult<Operation::Abs>(std::abs(m_value));
+    }
+
+    [[nodiscard]]
+    constexpr auto sin() const
+    {
+        return makeResult<Operation::Sin>(std::sin(m_value));
+    }
+
+    [[nodiscard]]
+    constexpr auto cos() const
+    {
+        return makeResult<Operation::Cos>(std::cos(m_value));
+    }
+
+    [[nodiscard]]
+    constexpr auto asin() const
+    {
+        return makeResult<Operation::Asin>(std::asin(m_value));
+    }
+
+    [[nodiscard]]
+    constexpr auto acos() const
+    {
+        return makeResult<Operation::Acos>(std::acos(m_value));
+    }
+};
+
+// Binary operators on two refined types, or a refined type and NotNaN
+template <typename L, typename R>
+    requires detail::RefinedOperands<L, R>
+[[nodiscard]]
+constexpr auto operator+ (const L& lhs, const R& rhs)
+{
+    return detail::refinedArithmetic(lhs, rhs, std::plus {});
+}
+
+template <typename L, typename R>
+    requires detail::RefinedOperands<L, R>
+[[nodiscard]]
+constexpr auto operator- (const L& lhs, const R& rhs)
+{
+    return detail::refinedArithmetic(lhs, rhs, std::minus {});
+}
+
+template <typename L, typename R>
+    requires detail::RefinedOperands<L, R>
+[[nodiscard]]
+constexpr auto operator* (const L& lhs, const R& rhs)
+{
+    return detail::refinedArithmetic(lhs, rhs, std::multiplies {});
+}
+
+template <typename L, typename R>
+    requires detail::RefinedOperands<L, R>
+[[nodiscard]]
+constexpr auto operator/ (const L& lhs, const R& rhs)
+{
+    return detail::refinedArithmetic(lhs, rhs, std::divides {});
+}
+
+template <std::floating_point T, CheckPolicy Policy = ThrowPolicy>
+using Finite = Refined<T, refinement::FINITE, Policy>;
+
+// [-0.0, inf]
+template <std::floating_point T, CheckPolicy Policy = ThrowPolicy>
+using NonNegative = Refined<T, refinement::NON_NEGATIVE, Policy>;
+
+// (0, inf]
+template <std::floating_point T, CheckPolicy Policy = ThrowPolicy>
+using Positive = Refined<T, refinement::POSITIVE | refinement::NON_NEGATIVE, Policy>;
+
+// [-0.0, 1]
+template <std::floating_point T, CheckPolicy Policy = ThrowPolicy>
+using UnitInterval = Refined<T, refinement::NON_NEGATIVE | refinement::UNIT_BOUNDED | refinement::FINITE, Policy>;
+}    // namespace notnan
+
+template <std::floating_point T, notnan::Refinements R, notnan::CheckPolicy Policy>
+struct std::formatter<notnan::Refined<T, R, Policy>> : std::formatter<T>
+{
+    template <class FormatContext>
+    auto format(const notnan::Refined<T, R, Policy>& t, FormatContext& ctx) const
+    {
+        return std::formatter<T>::format(*t, ctx);
+    }
+};
@@ -0,0 +1,438 @@
+#pragma once
+
+#include "NotNaN.hpp"
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <experimental/simd>
+#include <functional>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace notnan
+{
+namespace detail
+{
+    namespace stdx = std::experimental;
+
+    // The native vector of N values where the target has one, otherwise a fixed size one
+    template <typename T, std::size_t N>
+    using SimdOf = stdx::simd<T, stdx::simd_abi::deduce_t<T, N>>;
+
+    // isNaNBits for all lanes at once, with a single test of the mask. Like isNaNBits it works on the bit patterns,
+    // which -ffast-math can't fold away. The simd types are not trivially copyable, so the bits go through arrays,
+    // which the compiler turns into register moves.
+    template <std::floating_point T, typename Abi>
+    [[nodiscard, gnu::always_inline]]
+    inline auto anyNaN(const stdx::simd<T, Abi> values) noexcept -> bool
+    {
+        constexpr std::size_t N = stdx::simd_size_v<T, Abi>;
+
+        // after clearing the sign the bits are non negative, a signed comparison is all SSE2 and AVX2 have
+        using Bits               = std::make_signed_t<typename UnsignedOfSize<sizeof(T)>::Type>;
+        using Lanes              = stdx::rebind_simd_t<Bits, stdx::simd<T, Abi>>;
+        constexpr int  EXPONENT  = 8 * sizeof(T) - std::numeric_limits<T>::digits;
+        constexpr Bits ABS_MASK  = std::numeric_limits<Bits>::max();
+        constexpr Bits INFINITY_ = ((Bits {1} << EXPONENT) - 1) << (std::numeric_limits<T>::digits - 1);
+
+        alignas(stdx::memory_alignment_v<stdx::simd<T, Abi>>) std::array<T, N> raw;    // NOLINT(cppcoreguidelines-pro-type-member-init)
+        values.copy_to(raw.data(), stdx::vector_aligned);
+        const auto  bits = std::bit_cast<std::array<Bits, N>>(raw);
+        const Lanes lanes {bits.data(), stdx::element_aligned};
+        return stdx::any_of((lanes & Lanes {ABS_MASK}) > Lanes {INFINITY_});
+    }
+}    // namespace detail
+}    // namespace notnan
+
+// N values of NotNaN<T, Policy> in one std::experimental::simd, for hand-written kernels that want to keep the
+// guarantee at full vector width. Operations check all lanes with one mask test and report NaN through Policy like
+// NotNaN, without saying which lane it was in. Comparisons return the mask of the simd.
+//
+//   const NotNaNSimd<float, 8> x {values.subspan(i, 8)};    // no check, the values are NotNaN already
+//   (x * x + bias).sqrt().store(results.subspan(i, 8));       // one check for *, +, and sqrt each
+//
+// Only for float and double, whose NaN can be tested on the bits. Everything but the failure path is forced inline
+// like the operations of std::experimental::simd, a call would spill all lanes to the stack. N is best the size of
+// std::experimental::native_simd<T>, larger N give a fixed size simd which GCC copies through memory.
+template <std::floating_point T, std::size_t N, notnan::CheckPolicy Policy = notnan::ThrowPolicy>
+    requires (std::same_as<T, float> || std::same_as<T, double>)
+class NotNaNSimd
+{
+  public:
+    using Type       = T;
+    using PolicyType = Policy;
+    using SimdType   = notnan::detail::SimdOf<T, N>;
+    using MaskType   = typename SimdType::mask_type;
+
+  private:
+    SimdType m_values;
+
+    friend struct notnan::detail::UncheckedAccess;
+
+    template <typename R>
+    using Result = typename Policy::template Result<R>;
+
+    // The operands besides NotNaNSimd, which are applied to all lanes
+    template <typename U>
+    static constexpr bool IS_OPERAND = std::same_as<U, NotNaNSimd> || std::same_as<U, NotNaN<T, Policy>>
+                                       || std::same_as<U, T>;
+
+    // At least one of them is this NotNaNSimd
+    template <typename L, typename R>
+    static constexpr bool ARE_OPERANDS = IS_OPERAND<L> && IS_OPERAND<R>
+                                         && (std::same_as<L, NotNaNSimd> || std::same_as<R, NotNaNSimd>);
+
+    [[gnu::always_inline]]
+    NotNaNSimd(notnan::detail::UncheckedTag /* tag */, const SimdType values) noexcept : m_values {values}
+    {
+        // empty
+    }
+
+    // Deferred policies check results some other way, like NotNaN::isBadResult
+    [[nodiscard, gnu::always_inline]]
+    static auto isBadResult(const SimdType& values) noexcept -> bool
+    {
+        if constexpr (!Policy::CHECKED)
+        {
+            return false;
+        }
+        else
+        {
+            return !notnan::detail::isDeferringResultCheck<Policy>() && notnan::detail::anyNaN(values);
+        }
+    }
+
+    // Only raw T can be NaN, the other operands are checked already
+    template <typename U>
+    [[nodiscard, gnu::always_inline]]
+    static auto isBadArgument(const U& value) noexcept -> bool
+    {
+        if constexpr (Policy::CHECKED && std::same_as<U, T>)
+        {
+            return notnan::isNaN(value);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    template <typename U>
+    [[nodiscard, gnu::always_inline]]
+    static auto lanes(const U& operand) noexcept -> decltype(auto)
+    {
+        if constexpr (std::same_as<U, NotNaNSimd>)
+        {
+            return (operand.m_values);
+        }
+        else if constexpr (std::same_as<U, T>)
+        {
+            return SimdType {operand};
+        }
+        else
+        {
+            return SimdType {*operand};
+        }
+    }
+
+    // The failure path of all operations, out of line like that of NotNaN
+    template <typename R>
+    [[nodiscard, gnu::cold, gnu::noinline]]
+    static auto failure(const notnan::NaNError error) -> Result<R>
+    {
+        return Policy::template failure<R>(error);
+    }
+
+    [[nodiscard, gnu::always_inline]]
+    static auto makeResult(const SimdType& values, const notnan::Operation operation) -> Result<NotNaNSimd>
+    {
+        if (isBadResult(values)) [[unlikely]]
+        {
+            return failure<NotNaNSimd>({operation, notnan::Operand::Result});
+        }
+        return Policy::template success<NotNaNSimd>(NotNaNSimd {notnan::detail::UncheckedTag {}, values});
+    }
+
+    template <typename L, typename R, typename BinaryOp>
+    [[nodiscard, gnu::always_inline]]
+    static auto arithmetic(const L& lhs, const R& rhs, const BinaryOp& operation) -> Result<NotNaNSimd>
+    {
+        constexpr notnan::Operation OPERATION = notnan::detail::OPERATION_OF<BinaryOp>;
+
+        if (isBadArgument(lhs)) [[unlikely]]
+        {
+            return failure<NotNaNSimd>({OPERATION, notnan::Operand::Lhs});
+        }
+        if (isBadArgument(rhs)) [[unlikely]]
+        {
+            return failure<NotNaNSimd>({OPERATION, notnan::Operand::Rhs});
+        }
+        return makeResult(operation(lanes(lhs), lanes(rhs)), OPERATION);
+    }
+
+    // The lanes are only overwritten when the result is NaN free
+    template <typename R, typename BinaryOp>
+    [[gnu::always_inline]]
+    auto arithmeticInPlace(const R& rhs, const BinaryOp& operation) -> Result<NotNaNSimd&>
+    {
+        constexpr notnan::Operation OPERATION = notnan::detail::OPERATION_OF<BinaryOp>;
+
+        if (isBadArgument(rhs)) [[unlikely]]
+        {
+            return failure<NotNaNSimd&>({OPERATION, notnan::Operand::Rhs});
+        }
+        const SimdType values = operation(m_values, lanes(rhs));
+        if (isBadResult(values)) [[unlikely]]
+        {
+            return failure<NotNaNSimd&>({OPERATION, notnan::Operand::Result});
+        }
+        m_values = values;
+        return Policy::template success<NotNaNSimd&>(*this);
+    }
+
+    // Comparisons have no error channel, a NaN operand is raised like in comparisons of NotNaN
+    template <typename U>
+    [[gnu::always_inline]]
+    static void checkComparand(const U& value)
+    {
+        if (isBadArgument(value)) [[unlikely]]
+        {
+            Policy::raise({notnan::Operation::Compare, notnan::Operand::Value});
+        }
+    }
+
+    template <typename L, typename R, typename Compare>
+    [[nodiscard, gnu::always_inline]]
+    static auto compare(const L& lhs, const R& rhs, const Compare& comparison) -> MaskType
+    {
+        checkComparand(lhs);
+        checkComparand(rhs);
+        return comparison(lanes(lhs), lanes(rhs));
+    }
+
+  public:
+    NotNaNSimd()  = delete;    // force initialization
+    ~NotNaNSimd() = default;
+
+    // Checks all lanes
+    [[gnu::always_inline]]
+    explicit NotNaNSimd(const SimdType& values) : m_values {values}
+    {
+        if constexpr (Policy::CHECKED)
+        {
+            if (notnan::detail::anyNaN(values)) [[unlikely]]
+            {
+                Policy::raise({notnan::Operation::Construct, notnan::Operand::Value});
+            }
+        }
+    }
+
+    // value in all lanes
+    [[gnu::always_inline]]
+    explicit NotNaNSimd(const NotNaN<T, Policy>& value) noexcept : m_values {*value}
+    {
+        // empty
+    }
+
+    // Loads values, which have to be N, as raw values without any check. Throws std::invalid_argument on a size
+    // mismatch.
+    [[gnu::always_inline]]
+    explicit NotNaNSimd(const std::span<const NotNaN<T, Policy>> values)
+    {
+        notnan::detail::checkSizes(values.size(), N);
+        m_values.copy_from(notnan::detail::rawData(values), notnan::detail::stdx::element_aligned);
+    }
+
+    NotNaNSimd(const NotNaNSimd& other)                         = default;
+    NotNaNSimd(NotNaNSimd&& other) noexcept                     = default;
+    auto operator= (const NotNaNSimd& other) -> NotNaNSimd&     = default;
+    auto operator= (NotNaNSimd&& other) noexcept -> NotNaNSimd& = default;
+
+    // Construction that reports NaN through the policy's result type instead of raising
+    [[nodiscard, gnu::always_inline]]
+    static auto fromValues(const SimdType& values) -> Result<NotNaNSimd>
+    {
+        if (Policy::CHECKED && notnan::detail::anyNaN(values)) [[unlikely]]
+        {
+            return failure<NotNaNSimd>({notnan::Operation::Construct, notnan::Operand::Value});
+        }
+        return Policy::template success<NotNaNSimd>(NotNaNSimd {notnan::detail::UncheckedTag {}, values});
+    }
+
+    // Stores into values, which have to be N. Throws std::invalid_argument on a size mismatch.
+    [[gnu::always_inline]]
+    void store(const std::span<NotNaN<T, Policy>> values) const
+    {
+        notnan::detail::checkSizes(values.size(), N);
+        m_values.copy_to(notnan::detail::rawData(values), notnan::detail::stdx::element_aligned);
+    }
+
+    [[nodiscard, gnu::always_inline]]
+    static constexpr auto size() noexcept -> std::size_t
+    {
+        return N;
+    }
+
+    // Getting the values
+    [[nodiscard, gnu::always_inline]]
+    auto operator* () const noexcept -> SimdType
+    {
+        return m_values;
+    }
+
+    [[nodiscard, gnu::always_inline]]
+    auto operator[] (const std::size_t lane) const noexcept -> NotNaN<T, Policy>
+    {
+        return notnan::detail::UncheckedAccess::make<NotNaN<T, Policy>>(T {m_values[lane]});
+    }
+
+    // Comparison, lane by lane
+    template <typename L, typename R>
+        requires ARE_OPERANDS<L, R>
+    [[nodiscard, gnu::always_inline]]
+    friend auto operator== (const L& lhs, const R& rhs) -> MaskType
+    {
+        return compare(lhs, rhs, [](const SimdType& a, const SimdType& b) { return a == b; });
+    }
+    template <typename L, typename R>
+        requires ARE_OPERANDS<L, R>
+    [[nodiscard, gnu::always_inline]]
+    friend auto operator!= (const L& lhs, const R& rhs) -> MaskType
+    {
+        return compare(lhs, rhs, [](const SimdType& a, const SimdType& b) { return a != b; });
+    }
+    template <typename L, typename R>
+        requires ARE_OPERANDS<L, R>
+    [[nodiscard, gnu::always_inline]]
+    friend auto operator< (const L& lhs, const R& rhs) -> MaskType
+    {
+        return compare(lhs, rhs, [](const SimdType& a, const SimdType& b) { return a < b; });
+    }
+    template <typename L, typename R>
+        requires ARE_OPERANDS<L, R>
+    [[nodiscard, gnu::always_inline]]
+    friend auto operator<= (const L& lhs, const R& rhs) -> MaskType
+    {
+        return compare(lhs, rhs, [](const SimdType& a, const SimdType& b) { return a <= b; });
+    }
+    template <typename L, typename R>
+        requires ARE_OPERANDS<L, R>
+    [[nodiscard, gnu::always_inline]]
+    friend auto operator> (const L& lhs, const R& rhs) -> MaskType
+    {
+        return compare(lhs, rhs, [](const SimdType& a, const SimdType& b) { return a > b; });
+    }
+    template <typename L, typename R>
+        requires ARE_OPERANDS<L, R>
+    [[nodiscard, gnu::always_inline]]
+    friend auto operator>= (const L& lhs, const R& rhs) -> MaskType
+    {
+        return compare(lhs, rhs, [](const SimdType& a, const SimdType& b) { return a >= b; });
+    }
+
+    // Arithmetic with NotNaNSimd, NotNaN or T in all lanes
+    template <typename L, typename R>
+        requires ARE_OPERANDS<L, R>
+    [[gnu::always_inline]]
+    friend auto operator+ (const L& lhs, const R& rhs) -> Result<NotNaNSimd>
+    {
+        return arithmetic(lhs, rhs, std::plus {});
+    }
+    template <typename L, typename R>
+        requires ARE_OPERANDS<L, R>
+    [[gnu::always_inline]]
+    friend auto operator- (const L& lhs, const R& rhs) -> Result<NotNaNSimd>
+    {
+        return arithmetic(lhs, rhs, std::minus {});
+    }
+    template <typename L, typename R>
+        requires ARE_OPERANDS<L, R>
+    [[gnu::always_inline]]
+    friend auto operator* (const L& lhs, const R& rhs) -> Result<NotNaNSimd>
+    {
+        return arithmetic(lhs, rhs, std::multiplies {});
+    }
+    template <typename L, typename R>
+        requires ARE_OPERANDS<L, R>
+    [[gnu::always_inline]]
+    friend auto operator/ (const L& lhs, const R& rhs) -> Result<NotNaNSimd>
+    {
+        return arithmetic(lhs, rhs, std::divides {});
+    }
+
+    template <typename R>
+        requires IS_OPERAND<R>
+    [[gnu::always_inline]]
+    auto operator+= (const R& rhs) -> Result<NotNaNSimd&>
+    {
+        return arithmeticInPlace(rhs, std::plus {});
+    }
+    template <typename R>
+        requires IS_OPERAND<R>
+    [[gnu::always_inline]]
+    auto operator-= (const R& rhs) -> Result<NotNaNSimd&>
+    {
+        return arithmeticInPlace(rhs, std::minus {});
+    }
+    template <typename R>
+        requires IS_OPERAND<R>
+    [[gnu::always_inline]]
+    auto operator*= (const R& rhs) -> Result<NotNaNSimd&>
+    {
+        return arithmeticInPlace(rhs, std::multiplies {});
+    }
+    template <typename R>
+        requires IS_OPERAND<R>
+    [[gnu::always_inline]]
+    auto operator/= (const R& rhs) -> Result<NotNaNSimd&>
+    {
+        return arithmeticInPlace(rhs, std::divides {});
+    }
+
+    // Unary operators can't give NaN
+    [[gnu::always_inline]]
+    auto operator+ () const noexcept -> NotNaNSimd
+    {
+        return *this;
+    }
+    [[gnu::always_inline]]
+    auto operator- () const noexcept -> NotNaNSimd
+    {
+        return NotNaNSimd {notnan::detail::UncheckedTag {}, -m_values};
+    }
+
+    // Math members, only sqrt can give NaN
+    [[nodiscard, gnu::always_inline]]
+    auto sqrt() const -> Result<NotNaNSimd>
+    {
+        return makeResult(notnan::detail::stdx::sqrt(m_values), notnan::Operation::Sqrt);
+    }
+
+    [[nodiscard, gnu::always_inline]]
+    auto abs() const noexcept -> NotNaNSimd
+    {
+        return NotNaNSimd {notnan::detail::UncheckedTag {}, notnan::detail::stdx::abs(m_values)};
+    }
+
+    [[nodiscard, gnu::always_inline]]
+    auto floor() const noexcept -> NotNaNSimd
+    {
+        return NotNaNSimd {notnan::detail::UncheckedTag {}, notnan::detail::stdx::floor(m_values)};
+    }
+
+    // Lane by lane, found by argument dependent lookup like std::experimental::min and max
+    [[nodiscard, gnu::always_inline]]
+    friend auto min(const NotNaNSimd& lhs, const NotNaNSimd& rhs) noexcept -> NotNaNSimd
+    {
+        return NotNaNSimd {notnan::detail::UncheckedTag {}, notnan::detail::stdx::min(lhs.m_values, rhs.m_values)};
+    }
+
+    [[nodiscard, gnu::always_inline]]
+    friend auto max(const NotNaNSimd& lhs, const NotNaNSimd& rhs) noexcept -> NotNaNSimd
+    {
+        return NotNaNSimd {notnan::detail::UncheckedTag {}, notnan::detail::stdx::max(lhs.m_values, rhs.m_values)};
+    }
+};
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "NotNaN.hpp"
+#include "NotNaNGuard.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cfenv>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+
+#include <unistd.h>
+
+#if !defined(__linux__) || !defined(__GLIBC__)
+#error "NotNaNTrap.hpp needs Linux and glibc (feenableexcept)"
+#endif
+
+// Trapping invalid operations instead of checking for them.
+// notnan::trapInvalid(function) unmasks FE_INVALID for the calling thread while function runs. The first operation
+// that turns numbers into NaN raises SIGFPE right at the faulting instruction. The handler writes that instruction's
+// address to stderr and aborts, like AssertPolicy does. Arithmetic in between runs without any check instructions,
+// use NotNaN<T, notnan::HardwarePolicy> to also drop the software result checks.
+//
+//   const auto sum = notnan::trapInvalid([&] { return kernel(values); });
+//
+// The trap does not return into function: leaving it from a signal handler would skip the destructors of everything in
+// between. Exceptions thrown by function pass through as usual.
+// As with NaNGuardScope, raw arithmetic values given to a NotNaN are still checked on the spot.
+namespace notnan
+{
+namespace detail
+{
+    // How many trapInvalid calls of the calling thread are running
+    inline thread_local int t_trapDepth = 0;
+
+    // Writes "NotNaN trap: Result of guarded scope is NaN at 0x<address>" to stderr.
+    // A signal handler may not allocate, so this is written with write(2) instead of going through describe().
+    inline void reportTrap(const void* const address) noexcept
+    {
+        constexpr std::string_view PREFIX = "NotNaN trap: Result of guarded scope is NaN at 0x";
+        constexpr std::string_view DIGITS = "0123456789abcdef";
+        constexpr int              NIBBLE = 4;
+
+        std::array<char, PREFIX.size() + (2 * sizeof(std::uintptr_t)) + 1> text {};
+        auto       out  = std::copy(PREFIX.begin(), PREFIX.end(), text.begin());
+        const auto bits = reinterpret_cast<std::uintptr_t>(address);
+        for (int shift = (static_cast<int>(sizeof(bits)) * 8) - NIBBLE; shift >= 0; shift -= NIBBLE)
+        {
+            *out++ = DIGITS[(bits >> shift) & 0xFU];
+        }
+        *out++ = '\n';
+        [[maybe_unused]] const auto written = ::write(STDERR_FILENO, text.data(), static_cast<std::size_t>(out - text.begin()));
+    }
+
+    // The SIGFPE handler is process wide. It is installed while any thread is inside trapInvalid.
+    class TrapHandler
+    {
+      private:
+        static inline std::mutex       s_mutex;
+        static inline int              s_users = 0;
+        static inline struct sigaction s_previous {};
+
+        static void onSignal(const int signal, siginfo_t* const info, void* const context)
+        {
+            if (t_trapDepth != 0 && info->si_code == FPE_FLTINV)
+            {
+                reportTrap(info->si_addr);
+                std::abort();
+            }
+
+            // not ours, hand it on
+            if ((s_previous.sa_flags & SA_SIGINFO) != 0)
+            {
+                s_previous.sa_sigaction(signal, info, context);
+            }
+            else if (s_previous.sa_handler != SIG_DFL && s_previous.sa_handler != SIG_IGN)
+            {
+                s_previous.sa_handler(signal);
+            }
+            else
+            {
+                std::signal(signal, SIG_DFL);
+                std::raise(signal);
+            }
+        }
+
+      public:
+        TrapHandler()
+        {
+            const std::scoped_lock lock {s_mutex};
+            if (s_users++ == 0)
+            {
+                struct sigaction action {};
+                action.sa_sigaction = &onSignal;
+                action.sa_flags     = SA_SIGINFO;
+                sigemptyset(&action.sa_mask);
+                sigaction(SIGFPE, &action, &s_previous);
+            }
+        }
+
+        TrapHandler(const TrapHandler&)                     = delete;
+        TrapHandler(TrapHandler&&)                          = delete;
+        auto operator= (const TrapHandler&) -> TrapHandler& = delete;
+        auto operator= (TrapHandler&&) -> TrapHandler&      = delete;
+
+        ~TrapHandler()
+        {
+            const std::scoped_lock lock {s_mutex};
+            if (--s_users == 0)
+            {
+                sigaction(SIGFPE, &s_previous, nullptr);
+            }
+        }
+    };
+
+    // Everything trapInvalid has to put back, whether function returns or throws.
+    // The whole environment is saved with fegetenv and put back with fesetenv, which also keeps FE_INVALID unmasked
+    // for an outer region. Only the flags other than FE_INVALID that function raised are added to the saved ones.
+    class TrapRegion
+    {
+      private:
+        static constexpr int KEPT_FLAGS = FE_ALL_EXCEPT & ~FE_INVALID;
+
+        TrapHandler m_handler;
+        std::fenv_t m_environment {};
+
+      public:
+        TrapRegion() noexcept
+        {
+            std::fegetenv(&m_environment);
+            ++t_guardDepth;
+            ++t_trapDepth;
+            std::feclearexcept(FE_INVALID);
+            feenableexcept(FE_INVALID);
+        }
+
+        TrapRegion(const TrapRegion&)                     = delete;
+        TrapRegion(TrapRegion&&)                          = delete;
+        auto operator= (const TrapRegion&) -> TrapRegion& = delete;
+        auto operator= (TrapRegion&&) -> TrapRegion&      = delete;
+
+        ~TrapRegion()
+        {
+            const int      raised = std::fetestexcept(KEPT_FLAGS);
+            std::fexcept_t flags {};
+            std::fegetexceptflag(&flags, raised);
+            std::fesetenv(&m_environment);
+            // sets the flags without raising them, so nothing traps here
+            std::fesetexceptflag(&flags, raised);
+            --t_trapDepth;
+            --t_guardDepth;
+        }
+    };
+
+    // The compiler moves floating point operations across the calls that change the environment, an inlined function
+    // could be computed before its exceptions are unmasked. Calling it out of line keeps it inside the region.
+    template <typename Function>
+    [[gnu::noinline]]
+    auto invokeTrapped(Function& function) -> std::invoke_result_t<Function&>
+    {
+        return std::invoke(function);
+    }
+}    // namespace detail
+
+// Runs function with invalid operations trapping, aborts with the address of the first one
+template <typename Function>
+    requires std::invocable<Function&>
+auto trapInvalid(Function&& function) -> std::invoke_result_t<Function&>
+{
+    const detail::TrapRegion region;
+    return detail::invokeTrapped(function);
+}
+}    // namespace notnan
@@ -0,0 +1,489 @@
+#pragma once
+
+#include "NotNaN.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <initializer_list>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace notnan
+{
+// Allocator handing out storage aligned for full width vector loads.
+template <typename T, std::size_t Alignment>
+struct AlignedAllocator
+{
+    static_assert(Alignment >= alignof(T) && std::has_single_bit(Alignment));
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    constexpr AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    constexpr explicit AlignedAllocator(const AlignedAllocator<U, Alignment>& /* other */) noexcept
+    {
+        // empty
+    }
+
+    [[nodiscard]]
+    auto allocate(const std::size_t count) -> T*
+    {
+        return static_cast<T*>(::operator new (count * sizeof(T), std::align_val_t {Alignment}));
+    }
+
+    void deallocate(T* const ptr, const std::size_t count) noexcept
+    {
+        ::operator delete (ptr, count * sizeof(T), std::align_val_t {Alignment});
+    }
+
+    template <typename U>
+    [[nodiscard]]
+    constexpr auto operator== (const AlignedAllocator<U, Alignment>& /* other */) const noexcept -> bool
+    {
+        return true;
+    }
+};
+}    // namespace notnan
+
+// Contiguous, vector-aligned storage of NotNaN values.
+// Element-wise arithmetic computes whole blocks with plain loops the compiler vectorizes and checks each block
+// with a single NaN scan instead of checking every element on its own.
+template <std::floating_point T>
+class NotNaNVector
+{
+  private:
+    static constexpr std::size_t ALIGNMENT = 64;
+    // elements computed before the result is scanned, small enough to still be in L1 when it is
+    static constexpr std::size_t BLOCK     = 2048 / sizeof(T);
+
+    std::vector<T, notnan::AlignedAllocator<T, ALIGNMENT>> m_values;
+
+    // The throws are kept out of line so the checks stay small in the loops that call them
+    [[noreturn, gnu::cold, gnu::noinline]]
+    static void throwSizeMismatch(const std::size_t lhs, const std::size_t rhs)
+    {
+        throw std::invalid_argument(std::format("Size mismatch: {} and {}", lhs, rhs));
+    }
+
+    [[noreturn, gnu::cold, gnu::noinline]]
+    static void throwOutOfRange(const std::size_t idx, const std::size_t size)
+    {
+        throw std::out_of_range(std::format("Index {} is out of range for size {}", idx, size));
+    }
+
+    [[noreturn, gnu::cold, gnu::noinline]]
+    static void throwNaN(const char* const what, const T value)
+    {
+        throw std::invalid_argument(std::format("{} is {}", what, value));
+    }
+
+    [[noreturn, gnu::cold, gnu::noinline]]
+    static void throwNaNResult(const T value, const std::size_t idx)
+    {
+        throw std::runtime_error(std::format("Result is {} at index {}", value, idx));
+    }
+
+    static void checkSize(const std::size_t lhs, const std::size_t rhs)
+    {
+        if (lhs != rhs) [[unlikely]]
+        {
+            throwSizeMismatch(lhs, rhs);
+        }
+    }
+
+    void checkIndex(const std::size_t idx) const
+    {
+        if (idx >= m_values.size()) [[unlikely]]
+        {
+            throwOutOfRange(idx, m_values.size());
+        }
+    }
+
+    static void checkScalar(const T& value)
+    {
+        if (notnan::isNaN(value)) [[unlikely]]
+        {
+            throwNaN("Scalar operand", value);
+        }
+    }
+
+    // out[i] = operation(lhs(i), rhs(i)) for all i, scanning every finished block for NaN.
+    // out is either fresh result storage or a scratch block, never one of the inputs.
+    template <typename Lhs, typename Rhs, typename BinaryOp>
+    static void compute(
+      T* const out, const std::size_t offset, const std::size_t count, const Lhs& lhs, const Rhs& rhs,
+      const BinaryOp& operation
+    )
+    {
+        for (std::size_t idx = 0; idx < count; ++idx)
+        {
+            out[idx] = operation(lhs(offset + idx), rhs(offset + idx));
+        }
+        const std::size_t bad = notnan::findNaN(std::span<const T> {out, count});
+        if (bad != count) [[unlikely]]
+        {
+            throwNaNResult(out[bad], offset + bad);
+        }
+    }
+
+    template <typename Lhs, typename Rhs, typename BinaryOp>
+    [[nodiscard]]
+    static auto elementWise(const std::size_t size, const Lhs& lhs, const Rhs& rhs, const BinaryOp& operation)
+      -> NotNaNVector
+    {
+        NotNaNVector result;
+        result.m_values.resize(size);
+        for (std::size_t offset = 0; offset < size; offset += BLOCK)
+        {
+            compute(result.m_values.data() + offset, offset, std::min(BLOCK, size - offset), lhs, rhs, operation);
+        }
+        return result;
+    }
+
+    // Blocks are computed into scratch space and only copied once they are known to be NaN free, so the
+    // invariant holds even if a later block throws. Earlier blocks are already updated in that case.
+    template <typename Rhs, typename BinaryOp>
+    auto elementWiseInPlace(const Rhs& rhs, const BinaryOp& operation) -> NotNaNVector&
+    {
+        alignas(ALIGNMENT) std::array<T, BLOCK> scratch;
+        const std::size_t    size = m_values.size();
+        const auto           lhs  = [this](const std::size_t idx) { return m_values[idx]; };
+        for (std::size_t offset = 0; offset < size; offset += BLOCK)
+        {
+            const std::size_t count = std::min(BLOCK, size - offset);
+            compute(scratch.data(), offset, count, lhs, rhs, operation);
+            std::copy_n(scratch.data(), count, m_values.data() + offset);
+        }
+        return *this;
+    }
+
+    [[nodiscard]]
+    auto vectorAt() const noexcept
+    {
+        return [data = m_values.data()](const std::size_t idx) { return data[idx]; };
+    }
+
+    [[nodiscard]]
+    static auto scalarAt(const T value) noexcept
+    {
+        return [value](const std::size_t /* idx */) { return value; };
+    }
+
+  public:
+    using Type           = T;
+    using value_type     = NotNaN<T>;
+    using size_type      = std::size_t;
+    using iterator       = NotNaN<T>*;
+    using const_iterator = const NotNaN<T>*;
+
+    NotNaNVector()  = default;
+    ~NotNaNVector() = default;
+
+    NotNaNVector(const std::size_t count, const NotNaN<T>& value) : m_values(count, *value)
+    {
+        // empty
+    }
+
+    NotNaNVector(const std::initializer_list<NotNaN<T>> values) : NotNaNVector(std::span {values.begin(), values.size()})
+    {
+        // empty
+    }
+
+    explicit NotNaNVector(const std::span<const NotNaN<T>> values)
+    {
+        m_values.reserve(values.size());
+        for (const NotNaN<T>& value : values)
+        {
+            m_values.push_back(*value);
+        }
+    }
+
+    // Validates the raw values with a single bulk scan
+    explicit NotNaNVector(const std::span<const T> values)
+    {
+        static_cast<void>(notnan::validate(values));
+        m_values.assign(values.begin(), values.end());
+    }
+
+    NotNaNVector(const NotNaNVector& other)                         = default;
+    NotNaNVector(NotNaNVector&& other) noexcept                     = default;
+    auto operator= (const NotNaNVector& other) -> NotNaNVector&     = default;
+    auto operator= (NotNaNVector&& other) noexcept -> NotNaNVector& = default;
+
+    // Element access
+
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t
+    {
+        return m_values.size();
+    }
+
+    [[nodiscard]]
+    auto empty() const noexcept -> bool
+    {
+        return m_values.empty();
+    }
+
+    // Raw values, for handing to code that does not know about NotNaN
+    [[nodiscard]]
+    auto data() const noexcept -> const T*
+    {
+        return m_values.data();
+    }
+
+    [[nodiscard]]
+    auto span() const noexcept -> std::span<const NotNaN<T>>
+    {
+        return {begin(), end()};
+    }
+
+    [[nodiscard]]
+    auto span() noexcept -> std::span<NotNaN<T>>
+    {
+        return {begin(), end()};
+    }
+
+    // Assigning through the returned reference checks for NaN like any other NotNaN
+    [[nodiscard]]
+    auto operator[] (const std::size_t idx) noexcept -> NotNaN<T>&
+    {
+        return begin()[idx];
+    }
+
+    [[nodiscard]]
+    auto operator[] (const std::size_t idx) const noexcept -> const NotNaN<T>&
+    {
+        return begin()[idx];
+    }
+
+    [[nodiscard]]
+    auto at(const std::size_t idx) -> NotNaN<T>&
+    {
+        checkIndex(idx);
+        return (*this)[idx];
+    }
+
+    [[nodiscard]]
+    auto at(const std::size_t idx) const -> const NotNaN<T>&
+    {
+        checkIndex(idx);
+        return (*this)[idx];
+    }
+
+    [[nodiscard]]
+    auto begin() noexcept -> iterator
+    {
+        return notnan::detail::notNaNData<notnan::ThrowPolicy>(std::span {m_values});
+    }
+
+    [[nodiscard]]
+    auto begin() const noexcept -> const_iterator
+    {
+        return notnan::detail::notNaNData<notnan::ThrowPolicy>(std::span {m_values});
+    }
+
+    [[nodiscard]]
+    auto end() noexcept -> iterator
+    {
+        return begin() + m_values.size();
+    }
+
+    [[nodiscard]]
+    auto end() const noexcept -> const_iterator
+    {
+        return begin() + m_values.size();
+    }
+
+    // Modifiers
+
+    void reserve(const std::size_t capacity)
+    {
+        m_values.reserve(capacity);
+    }
+
+    void resize(const std::size_t count, const NotNaN<T>& value)
+    {
+        m_values.resize(count, *value);
+    }
+
+    void push_back(const NotNaN<T>& value)
+    {
+        m_values.push_back(*value);
+    }
+
+    void clear() noexcept
+    {
+        m_values.clear();
+    }
+
+    // Element-wise arithmetic
+
+    // Addition
+    friend auto operator+ (const NotNaNVector& lhs, const NotNaNVector& rhs) -> NotNaNVector
+    {
+        checkSize(lhs.size(), rhs.size());
+        return elementWise(lhs.size(), lhs.vectorAt(), rhs.vectorAt(), std::plus {});
+    }
+    friend auto operator+ (const NotNaNVector& lhs, const NotNaN<T>& rhs) -> NotNaNVector
+    {
+        return elementWise(lhs.size(), lhs.vectorAt(), scalarAt(*rhs), std::plus {});
+    }
+    friend auto operator+ (const NotNaN<T>& lhs, const NotNaNVector& rhs) -> NotNaNVector
+    {
+        return elementWise(rhs.size(), scalarAt(*lhs), rhs.vectorAt(), std::plus {});
+    }
+    friend auto operator+ (const NotNaNVector& lhs, const T& rhs) -> NotNaNVector
+    {
+        checkScalar(rhs);
+        return elementWise(lhs.size(), lhs.vectorAt(), scalarAt(rhs), std::plus {});
+    }
+    friend auto operator+ (const T& lhs, const NotNaNVector& rhs) -> NotNaNVector
+    {
+        checkScalar(lhs);
+        return elementWise(rhs.size(), scalarAt(lhs), rhs.vectorAt(), std::plus {});
+    }
+    auto operator+= (const NotNaNVector& rhs) -> NotNaNVector&
+    {
+        checkSize(size(), rhs.size());
+        return elementWiseInPlace(rhs.vectorAt(), std::plus {});
+    }
+    auto operator+= (const NotNaN<T>& rhs) -> NotNaNVector&
+    {
+        return elementWiseInPlace(scalarAt(*rhs), std::plus {});
+    }
+    auto operator+= (const T& rhs) -> NotNaNVector&
+    {
+        checkScalar(rhs);
+        return elementWiseInPlace(scalarAt(rhs), std::plus {});
+    }
+
+    // Subtraction
+    friend auto operator- (const NotNaNVector& lhs, const NotNaNVector& rhs) -> NotNaNVector
+    {
+        checkSize(lhs.size(), rhs.size());
+        return elementWise(lhs.size(), lhs.vectorAt(), rhs.vectorAt(), std::minus {});
+    }
+    friend auto operator- (const NotNaNVector& lhs, const NotNaN<T>& rhs) -> NotNaNVector
+    {
+        return elementWise(lhs.size(), lhs.vectorAt(), scalarAt(*rhs), std::minus {});
+    }
+    friend auto operator- (const NotNaN<T>& lhs, const NotNaNVector& rhs) -> NotNaNVector
+    {
+        return elementWise(rhs.size(), scalarAt(*lhs), rhs.vectorAt(), std::minus {});
+    }
+    friend auto operator- (const NotNaNVector& lhs, const T& rhs) -> NotNaNVector
+    {
+        checkScalar(rhs);
+        return elementWise(lhs.size(), lhs.vectorAt(), scalarAt(rhs), std::minus {});
+    }
+    friend auto operator- (const T& lhs, const NotNaNVector& rhs) -> NotNaNVector
+    {
+        checkScalar(lhs);
+        return elementWise(rhs.size(), scalarAt(lhs), rhs.vectorAt(), std::minus {});
+    }
+    auto operator-= (const NotNaNVector& rhs) -> NotNaNVector&
+    {
+        checkSize(size(), rhs.size());
+        return elementWiseInPlace(rhs.vectorAt(), std::minus {});
+    }
+    auto operator-= (const NotNaN<T>& rhs) -> NotNaNVector&
+    {
+        return elementWiseInPlace(scalarAt(*rhs), std::minus {});
+    }
+    auto operator-= (const T& rhs) -> NotNaNVector&
+    {
+        checkScalar(rhs);
+        return elementWiseInPlace(scalarAt(rhs), std::minus {});
+    }
+
+    // Multiplication
+    friend auto operator* (const NotNaNVector& lhs, const NotNaNVector& rhs) -> NotNaNVector
+    {
+        checkSize(lhs.size(), rhs.size());
+        return elementWise(lhs.size(), lhs.vectorAt(), rhs.vectorAt(), std::multiplies {});
+    }
+    friend auto operator* (const NotNaNVector& lhs, const NotNaN<T>& rhs) -> NotNaNVector
+    {
+        return elementWise(lhs.size(), lhs.vectorAt(), scalarAt(*rhs), std::multiplies {});
+    }
+    friend auto operator* (const NotNaN<T>& lhs, const NotNaNVector& rhs) -> NotNaNVector
+    {
+        return elementWise(rhs.size(), scalarAt(*lhs), rhs.vectorAt(), std::multiplies {});
+    }
+    friend auto operator* (const NotNaNVector& lhs, const T& rhs) -> NotNaNVector
+    {
+        checkScalar(rhs);
+        return elementWise(lhs.size(), lhs.vectorAt(), scalarAt(rhs), std::multiplies {});
+    }
+    friend auto operator* (const T& lhs, const NotNaNVector& rhs) -> NotNaNVector
+    {
+        checkScalar(lhs);
+        return elementWise(rhs.size(), scalarAt(lhs), rhs.vectorAt(), std::multiplies {});
+    }
+    auto operator*= (const NotNaNVector& rhs) -> NotNaNVector&
+    {
+        checkSize(size(), rhs.size());
+        return elementWiseInPlace(rhs.vectorAt(), std::multiplies {});
+    }
+    auto operator*= (const NotNaN<T>& rhs) -> NotNaNVector&
+    {
+        return elementWiseInPlace(scalarAt(*rhs), std::multiplies {});
+    }
+    auto operator*= (const T& rhs) -> NotNaNVector&
+    {
+        checkScalar(rhs);
+        return elementWiseInPlace(scalarAt(rhs), std::multiplies {});
+    }
+
+    // Division
+    friend auto operator/ (const NotNaNVector& lhs, const NotNaNVector& rhs) -> NotNaNVector
+    {
+        checkSize(lhs.size(), rhs.size());
+        return elementWise(lhs.size(), lhs.vectorAt(), rhs.vectorAt(), std::divides {});
+    }
+    friend auto operator/ (const NotNaNVector& lhs, const NotNaN<T>& rhs) -> NotNaNVector
+    {
+        return elementWise(lhs.size(), lhs.vectorAt(), scalarAt(*rhs), std::divides {});
+    }
+    friend auto operator/ (const NotNaN<T>& lhs, const NotNaNVector& rhs) -> NotNaNVector
+    {
+        return elementWise(rhs.size(), scalarAt(*lhs), rhs.vectorAt(), std::divides {});
+    }
+    friend auto operator/ (const NotNaNVector& lhs, const T& rhs) -> NotNaNVector
+    {
+        checkScalar(rhs);
+        return elementWise(lhs.size(), lhs.vectorAt(), scalarAt(rhs), std::divides {});
+    }
+    friend auto operator/ (const T& lhs, const NotNaNVector& rhs) -> NotNaNVector
+    {
+        checkScalar(lhs);
+        return elementWise(rhs.size(), scalarAt(lhs), rhs.vectorAt(), std::divides {});
+    }
+    auto operator/= (const NotNaNVector& rhs) -> NotNaNVector&
+    {
+        checkSize(size(), rhs.size());
+        return elementWiseInPlace(rhs.vectorAt(), std::divides {});
+    }
+    auto operator/= (const NotNaN<T>& rhs) -> NotNaNVector&
+    {
+        return elementWiseInPlace(scalarAt(*rhs), std::divides {});
+    }
+    auto operator/= (const T& rhs) -> NotNaNVector&
+    {
+        checkScalar(rhs);
+        return elementWiseInPlace(scalarAt(rhs), std::divides {});
+    }
+};
@@ -0,0 +1,92 @@
+#include "../NotNaN.hpp"
+#include "../NotNaNAlgorithm.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// Summing 100M NotNaN<double>: element-wise operator+=, notnan::reduce and notnan::reduce in parallel,
+// against std::reduce over the raw values.
+
+namespace
+{
+constexpr std::size_t SIZE = 100'000'000;
+
+auto input() -> const std::vector<NotNaN<double>>&
+{
+    static const std::vector<NotNaN<double>> INPUT = []
+    {
+        std::mt19937_64                        rng {42};    // NOLINT(cert-msc32-c, cert-msc51-cpp)
+        std::uniform_real_distribution<double> dist {-1.0, 1.0};
+        std::vector<NotNaN<double>>            values;
+        values.reserve(SIZE);
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            values.emplace_back(dist(rng));
+        }
+        return values;
+    }();
+    return INPUT;
+}
+
+void elementWiseSum(benchmark::State& state)
+{
+    const auto& values = input();
+    for (auto _ : state)
+    {
+        NotNaN<double> sum {0.0};
+        for (const NotNaN<double>& value : values)
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+void reduceSum(benchmark::State& state)
+{
+    const auto& values = input();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(notnan::reduce(values));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+template <typename ExecutionPolicy>
+void reduceSumParallel(benchmark::State& state)
+{
+    const auto& values = input();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(notnan::reduce(ExecutionPolicy {}, values));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+// NotNaN<double> has the layout of double
+void rawSumParallel(benchmark::State& state)
+{
+    const auto&   values = input();
+    const double* first  = reinterpret_cast<const double*>(values.data());    // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::reduce(std::execution::par_unseq, first, first + values.size()));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+}    // namespace
+
+BENCHMARK(elementWiseSum)->Unit(benchmark::kMillisecond);
+BENCHMARK(reduceSum)->Unit(benchmark::kMillisecond);
+BENCHMARK(reduceSumParallel<std::execution::parallel_policy>)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(reduceSumParallel<std::execution::parallel_unsequenced_policy>)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(rawSumParallel)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// NOLINTEND(readability-magic-numbers)
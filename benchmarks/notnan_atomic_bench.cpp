@@ -0,0 +1,91 @@
+#include "../NotNaN.hpp"
+#include "../NotNaNAtomic.hpp"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// Accumulators shared between 1 to 64 threads: a NotNaN<double> behind a mutex, std::atomic<double> without any check
+// and AtomicNotNaN<double>. Then one accumulator per thread, next to each other and on their own cache lines.
+
+namespace
+{
+using N = NotNaN<double>;
+
+constexpr std::size_t MAX_THREADS = 64;
+
+const N ONE {1.0};
+
+void mutex(benchmark::State& state)
+{
+    static std::mutex lock;
+    static N          total {0.0};
+    for (auto _ : state)
+    {
+        const std::scoped_lock guard {lock};
+        total += ONE;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void raw(benchmark::State& state)
+{
+    static std::atomic<double> total {0.0};
+    for (auto _ : state)
+    {
+        total.fetch_add(1.0);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void atomic(benchmark::State& state)
+{
+    static AtomicNotNaN<double> total {N {0.0}};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(total.fetch_add(ONE));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void atomicMax(benchmark::State& state)
+{
+    static AtomicNotNaN<double> high {N {0.0}};
+    double                      value = 0.0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(high.fetch_max(N {value}));
+        value += 1.0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename A>
+void perThread(benchmark::State& state)
+{
+    static std::array<A, MAX_THREADS> totals = [] <std::size_t... I> (std::index_sequence<I...>)
+    {
+        return std::array<A, MAX_THREADS> {((void) I, A {N {0.0}})...};
+    }(std::make_index_sequence<MAX_THREADS> {});
+
+    A& total = totals[static_cast<std::size_t>(state.thread_index())];
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(total.fetch_add(ONE, std::memory_order_relaxed));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+}    // namespace
+
+BENCHMARK(mutex)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(raw)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(atomic)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(atomicMax)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK_TEMPLATE(perThread, AtomicNotNaN<double>)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK_TEMPLATE(perThread, PaddedAtomicNotNaN<double>)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+
+// NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,391 @@
+#include "../NotNaN.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+
+// What NotNaN<T> costs compared to T, for every operator and the common math members.
+// latency    - each operation depends on the previous result, this is the cost of one checked operation
+// throughput - independent operations over an array, this is what the checks cost in a vectorizable loop
+// Run the notnan_bench_json target to write the results to notnan_bench.json.
+
+namespace
+{
+constexpr std::size_t SIZE = 4096;
+
+// The floating point type behind W, which is either T or NotNaN<T>
+template <typename W>
+struct Raw
+{
+    using Type = W;
+};
+template <typename T>
+struct Raw<NotNaN<T>>
+{
+    using Type = T;
+};
+
+template <typename W>
+[[nodiscard]]
+auto make(const typename Raw<W>::Type value) -> W
+{
+    return W {value};
+}
+
+template <typename W>
+[[nodiscard]]
+auto makeInput(const double low, const double high) -> std::vector<W>
+{
+    std::mt19937_64                        rng {42};    // NOLINT(cert-msc32-c, cert-msc51-cpp)
+    std::uniform_real_distribution<double> dist {low, high};
+    std::vector<W>                         values;
+    values.reserve(SIZE);
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        values.push_back(make<W>(static_cast<typename Raw<W>::Type>(dist(rng))));
+    }
+    return values;
+}
+
+// Math functions for both raw and NotNaN arguments
+template <typename W>
+[[nodiscard]]
+auto sqrtOf(const W& value) -> W
+{
+    if constexpr (notnan::IsNotNaN<W>)
+    {
+        return value.sqrt();
+    }
+    else
+    {
+        return std::sqrt(value);
+    }
+}
+
+template <typename W>
+[[nodiscard]]
+auto logOf(const W& value) -> W
+{
+    if constexpr (notnan::IsNotNaN<W>)
+    {
+        return value.log();
+    }
+    else
+    {
+        return std::log(value);
+    }
+}
+
+template <typename W>
+[[nodiscard]]
+auto powOf(const W& value, const typename Raw<W>::Type exponent) -> W
+{
+    if constexpr (notnan::IsNotNaN<W>)
+    {
+        return value.pow(exponent);
+    }
+    else
+    {
+        return std::pow(value, exponent);
+    }
+}
+
+template <typename W>
+[[nodiscard]]
+auto atan2Of(const W& value, const typename Raw<W>::Type other) -> W
+{
+    if constexpr (notnan::IsNotNaN<W>)
+    {
+        return value.atan2(other);
+    }
+    else
+    {
+        return std::atan2(value, other);
+    }
+}
+
+template <typename W>
+[[nodiscard]]
+auto tgammaOf(const W& value) -> W
+{
+    if constexpr (notnan::IsNotNaN<W>)
+    {
+        return value.tgamma();
+    }
+    else
+    {
+        return std::tgamma(value);
+    }
+}
+
+// The operations, each keeps its argument in a range where it can be applied again and again.
+// INPUT is the range the throughput input is drawn from.
+struct Add
+{
+    static constexpr double INPUT[] {-1000.0, 1000.0};
+
+    template <typename W>
+    auto operator() (W value) const -> W
+    {
+        value += typename Raw<W>::Type {0.5};
+        value -= typename Raw<W>::Type {0.5};
+        return value;
+    }
+};
+
+struct Multiply
+{
+    static constexpr double INPUT[] {-1000.0, 1000.0};
+
+    template <typename W>
+    auto operator() (W value) const -> W
+    {
+        value *= typename Raw<W>::Type {1.5};
+        value /= typename Raw<W>::Type {1.5};
+        return value;
+    }
+};
+
+struct Sqrt
+{
+    static constexpr double INPUT[] {0.0, 1000.0};
+
+    template <typename W>
+    auto operator() (const W& value) const -> W
+    {
+        return sqrtOf(value) + 1;
+    }
+};
+
+struct Log
+{
+    static constexpr double INPUT[] {0.5, 1000.0};
+
+    template <typename W>
+    auto operator() (const W& value) const -> W
+    {
+        return logOf(value) + 2;
+    }
+};
+
+struct Pow
+{
+    static constexpr double INPUT[] {0.0, 1000.0};
+
+    template <typename W>
+    auto operator() (const W& value) const -> W
+    {
+        return powOf(value, typename Raw<W>::Type {0.75}) + 1;
+    }
+};
+
+struct Atan2
+{
+    static constexpr double INPUT[] {-1000.0, 1000.0};
+
+    template <typename W>
+    auto operator() (const W& value) const -> W
+    {
+        return atan2Of(value, typename Raw<W>::Type {1.5}) + 1;
+    }
+};
+
+struct Tgamma
+{
+    static constexpr double INPUT[] {0.5, 10.0};
+
+    template <typename W>
+    auto operator() (const W& value) const -> W
+    {
+        return tgammaOf(value) * typename Raw<W>::Type {0.5} + 1;
+    }
+};
+
+template <typename Operation, typename W>
+void latency(benchmark::State& state)
+{
+    W value = make<W>(1.5);
+    for (auto _ : state)
+    {
+        value = Operation {}(value);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+template <typename Operation, typename W>
+void throughput(benchmark::State& state)
+{
+    const std::vector<W> input = makeInput<W>(Operation::INPUT[0], Operation::INPUT[1]);
+    std::vector<W>       output(input);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            output[i] = Operation {}(input[i]);
+        }
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+// Checking raw values on the way in
+template <typename W>
+void construct(benchmark::State& state)
+{
+    using T                    = typename Raw<W>::Type;
+    const std::vector<W> input = makeInput<W>(-1000.0, 1000.0);
+    std::vector<T>       raw(SIZE);
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        raw[i] = static_cast<T>(input[i]);
+    }
+    std::vector<W> output(input);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            output[i] = make<W>(raw[i]);
+        }
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+template <typename W>
+void compare(benchmark::State& state)
+{
+    const std::vector<W> input     = makeInput<W>(-1000.0, 1000.0);
+    const W              threshold = make<W>(0);
+    for (auto _ : state)
+    {
+        std::size_t count = 0;
+        for (const W& value : input)
+        {
+            count += value < threshold ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+// Elements summed up in a wider type
+template <typename W, typename Accumulator>
+void mixedSum(benchmark::State& state)
+{
+    const std::vector<W> input = makeInput<W>(-1000.0, 1000.0);
+    for (auto _ : state)
+    {
+        Accumulator sum {0.0};
+        for (const W& value : input)
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+template <typename W>
+void format(benchmark::State& state)
+{
+    const std::vector<W> input = makeInput<W>(-1000.0, 1000.0);
+    std::string          text;
+    for (auto _ : state)
+    {
+        for (const W& value : input)
+        {
+            text.clear();
+            std::format_to(std::back_inserter(text), "{}", value);
+            benchmark::DoNotOptimize(text.data());
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+template <typename W>
+void streamOut(benchmark::State& state)
+{
+    const std::vector<W> input = makeInput<W>(-1000.0, 1000.0);
+    for (auto _ : state)
+    {
+        std::ostringstream stream;
+        for (const W& value : input)
+        {
+            stream << value << ' ';
+        }
+        benchmark::DoNotOptimize(stream.str().data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+template <typename W>
+void streamIn(benchmark::State& state)
+{
+    std::ostringstream text;
+    for (const W& value : makeInput<W>(-1000.0, 1000.0))
+    {
+        text << value << ' ';
+    }
+    for (auto _ : state)
+    {
+        std::istringstream stream {text.str()};
+        W                  value = make<W>(0);
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            stream >> value;
+        }
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+}    // namespace
+
+// Registers benchmark<..., T> and benchmark<..., NotNaN<T>> for all three types
+#define NOTNAN_BENCHMARK(...)                         \
+    BENCHMARK_TEMPLATE(__VA_ARGS__, float);           \
+    BENCHMARK_TEMPLATE(__VA_ARGS__, NotNaN<float>);   \
+    BENCHMARK_TEMPLATE(__VA_ARGS__, double);          \
+    BENCHMARK_TEMPLATE(__VA_ARGS__, NotNaN<double>);  \
+    BENCHMARK_TEMPLATE(__VA_ARGS__, long double);     \
+    BENCHMARK_TEMPLATE(__VA_ARGS__, NotNaN<long double>)
+
+NOTNAN_BENCHMARK(latency, Add);
+NOTNAN_BENCHMARK(throughput, Add);
+NOTNAN_BENCHMARK(latency, Multiply);
+NOTNAN_BENCHMARK(throughput, Multiply);
+NOTNAN_BENCHMARK(latency, Sqrt);
+NOTNAN_BENCHMARK(throughput, Sqrt);
+NOTNAN_BENCHMARK(latency, Log);
+NOTNAN_BENCHMARK(throughput, Log);
+NOTNAN_BENCHMARK(latency, Pow);
+NOTNAN_BENCHMARK(throughput, Pow);
+NOTNAN_BENCHMARK(latency, Atan2);
+NOTNAN_BENCHMARK(throughput, Atan2);
+NOTNAN_BENCHMARK(latency, Tgamma);
+NOTNAN_BENCHMARK(throughput, Tgamma);
+
+NOTNAN_BENCHMARK(construct);
+NOTNAN_BENCHMARK(compare);
+
+BENCHMARK_TEMPLATE(mixedSum, float, double);
+BENCHMARK_TEMPLATE(mixedSum, NotNaN<float>, NotNaN<double>);
+BENCHMARK_TEMPLATE(mixedSum, double, long double);
+BENCHMARK_TEMPLATE(mixedSum, NotNaN<double>, NotNaN<long double>);
+
+NOTNAN_BENCHMARK(format);
+NOTNAN_BENCHMARK(streamOut);
+NOTNAN_BENCHMARK(streamIn);
+
+// NOLINTEND(cppcoreguidelines-macro-usage)
+// NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,65 @@
+#include "../NotNaN.hpp"
+#include "../NotNaNBounded.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// A controller step sqrt((k * e)^2 + k) with gains in [0, 1] and errors in [-5, 5] over arrays of 64k values, on
+// double, on NotNaN<double> which checks every step, and on BoundedNotNaN whose bounds prove all of them NaN-free.
+
+namespace
+{
+constexpr std::size_t SIZE = std::size_t {1} << 16;
+
+template <typename T>
+auto fill(const double lo, const double hi, const std::uint64_t seed) -> std::vector<T>
+{
+    std::mt19937_64                        rng {seed};
+    std::uniform_real_distribution<double> dist {lo, hi};
+    std::vector<T>                         values;
+    values.reserve(SIZE);
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        values.emplace_back(dist(rng));
+    }
+    return values;
+}
+
+template <typename Gain, typename Error, typename Result>
+void control(benchmark::State& state)
+{
+    const auto          gains  = fill<Gain>(0.0, 1.0, 1);
+    const auto          errors = fill<Error>(-5.0, 5.0, 2);
+    std::vector<Result> out(SIZE, Result {0.0});
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            const auto response = gains[i] * errors[i];
+            if constexpr (std::same_as<Gain, double>)
+            {
+                out[i] = std::sqrt(response * response + gains[i]);
+            }
+            else
+            {
+                out[i] = Result {(response * response + gains[i]).sqrt()};
+            }
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+}    // namespace
+
+BENCHMARK_TEMPLATE(control, double, double, double);
+BENCHMARK_TEMPLATE(control, NotNaN<double>, NotNaN<double>, NotNaN<double>);
+BENCHMARK_TEMPLATE(control, BoundedNotNaN<double, 0, 1>, BoundedNotNaN<double, -5, 5>, NotNaN<double>);
+
+// NOLINTEND(readability-magic-numbers)
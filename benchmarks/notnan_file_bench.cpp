@@ -0,0 +1,198 @@
+#include "../NotNaN.hpp"
+#include "../NotNaNFile.hpp"
+#include "../NotNaNVector.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <thread>
+#include <span>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// Loading a grid of 4M doubles saved by an earlier stage: reading the raw values and validating every one of them
+// against mapping a binary array file, trusting the header, checking the checksum, and scanning for NaN.
+// Then mapping the raw values with LazyNotNaNView: opening, touching a few random values, and a sequential scan with
+// and without background validation.
+
+#if __has_include(<sys/mman.h>)
+namespace
+{
+constexpr std::size_t SIZE = std::size_t {1} << 22;
+
+auto grid() -> const std::vector<NotNaN<double>>&
+{
+    static const std::vector<NotNaN<double>> VALUES = []
+    {
+        std::mt19937_64                        rng {42};    // NOLINT(cert-msc32-c, cert-msc51-cpp)
+        std::uniform_real_distribution<double> dist {-1000.0, 1000.0};
+        std::vector<NotNaN<double>>            result;
+        result.reserve(SIZE);
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            result.emplace_back(dist(rng));
+        }
+        return result;
+    }();
+    return VALUES;
+}
+
+auto rawFile() -> const std::filesystem::path&
+{
+    static const std::filesystem::path PATH = []
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "notnan_file_bench.raw";
+        std::ofstream         file {path, std::ios::binary | std::ios::trunc};
+        const auto            bytes = std::as_bytes(std::span {grid()});
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return path;
+    }();
+    return PATH;
+}
+
+auto arrayFile() -> const std::filesystem::path&
+{
+    static const std::filesystem::path PATH = []
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "notnan_file_bench.nnan";
+        notnan::writeArray(path, grid());
+        return path;
+    }();
+    return PATH;
+}
+
+void setCounters(benchmark::State& state)
+{
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * SIZE * sizeof(double)));
+}
+
+void readAndValidate(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::vector<double> raw(SIZE);
+        std::ifstream       file {rawFile(), std::ios::binary};
+        file.read(reinterpret_cast<char*>(raw.data()), static_cast<std::streamsize>(SIZE * sizeof(double)));
+        const NotNaNVector<double> values {std::span<const double> {raw}};
+        benchmark::DoNotOptimize(values.data());
+    }
+    setCounters(state);
+}
+
+void mapArray(benchmark::State& state)
+{
+    const auto verification = static_cast<notnan::Verification>(state.range(0));
+    for (auto _ : state)
+    {
+        const notnan::MappedArray<double> values {arrayFile(), verification};
+        benchmark::DoNotOptimize(values.values().data());
+    }
+    setCounters(state);
+}
+
+void mapArrayAndSum(benchmark::State& state)
+{
+    const auto verification = static_cast<notnan::Verification>(state.range(0));
+    for (auto _ : state)
+    {
+        const notnan::MappedArray<double> values {arrayFile(), verification};
+        double                            sum = 0;
+        for (const NotNaN<double>& value : values)
+        {
+            sum += *value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters(state);
+}
+void mapRawAndValidate(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        const notnan::MappedFile file {rawFile()};
+        benchmark::DoNotOptimize(notnan::validate(file.values<double>()).data());
+    }
+    setCounters(state);
+}
+
+void lazyOpen(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        const notnan::MappedFile             file {rawFile()};
+        const notnan::LazyNotNaNView<double> values {file.values<double>()};
+        benchmark::DoNotOptimize(values[SIZE / 2]);
+    }
+}
+
+void lazyTouchRandom(benchmark::State& state)
+{
+    const auto                                 touches = static_cast<std::size_t>(state.range(0));
+    std::mt19937_64                            rng {42};    // NOLINT(cert-msc32-c, cert-msc51-cpp)
+    std::uniform_int_distribution<std::size_t> dist {0, SIZE - 1};
+    std::vector<std::size_t>                   indices(touches);
+    for (std::size_t& idx : indices)
+    {
+        idx = dist(rng);
+    }
+
+    for (auto _ : state)
+    {
+        const notnan::MappedFile             file {rawFile()};
+        const notnan::LazyNotNaNView<double> values {file.values<double>()};
+        double                               sum = 0;
+        for (const std::size_t idx : indices)
+        {
+            sum += *values[idx];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void lazyScan(benchmark::State& state)
+{
+    const bool prefetch = state.range(0) != 0;
+    for (auto _ : state)
+    {
+        const notnan::MappedFile                                file {rawFile()};
+        const notnan::LazyNotNaNView<double>                    values {file.values<double>()};
+        std::optional<notnan::LazyNotNaNView<double>::Prefetch> background;
+        if (prefetch)
+        {
+            background.emplace(values.prefetch());
+        }
+        double sum = 0;
+        for (const NotNaN<double>& value : values)
+        {
+            sum += *value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters(state);
+}
+}    // namespace
+
+BENCHMARK(readAndValidate)->Unit(benchmark::kMillisecond);
+BENCHMARK(mapArray)
+  ->ArgName("verification")
+  ->Arg(static_cast<int>(notnan::Verification::Header))
+  ->Arg(static_cast<int>(notnan::Verification::Checksum))
+  ->Arg(static_cast<int>(notnan::Verification::Full))
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK(mapArrayAndSum)
+  ->ArgName("verification")
+  ->Arg(static_cast<int>(notnan::Verification::Header))
+  ->Arg(static_cast<int>(notnan::Verification::Full))
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK(mapRawAndValidate)->Unit(benchmark::kMillisecond);
+BENCHMARK(lazyOpen)->Unit(benchmark::kMicrosecond);
+BENCHMARK(lazyTouchRandom)->Arg(10)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(lazyScan)->ArgName("prefetch")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+#endif
+
+// NOLINTEND(readability-magic-numbers)
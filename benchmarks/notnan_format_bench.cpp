@@ -0,0 +1,92 @@
+#include "../NotNaN.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// Writing 250k values as text: ostream << NotNaN and std::format per value against the span formatter and
+// notnan::writeDelimited.
+
+namespace
+{
+constexpr std::size_t SIZE = 250'000;
+
+auto values() -> const std::vector<NotNaN<double>>&
+{
+    static const std::vector<NotNaN<double>> VALUES = []
+    {
+        std::mt19937_64                        rng {42};    // NOLINT(cert-msc32-c, cert-msc51-cpp)
+        std::uniform_real_distribution<double> dist {-1000.0, 1000.0};
+        std::vector<NotNaN<double>>            result;
+        result.reserve(SIZE);
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            result.emplace_back(dist(rng));
+        }
+        return result;
+    }();
+    return VALUES;
+}
+
+void streamValues(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::ostringstream stream;
+        for (const NotNaN<double>& value : values())
+        {
+            stream << value << ',';
+        }
+        benchmark::DoNotOptimize(stream.str().data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+void formatValues(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::string text;
+        for (const NotNaN<double>& value : values())
+        {
+            std::format_to(std::back_inserter(text), "{},", value);
+        }
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+void formatSpan(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::format("{}", std::span {values()}).data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+void writeDelimited(benchmark::State& state)
+{
+    std::vector<char> buffer(SIZE * (notnan::MAX_CHARS<double> + 1));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(notnan::writeDelimited(buffer, values()).ptr);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+}    // namespace
+
+BENCHMARK(streamValues)->Unit(benchmark::kMillisecond);
+BENCHMARK(formatValues)->Unit(benchmark::kMillisecond);
+BENCHMARK(formatSpan)->Unit(benchmark::kMillisecond);
+BENCHMARK(writeDelimited)->Unit(benchmark::kMillisecond);
+
+// NOLINTEND(readability-magic-numbers)
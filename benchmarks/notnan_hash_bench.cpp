@@ -0,0 +1,162 @@
+#include "../NotNaN.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// Looking up 64k keys on a grid of 1/8 steps, whose low mantissa bits are all zero: std::unordered_map and a
+// linear probing flat map keyed by NotNaN<double> against the raw double and the bit_cast to std::uint64_t used as
+// keys without it.
+
+namespace
+{
+constexpr std::size_t SIZE = std::size_t {1} << 16;
+
+auto keys() -> const std::vector<double>&
+{
+    static const std::vector<double> KEYS = []
+    {
+        std::vector<double> result(SIZE);
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            result[i] = static_cast<double>(i) / 8;
+        }
+        std::mt19937_64 rng {42};    // NOLINT(cert-msc32-c, cert-msc51-cpp)
+        std::ranges::shuffle(result, rng);
+        return result;
+    }();
+    return KEYS;
+}
+
+// Linear probing with a power of two capacity and no erase, the usual layout of open addressing maps.
+// Only the low bits of the hash pick the slot.
+template <typename Key, typename Hash = std::hash<Key>>
+class FlatMap
+{
+  private:
+    struct Slot
+    {
+        Key  key;
+        int  value;
+        bool used;
+    };
+
+    std::vector<Slot> m_slots;
+    std::size_t       m_mask;
+
+  public:
+    FlatMap(const std::size_t size, const Key& empty)
+        : m_slots(std::bit_ceil(2 * size), Slot {empty, 0, false}), m_mask {m_slots.size() - 1}
+    {
+        // empty
+    }
+
+    void insert(const Key& key, const int value)
+    {
+        for (std::size_t idx = Hash {}(key) & m_mask;; idx = (idx + 1) & m_mask)
+        {
+            Slot& slot = m_slots[idx];
+            if (!slot.used)
+            {
+                slot.key   = key;
+                slot.value = value;
+                slot.used  = true;
+                return;
+            }
+            if (slot.key == key)
+            {
+                slot.value = value;
+                return;
+            }
+        }
+    }
+
+    [[nodiscard]]
+    auto find(const Key& key) const -> const int*
+    {
+        for (std::size_t idx = Hash {}(key) & m_mask;; idx = (idx + 1) & m_mask)
+        {
+            const Slot& slot = m_slots[idx];
+            if (!slot.used)
+            {
+                return nullptr;
+            }
+            if (slot.key == key)
+            {
+                return &slot.value;
+            }
+        }
+    }
+};
+
+// The keys as double, NotNaN<double> or their bits
+template <typename Key>
+auto toKey(const double value) -> Key
+{
+    if constexpr (std::same_as<Key, std::uint64_t>)
+    {
+        // +0.0 and -0.0 have to be merged by hand
+        return std::bit_cast<std::uint64_t>(value == 0.0 ? 0.0 : value);
+    }
+    else
+    {
+        return Key {value};
+    }
+}
+
+template <typename Key>
+void unorderedMap(benchmark::State& state)
+{
+    std::unordered_map<Key, int> map;
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        map.emplace(toKey<Key>(keys()[i]), static_cast<int>(i));
+    }
+    for (auto _ : state)
+    {
+        int sum = 0;
+        for (const double key : keys())
+        {
+            sum += map.find(toKey<Key>(key))->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+template <typename Key>
+void flatMap(benchmark::State& state)
+{
+    FlatMap<Key> map {SIZE, toKey<Key>(0.0)};
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        map.insert(toKey<Key>(keys()[i]), static_cast<int>(i));
+    }
+    for (auto _ : state)
+    {
+        int sum = 0;
+        for (const double key : keys())
+        {
+            sum += *map.find(toKey<Key>(key));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+}    // namespace
+
+BENCHMARK_TEMPLATE(unorderedMap, double);
+BENCHMARK_TEMPLATE(unorderedMap, std::uint64_t);
+BENCHMARK_TEMPLATE(unorderedMap, NotNaN<double>);
+BENCHMARK_TEMPLATE(flatMap, double);
+BENCHMARK_TEMPLATE(flatMap, std::uint64_t);
+BENCHMARK_TEMPLATE(flatMap, NotNaN<double>);
+
+// NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,141 @@
+#include "../NotNaN.hpp"
+#include "../NotNaNMath.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// exp, log, sin and cos over arrays of 64k values: std:: on double, the NotNaN member which checks every result, and
+// the span functions of NotNaNMath.hpp which check the domain of a block at once.
+
+namespace
+{
+constexpr std::size_t SIZE = std::size_t {1} << 16;
+
+enum class Function : std::uint8_t
+{
+    Exp,
+    Log,
+    Sin,
+    Cos,
+};
+
+template <typename T>
+auto fill(const Function function) -> std::vector<NotNaN<T>>
+{
+    const double                           lo = function == Function::Log ? 1e-3 : -100.0;
+    std::mt19937_64                        rng {1};
+    std::uniform_real_distribution<double> dist {lo, 100.0};
+    std::vector<NotNaN<T>>                 values;
+    values.reserve(SIZE);
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        values.emplace_back(static_cast<T>(dist(rng)));
+    }
+    return values;
+}
+
+template <typename T>
+auto apply(const Function function, const T x) -> T
+{
+    switch (function)
+    {
+        case Function::Exp: return std::exp(x);
+        case Function::Log: return std::log(x);
+        case Function::Sin: return std::sin(x);
+        case Function::Cos: return std::cos(x);
+    }
+    return x;
+}
+
+template <typename T>
+auto apply(const Function function, const NotNaN<T> x) -> NotNaN<T>
+{
+    switch (function)
+    {
+        case Function::Exp: return x.exp();
+        case Function::Log: return x.log();
+        case Function::Sin: return x.sin();
+        case Function::Cos: return x.cos();
+    }
+    return x;
+}
+
+template <typename T>
+void apply(const Function function, const std::span<const NotNaN<T>> values, const std::span<NotNaN<T>> results)
+{
+    switch (function)
+    {
+        case Function::Exp: notnan::exp(values, results); break;
+        case Function::Log: notnan::log(values, results); break;
+        case Function::Sin: notnan::sin(values, results); break;
+        case Function::Cos: notnan::cos(values, results); break;
+    }
+}
+
+template <typename T>
+void raw(benchmark::State& state)
+{
+    const auto     function = static_cast<Function>(state.range(0));
+    const auto     values   = fill<T>(function);
+    std::vector<T> out(SIZE);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            out[i] = apply(function, *values[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+template <typename T>
+void member(benchmark::State& state)
+{
+    const auto             function = static_cast<Function>(state.range(0));
+    const auto             values   = fill<T>(function);
+    std::vector<NotNaN<T>> out(SIZE, NotNaN<T> {T {0}});
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            out[i] = apply(function, values[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+template <typename T>
+void batched(benchmark::State& state)
+{
+    const auto             function = static_cast<Function>(state.range(0));
+    const auto             values   = fill<T>(function);
+    std::vector<NotNaN<T>> out(SIZE, NotNaN<T> {T {0}});
+    for (auto _ : state)
+    {
+        apply(function, std::span<const NotNaN<T>> {values}, std::span<NotNaN<T>> {out});
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+}    // namespace
+
+// the argument is the function: 0 exp, 1 log, 2 sin, 3 cos
+BENCHMARK_TEMPLATE(raw, double)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(member, double)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(batched, double)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(raw, float)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(member, float)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(batched, float)->DenseRange(0, 3);
+
+// NOLINTEND(readability-magic-numbers)
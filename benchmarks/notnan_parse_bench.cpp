@@ -0,0 +1,95 @@
+#include "../NotNaN.hpp"
+#include "../NotNaNParse.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <format>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// Reading a CSV table of 250k rows with 4 columns: istream >> NotNaN against notnan::parse and notnan::parseColumns.
+
+namespace
+{
+constexpr std::size_t ROWS    = 250'000;
+constexpr std::size_t COLUMNS = 4;
+
+auto table() -> const std::string&
+{
+    static const std::string TEXT = []
+    {
+        std::mt19937_64                        rng {42};    // NOLINT(cert-msc32-c, cert-msc51-cpp)
+        std::uniform_real_distribution<double> dist {-1000.0, 1000.0};
+        std::string                            text;
+        for (std::size_t row = 0; row < ROWS; ++row)
+        {
+            text += std::format("{},{},{},{}\n", dist(rng), dist(rng), dist(rng), dist(rng));
+        }
+        return text;
+    }();
+    return TEXT;
+}
+
+void setCounters(benchmark::State& state)
+{
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * ROWS * COLUMNS));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * table().size()));
+}
+
+void streamTable(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::istringstream          stream {table()};
+        std::vector<NotNaN<double>> values;
+        NotNaN<double>              value {0.0};
+        char                        delimiter = 0;
+        while (stream >> value)
+        {
+            values.push_back(value);
+            stream >> delimiter;
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+    setCounters(state);
+}
+
+void parseTable(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(notnan::parse<double>(table()).data());
+    }
+    setCounters(state);
+}
+
+void parseColumnsTable(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(notnan::parseColumns<double>(table()).data());
+    }
+    setCounters(state);
+}
+
+void parseColumnsTableParallel(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(notnan::parseColumns<double>(std::execution::par, table()).data());
+    }
+    setCounters(state);
+}
+}    // namespace
+
+BENCHMARK(streamTable)->Unit(benchmark::kMillisecond);
+BENCHMARK(parseTable)->Unit(benchmark::kMillisecond);
+BENCHMARK(parseColumnsTable)->Unit(benchmark::kMillisecond);
+BENCHMARK(parseColumnsTableParallel)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// NOLINTEND(readability-magic-numbers)
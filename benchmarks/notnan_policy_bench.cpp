@@ -0,0 +1,160 @@
+#include "../NotNaN.hpp"
+#include "../NotNaNGuard.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// What each check policy costs on a reduction and on math members, compared to the raw type.
+
+namespace
+{
+constexpr std::size_t SIZE = 1U << 16U;
+
+auto makeInput() -> const std::vector<double>&
+{
+    static const std::vector<double> INPUT = []
+    {
+        std::mt19937_64                        rng {42};    // NOLINT(cert-msc32-c, cert-msc51-cpp)
+        std::uniform_real_distribution<double> dist {0.5, 2.0};
+        std::vector<double>                    values(SIZE);
+        for (double& value : values)
+        {
+            value = dist(rng);
+        }
+        return values;
+    }();
+    return INPUT;
+}
+
+void rawSum(benchmark::State& state)
+{
+    const auto& input = makeInput();
+    for (auto _ : state)
+    {
+        double sum = 0.0;
+        for (const double value : input)
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+template <typename Policy>
+void policySum(benchmark::State& state)
+{
+    const auto& input = makeInput();
+    for (auto _ : state)
+    {
+        NotNaN<double, Policy> sum {0.0};
+        for (const double value : input)
+        {
+            static_cast<void>(sum += value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+// Sum of values that are already NotNaN, so only the results need checking
+template <typename Policy>
+void checkedSum(benchmark::State& state)
+{
+    const std::vector<NotNaN<double, Policy>> input(makeInput().begin(), makeInput().end());
+    for (auto _ : state)
+    {
+        NotNaN<double, Policy> sum {0.0};
+        for (const auto& value : input)
+        {
+            static_cast<void>(sum += value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+void guardedSum(benchmark::State& state)
+{
+    using N = NotNaN<double, notnan::HardwarePolicy>;
+    const std::vector<N> input(makeInput().begin(), makeInput().end());
+    for (auto _ : state)
+    {
+        const N total = notnan::guarded(
+          [&input]
+          {
+              N sum {0.0};
+              for (const auto& value : input)
+              {
+                  sum += value;
+              }
+              return sum;
+          }
+        );
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+void rawSqrt(benchmark::State& state)
+{
+    const auto& input = makeInput();
+    for (auto _ : state)
+    {
+        double sum = 0.0;
+        for (const double value : input)
+        {
+            sum += std::sqrt(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+template <typename Policy>
+void policySqrt(benchmark::State& state)
+{
+    const auto& input = makeInput();
+    for (auto _ : state)
+    {
+        double sum = 0.0;
+        for (const double value : input)
+        {
+            const auto root = NotNaN<double, Policy> {value}.sqrt();
+            if constexpr (std::same_as<typename Policy::template Result<int>, int>)
+            {
+                sum += *root;
+            }
+            else
+            {
+                sum += **root;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+}    // namespace
+
+BENCHMARK(rawSum);
+BENCHMARK(policySum<notnan::ThrowPolicy>);
+BENCHMARK(policySum<notnan::TerminatePolicy>);
+BENCHMARK(policySum<notnan::ExpectedPolicy>);
+BENCHMARK(policySum<notnan::AssertPolicy>);
+BENCHMARK(policySum<notnan::UncheckedPolicy>);
+
+BENCHMARK(checkedSum<notnan::ThrowPolicy>);
+BENCHMARK(checkedSum<notnan::UncheckedPolicy>);
+BENCHMARK(guardedSum);
+
+BENCHMARK(rawSqrt);
+BENCHMARK(policySqrt<notnan::ThrowPolicy>);
+BENCHMARK(policySqrt<notnan::TerminatePolicy>);
+BENCHMARK(policySqrt<notnan::ExpectedPolicy>);
+BENCHMARK(policySqrt<notnan::AssertPolicy>);
+BENCHMARK(policySqrt<notnan::UncheckedPolicy>);
+
+// NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,86 @@
+#include "../NotNaN.hpp"
+#include "../NotNaNRefined.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// A blend w * a + (1 - w) * b followed by sqrt(|x| + |y|) over arrays of 64k values, on double, on NotNaN<double>
+// which checks every step, and on refined types (UnitInterval weights, Finite samples) which check none of them.
+
+namespace
+{
+constexpr std::size_t SIZE = std::size_t {1} << 16;
+
+template <typename T>
+auto fill(const double lo, const double hi, const std::uint64_t seed) -> std::vector<T>
+{
+    std::mt19937_64                        rng {seed};
+    std::uniform_real_distribution<double> dist {lo, hi};
+    std::vector<T>                         values;
+    values.reserve(SIZE);
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        values.emplace_back(dist(rng));
+    }
+    return values;
+}
+
+template <typename Weight, typename Sample, typename Result>
+void blend(benchmark::State& state)
+{
+    const auto          weights = fill<Weight>(0.0, 1.0, 1);
+    const auto          lhs     = fill<Sample>(-1e3, 1e3, 2);
+    const auto          rhs     = fill<Sample>(-1e3, 1e3, 3);
+    const Weight        one {1.0};
+    std::vector<Result> out(SIZE, Result {0.0});
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            out[i] = Result {weights[i] * lhs[i] + (one - weights[i]) * rhs[i]};
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+template <typename Sample, typename Result>
+void magnitude(benchmark::State& state)
+{
+    const auto          lhs = fill<Sample>(-1e3, 1e3, 2);
+    const auto          rhs = fill<Sample>(-1e3, 1e3, 3);
+    std::vector<Result> out(SIZE, Result {0.0});
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            if constexpr (std::same_as<Sample, double>)
+            {
+                out[i] = std::sqrt(std::abs(lhs[i]) + std::abs(rhs[i]));
+            }
+            else
+            {
+                out[i] = Result {(lhs[i].abs() + rhs[i].abs()).sqrt()};
+            }
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+}    // namespace
+
+BENCHMARK_TEMPLATE(blend, double, double, double);
+BENCHMARK_TEMPLATE(blend, NotNaN<double>, NotNaN<double>, NotNaN<double>);
+BENCHMARK_TEMPLATE(blend, notnan::UnitInterval<double>, notnan::Finite<double>, NotNaN<double>);
+BENCHMARK_TEMPLATE(magnitude, double, double);
+BENCHMARK_TEMPLATE(magnitude, NotNaN<double>, NotNaN<double>);
+BENCHMARK_TEMPLATE(magnitude, notnan::Finite<double>, notnan::NonNegative<double>);
+
+// NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,114 @@
+#include "../NotNaN.hpp"
+#include "../NotNaNSimd.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <experimental/simd>
+#include <random>
+#include <span>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// sqrt(x * x + b) over arrays of 64k values: NotNaN one value at a time, std::experimental::simd without checks and
+// NotNaNSimd, which checks each operation with one test of the mask. Both at the native width of the target and twice
+// that, which is a fixed size simd.
+
+namespace
+{
+constexpr std::size_t SIZE = std::size_t {1} << 16;
+
+template <typename T>
+constexpr std::size_t NATIVE = std::experimental::native_simd<T>::size();
+
+template <typename T>
+auto fill() -> std::vector<NotNaN<T>>
+{
+    std::mt19937_64                        rng {1};
+    std::uniform_real_distribution<double> dist {-100.0, 100.0};
+    std::vector<NotNaN<T>>                 values;
+    values.reserve(SIZE);
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        values.emplace_back(static_cast<T>(dist(rng)));
+    }
+    return values;
+}
+
+template <typename T>
+void scalar(benchmark::State& state)
+{
+    const auto             values = fill<T>();
+    const NotNaN<T>        bias {T {1}};
+    std::vector<NotNaN<T>> out(SIZE, bias);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            out[i] = (values[i] * values[i] + bias).sqrt();
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+template <typename T, std::size_t LANES>
+void raw(benchmark::State& state)
+{
+    using Simd = notnan::detail::SimdOf<T, LANES>;
+
+    std::vector<T> values;
+    for (const NotNaN<T> value : fill<T>())
+    {
+        values.push_back(*value);
+    }
+    const Simd     bias {T {1}};
+    std::vector<T> out(SIZE);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < SIZE; i += LANES)
+        {
+            const Simd x {&values[i], std::experimental::element_aligned};
+            std::experimental::sqrt(x * x + bias).copy_to(&out[i], std::experimental::element_aligned);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+template <typename T, std::size_t LANES>
+void simd(benchmark::State& state)
+{
+    using S = NotNaNSimd<T, LANES>;
+
+    const auto             values = fill<T>();
+    const S                bias {NotNaN<T> {T {1}}};
+    std::vector<NotNaN<T>> out(SIZE, NotNaN<T> {T {0}});
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < SIZE; i += LANES)
+        {
+            const S x {std::span<const NotNaN<T>> {values}.subspan(i, LANES)};
+            (x * x + bias).sqrt().store(std::span<NotNaN<T>> {out}.subspan(i, LANES));
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+}    // namespace
+
+BENCHMARK_TEMPLATE(scalar, float);
+BENCHMARK_TEMPLATE(raw, float, NATIVE<float>);
+BENCHMARK_TEMPLATE(simd, float, NATIVE<float>);
+BENCHMARK_TEMPLATE(raw, float, 2 * NATIVE<float>);
+BENCHMARK_TEMPLATE(simd, float, 2 * NATIVE<float>);
+BENCHMARK_TEMPLATE(scalar, double);
+BENCHMARK_TEMPLATE(raw, double, NATIVE<double>);
+BENCHMARK_TEMPLATE(simd, double, NATIVE<double>);
+BENCHMARK_TEMPLATE(raw, double, 2 * NATIVE<double>);
+BENCHMARK_TEMPLATE(simd, double, 2 * NATIVE<double>);
+
+// NOLINTEND(readability-magic-numbers)
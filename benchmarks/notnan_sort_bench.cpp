@@ -0,0 +1,141 @@
+#include "../NotNaN.hpp"
+#include "../NotNaNAlgorithm.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <random>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// Sorting 10M NotNaN<float> and NotNaN<double>: std::sort and std::stable_sort with the comparison operators
+// against notnan::radixSort, sequential and in parallel, and notnan::radixSortByKey against std::stable_sort of pairs.
+
+namespace
+{
+constexpr std::size_t SIZE = 10'000'000;
+
+template <typename T>
+auto input() -> const std::vector<NotNaN<T>>&
+{
+    static const std::vector<NotNaN<T>> INPUT = []
+    {
+        std::mt19937_64                   rng {42};    // NOLINT(cert-msc32-c, cert-msc51-cpp)
+        std::uniform_real_distribution<T> dist {-1e6, 1e6};
+        std::vector<NotNaN<T>>            values;
+        values.reserve(SIZE);
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            values.emplace_back(dist(rng));
+        }
+        return values;
+    }();
+    return INPUT;
+}
+
+// Sorts a fresh copy of the input every iteration, the copy is not timed
+template <typename T, typename Sort>
+void sortCopies(benchmark::State& state, const Sort& sort)
+{
+    std::vector<NotNaN<T>> values;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        values = input<T>();
+        state.ResumeTiming();
+        sort(values);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+template <typename T>
+void stdSort(benchmark::State& state)
+{
+    sortCopies<T>(state, [](std::vector<NotNaN<T>>& values) { std::sort(values.begin(), values.end()); });
+}
+
+template <typename T>
+void stdStableSort(benchmark::State& state)
+{
+    sortCopies<T>(state, [](std::vector<NotNaN<T>>& values) { std::stable_sort(values.begin(), values.end()); });
+}
+
+template <typename T>
+void stdSortParallel(benchmark::State& state)
+{
+    sortCopies<T>(
+      state, [](std::vector<NotNaN<T>>& values) { std::sort(std::execution::par, values.begin(), values.end()); }
+    );
+}
+
+template <typename T>
+void radixSort(benchmark::State& state)
+{
+    sortCopies<T>(state, [](std::vector<NotNaN<T>>& values) { notnan::radixSort(values); });
+}
+
+template <typename T>
+void radixSortParallel(benchmark::State& state)
+{
+    sortCopies<T>(state, [](std::vector<NotNaN<T>>& values) { notnan::radixSort(std::execution::par, values); });
+}
+
+void stableSortPairs(benchmark::State& state)
+{
+    struct Pair
+    {
+        NotNaN<double> key;
+        std::uint32_t  value;
+    };
+
+    std::vector<Pair> pairs;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        pairs.clear();
+        for (const NotNaN<double>& key : input<double>())
+        {
+            pairs.push_back({key, static_cast<std::uint32_t>(pairs.size())});
+        }
+        state.ResumeTiming();
+        std::ranges::stable_sort(pairs, {}, &Pair::key);
+        benchmark::DoNotOptimize(pairs.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+void radixSortByKey(benchmark::State& state)
+{
+    std::vector<NotNaN<double>> keys;
+    std::vector<std::uint32_t>  values(SIZE);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        keys = input<double>();
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            values[i] = static_cast<std::uint32_t>(i);
+        }
+        state.ResumeTiming();
+        notnan::radixSortByKey(keys, values);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+}    // namespace
+
+BENCHMARK(stdSort<float>)->Unit(benchmark::kMillisecond);
+BENCHMARK(stdStableSort<float>)->Unit(benchmark::kMillisecond);
+BENCHMARK(radixSort<float>)->Unit(benchmark::kMillisecond);
+BENCHMARK(stdSort<double>)->Unit(benchmark::kMillisecond);
+BENCHMARK(stdStableSort<double>)->Unit(benchmark::kMillisecond);
+BENCHMARK(radixSort<double>)->Unit(benchmark::kMillisecond);
+BENCHMARK(stdSortParallel<double>)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(radixSortParallel<double>)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(stableSortPairs)->Unit(benchmark::kMillisecond);
+BENCHMARK(radixSortByKey)->Unit(benchmark::kMillisecond);
+
+// NOLINTEND(readability-magic-numbers)
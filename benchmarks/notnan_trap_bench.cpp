@@ -0,0 +1,82 @@
+#include <cfenv>
+
+#if defined(__linux__) && defined(__GLIBC__)
+
+#include "../NotNaN.hpp"
+#include "../NotNaNTrap.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// Trapping invalid operations against the branch after each operation, on a dot product of 10M elements.
+
+namespace
+{
+constexpr std::size_t SIZE = 10'000'000;
+
+template <typename Policy, std::uint64_t SEED>
+auto makeInput() -> const std::vector<NotNaN<double, Policy>>&
+{
+    static const std::vector<NotNaN<double, Policy>> INPUT = []
+    {
+        std::mt19937_64                        rng {SEED};
+        std::uniform_real_distribution<double> dist {-1.0, 1.0};
+        std::vector<NotNaN<double, Policy>>    values;
+        values.reserve(SIZE);
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            values.emplace_back(dist(rng));
+        }
+        return values;
+    }();
+    return INPUT;
+}
+
+template <typename Policy>
+auto dot(const std::vector<NotNaN<double, Policy>>& lhs, const std::vector<NotNaN<double, Policy>>& rhs)
+  -> NotNaN<double, Policy>
+{
+    NotNaN<double, Policy> sum {0.0};
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        sum += lhs[i] * rhs[i];
+    }
+    return sum;
+}
+
+template <typename Policy>
+void branchDot(benchmark::State& state)
+{
+    const auto& lhs = makeInput<Policy, 1>();
+    const auto& rhs = makeInput<Policy, 2>();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(dot(lhs, rhs));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+
+void trappedDot(benchmark::State& state)
+{
+    using Policy    = notnan::HardwarePolicy;
+    const auto& lhs = makeInput<Policy, 1>();
+    const auto& rhs = makeInput<Policy, 2>();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(notnan::trapInvalid([&] { return dot(lhs, rhs); }));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * SIZE));
+}
+}    // namespace
+
+BENCHMARK(branchDot<notnan::ThrowPolicy>)->Unit(benchmark::kMillisecond);
+BENCHMARK(branchDot<notnan::UncheckedPolicy>)->Unit(benchmark::kMillisecond);
+BENCHMARK(trappedDot)->Unit(benchmark::kMillisecond);
+
+// NOLINTEND(readability-magic-numbers)
+
+#endif
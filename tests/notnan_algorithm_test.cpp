@@ -0,0 +1,309 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include "../NotNaNAlgorithm.hpp"
+#include "../NotNaNVector.hpp"
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <exception>
+#include <execution>
+#include <format>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <stdexcept>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+namespace
+{
+// Small integers, so that every order of summation is exact even for float
+template <typename N>
+auto iota(const std::size_t size) -> std::vector<N>
+{
+    std::vector<N> values;
+    values.reserve(size);
+    for (std::size_t i = 1; i <= size; ++i)
+    {
+        values.emplace_back(static_cast<typename N::Type>(i % 8));
+    }
+    return values;
+}
+
+template <typename T>
+auto expectedSum(const std::size_t size) -> T
+{
+    T sum = 0;
+    for (std::size_t i = 1; i <= size; ++i)
+    {
+        sum += static_cast<T>(i % 8);
+    }
+    return sum;
+}
+}    // namespace
+
+TEMPLATE_TEST_CASE("Reductions", "[NotNaN][Algorithm]", float, double, long double)
+{
+    using N = NotNaN<TestType>;
+
+    for (const std::size_t size : {std::size_t {0}, std::size_t {1}, std::size_t {17}, std::size_t {200'000}})
+    {
+        const std::vector<N> values = iota<N>(size);
+        const TestType       sum    = expectedSum<TestType>(size);
+
+        REQUIRE(*notnan::reduce(values) == sum);
+        REQUIRE(*notnan::reduce(std::execution::seq, values) == sum);
+        REQUIRE(*notnan::reduce(std::execution::par_unseq, values) == sum);
+        REQUIRE(*notnan::reduce(std::span<const N> {values}) == sum);
+
+        REQUIRE(*notnan::dot(values, values) == *notnan::dot(std::execution::par, values, values));
+        REQUIRE(*notnan::norm2(values) == *notnan::norm2(std::execution::par_unseq, values));
+    }
+
+    const std::vector<N> values {N {3}, N {-4}, N {1}, N {-4}, N {2}};
+    REQUIRE(*notnan::dot(values, values) == 46);
+    REQUIRE(*notnan::norm2(std::vector<N> {N {3}, N {4}}) == 5);
+
+    REQUIRE(notnan::minElement(values) == values.begin() + 1);
+    REQUIRE(notnan::minElement(std::execution::par_unseq, values) == values.begin() + 1);
+    REQUIRE(notnan::maxElement(values) == values.begin());
+    REQUIRE(notnan::maxElement(std::execution::par_unseq, values) == values.begin());
+
+    const std::vector<N> empty;
+    REQUIRE(notnan::minElement(empty) == empty.end());
+    REQUIRE(notnan::maxElement(std::execution::par, empty) == empty.end());
+
+    // NotNaNVector is a NotNaNRange as well
+    const NotNaNVector<TestType> vector {N {1}, N {2}, N {3}};
+    REQUIRE(*notnan::reduce(std::execution::par_unseq, vector) == 6);
+    REQUIRE(*notnan::maxElement(vector) == 3);
+}
+
+TEMPLATE_TEST_CASE("Reductions producing NaN", "[NotNaN][Algorithm]", float, double, long double)
+{
+    using N            = NotNaN<TestType>;
+    constexpr auto inf = std::numeric_limits<TestType>::infinity();
+
+    // inf and -inf end up in different parallel blocks and only meet in the final sum
+    std::vector<N> values = iota<N>(200'000);
+    values.front()        = inf;
+    values.back()         = -inf;
+    REQUIRE_THROWS_AS(notnan::reduce(values), std::runtime_error);
+    REQUIRE_THROWS_AS(notnan::reduce(std::execution::par_unseq, values), std::runtime_error);
+
+    // inf * 0
+    std::vector<N> zeros(values.size(), N {0});
+    REQUIRE_THROWS_AS(notnan::dot(values, zeros), std::runtime_error);
+    REQUIRE_THROWS_AS(notnan::dot(std::execution::par, zeros, values), std::runtime_error);
+
+    // the norm of infinite values is infinite, not NaN
+    REQUIRE(*notnan::norm2(std::execution::par_unseq, values) == inf);
+
+    zeros.pop_back();
+    REQUIRE_THROWS_AS(notnan::dot(values, zeros), std::invalid_argument);
+    REQUIRE_THROWS_AS(notnan::dot(std::execution::par_unseq, values, zeros), std::invalid_argument);
+}
+
+TEST_CASE("Reductions under other policies", "[NotNaN][Algorithm]")
+{
+    constexpr double inf = std::numeric_limits<double>::infinity();
+
+    using E                  = NotNaN<double, notnan::ExpectedPolicy>;
+    const std::vector<E> bad = {E {inf}, E {1}, E {-inf}};
+    const std::span<const E> first {bad.data(), 2};
+    const auto               result = notnan::reduce(std::execution::par_unseq, bad);
+    const auto               good   = notnan::dot(std::execution::seq, first, first);
+    REQUIRE_FALSE(result.has_value());
+    REQUIRE(result.error() == notnan::NaNError {notnan::Operation::Reduce, notnan::Operand::Result});
+    REQUIRE(*good.value() == inf);
+
+    // norm2 can't fail, but returns the same Result as the other reductions
+    STATIC_REQUIRE(std::same_as<decltype(notnan::norm2(bad)), std::remove_const_t<decltype(result)>>);
+    STATIC_REQUIRE(std::same_as<decltype(notnan::norm2(std::execution::par, bad)), std::remove_const_t<decltype(result)>>);
+    REQUIRE(*notnan::norm2(std::vector<E> {E {3}, E {4}}).value() == 5);
+
+    using U = NotNaN<double, notnan::UncheckedPolicy>;
+    REQUIRE(*notnan::reduce(std::vector<U> {U {1}, U {2}}) == 3);
+}
+
+TEMPLATE_TEST_CASE("Parallel transform and forEach", "[NotNaN][Algorithm]", float, double, long double)
+{
+    using N                     = NotNaN<TestType>;
+    const std::vector<N> values = iota<N>(10'000);
+
+    SECTION("results")
+    {
+        std::vector<N> out(values.size(), N {0});
+        const auto     end = notnan::transform(
+          std::execution::par_unseq, values, out.begin(), [](const N& value) { return value * 2 + 1; }
+        );
+        REQUIRE(end == out.end());
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            REQUIRE(*out[i] == *values[i] * 2 + 1);
+        }
+
+        std::atomic<std::size_t> count {0};
+        notnan::forEach(std::execution::par, values, [&count](const N& /* value */) { ++count; });
+        REQUIRE(count == values.size());
+    }
+
+    SECTION("the lowest failure is thrown on the calling thread")
+    {
+        // 0 / 0 for every element that is 0, the lowest one is at index 7, under every policy
+        std::vector<N> out(values.size(), N {0});
+        const auto     divide = [](const N& value) { return value / value; };
+        try
+        {
+            static_cast<void>(notnan::transform(std::execution::par_unseq, values, out.begin(), divide));
+            FAIL("no error");
+        }
+        catch (const notnan::ElementError& error)
+        {
+            REQUIRE(error.index() == 7);
+            REQUIRE(std::string {error.what()}.find(std::format("at index {}", error.index())) != std::string::npos);
+            REQUIRE_THROWS_AS(std::rethrow_exception(error.cause()), std::runtime_error);
+        }
+
+        // sequenced, so the failure is the first one and nothing after it runs
+        std::atomic<std::size_t> count {0};
+        try
+        {
+            notnan::forEach(
+              values,
+              [&count](const N& value)
+              {
+                  static_cast<void>(value / value);
+                  ++count;
+              }
+            );
+            FAIL("no error");
+        }
+        catch (const notnan::ElementError& error)
+        {
+            REQUIRE(error.index() == 7);
+            REQUIRE(count == 7);
+        }
+
+        REQUIRE_THROWS_AS(notnan::transform(values, out.begin(), divide), notnan::ElementError);
+    }
+}
+
+TEMPLATE_TEST_CASE("Radix sort", "[NotNaN][Algorithm]", float, double)
+{
+    using N = NotNaN<TestType>;
+    using L = std::numeric_limits<TestType>;
+
+    // special values, and sizes below, at and above the parallel blocks
+    for (const std::size_t size : {std::size_t {0}, std::size_t {1}, std::size_t {1000}, std::size_t {1'000'000}})
+    {
+        std::mt19937_64                          rng {size};
+        std::uniform_real_distribution<TestType> dist {-1e6, 1e6};
+        std::vector<N>                           values;
+        values.reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            values.emplace_back(dist(rng));
+        }
+        if (size >= 1000)
+        {
+            const std::array specials {L::infinity(), -L::infinity(), L::max(), L::lowest(), L::min(), -L::min(),
+                                       L::denorm_min(), -L::denorm_min(), TestType {0}, TestType {-0.0}, TestType {1}};
+            for (std::size_t i = 0; i < specials.size(); ++i)
+            {
+                values[i * 37] = N {specials[i]};
+            }
+        }
+
+        std::vector<N> expected = values;
+        std::ranges::stable_sort(expected);
+
+        std::vector<N> sorted = values;
+        notnan::radixSort(sorted);
+        REQUIRE(std::ranges::equal(sorted, expected));
+
+        sorted = values;
+        notnan::radixSort(std::execution::par_unseq, sorted);
+        REQUIRE(std::ranges::equal(sorted, expected));
+
+        // -0.0 before +0.0, bit for bit
+        if (size >= 1000)
+        {
+            const auto zero = std::ranges::find(sorted, N {0});
+            REQUIRE(std::signbit(**zero));
+            REQUIRE_FALSE(std::signbit(*zero[1]));
+        }
+    }
+
+    NotNaNVector<TestType> vector {N {3}, N {-1}, N {2}};
+    notnan::radixSort(vector);
+    REQUIRE(*vector[0] == -1);
+    REQUIRE(*vector[2] == 3);
+}
+
+TEMPLATE_TEST_CASE("Radix sort by key", "[NotNaN][Algorithm]", float, double)
+{
+    using N = NotNaN<TestType>;
+
+    for (const std::size_t size : {std::size_t {0}, std::size_t {1000}, std::size_t {1'000'000}})
+    {
+        // few distinct keys, so that stability shows
+        std::vector<N>           keys;
+        std::vector<std::string> values;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            keys.emplace_back(static_cast<TestType>(static_cast<long long>((i * 7919) % 101) - 50));
+            values.push_back(std::to_string(i));
+        }
+
+        std::vector<std::size_t> order(size);
+        std::iota(order.begin(), order.end(), std::size_t {0});
+        std::ranges::stable_sort(order, std::less {}, [&keys](const std::size_t idx) { return keys[idx]; });
+        std::vector<N>           expectedKeys;
+        std::vector<std::string> expectedValues;
+        for (const std::size_t idx : order)
+        {
+            expectedKeys.push_back(keys[idx]);
+            expectedValues.push_back(values[idx]);
+        }
+
+        for (const bool parallel : {false, true})
+        {
+            std::vector<N>           sortedKeys   = keys;
+            std::vector<std::string> sortedValues = values;
+            if (parallel)
+            {
+                notnan::radixSortByKey(std::execution::par, sortedKeys, sortedValues);
+            }
+            else
+            {
+                notnan::radixSortByKey(sortedKeys, sortedValues);
+            }
+            REQUIRE(sortedKeys == expectedKeys);
+            REQUIRE(sortedValues == expectedValues);
+        }
+    }
+
+    std::vector<N>   keys(3, N {1});
+    std::vector<int> values(2);
+    REQUIRE_THROWS_AS(notnan::radixSortByKey(keys, values), std::invalid_argument);
+}
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,193 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include "../NotNaNAtomic.hpp"
+#include "../NotNaNGuard.hpp"
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+namespace
+{
+template <typename T>
+concept HasAtomic = requires { typename AtomicNotNaN<T>; };
+}    // namespace
+
+TEMPLATE_TEST_CASE("Atomic operations", "[NotNaN][Atomic]", float, double)
+{
+    using N = NotNaN<TestType>;
+
+    STATIC_REQUIRE(AtomicNotNaN<TestType>::is_always_lock_free);
+    STATIC_REQUIRE(alignof(PaddedAtomicNotNaN<TestType>) == notnan::detail::CACHE_LINE_SIZE);
+    STATIC_REQUIRE(sizeof(PaddedAtomicNotNaN<TestType>) == notnan::detail::CACHE_LINE_SIZE);
+
+    AtomicNotNaN<TestType> value {N {1}};
+    REQUIRE(value.is_lock_free());
+    REQUIRE(value.load() == 1);
+    value.store(N {2}, std::memory_order_release);
+    REQUIRE(value.load(std::memory_order_acquire) == 2);
+    REQUIRE(value.exchange(N {3}) == 2);
+
+    // a failed compare and exchange gives the current value
+    N expected {1};
+    REQUIRE_FALSE(value.compare_exchange_strong(expected, N {4}));
+    REQUIRE(expected == 3);
+    REQUIRE(value.compare_exchange_strong(expected, N {4}, std::memory_order_acq_rel));
+    while (!value.compare_exchange_weak(expected, N {5}))
+    {
+        REQUIRE(expected == 4);
+    }
+    REQUIRE(value.load() == 5);
+
+    // compared by their bits like std::atomic
+    value.store(N {0.0});
+    expected = N {-0.0};
+    REQUIRE_FALSE(value.compare_exchange_strong(expected, N {1}));
+    REQUIRE_FALSE(std::signbit(*expected));
+
+    REQUIRE(value.fetch_add(N {1.5}) == 0);
+    REQUIRE(value.fetch_sub(N {0.5}, std::memory_order_relaxed) == 1.5);
+    REQUIRE(value.load() == 1);
+
+    REQUIRE(value.fetch_max(N {3}) == 1);
+    REQUIRE(value.fetch_max(N {2}) == 3);
+    REQUIRE(value.fetch_min(N {-1}, std::memory_order_release) == 3);
+    REQUIRE(value.fetch_min(N {0}) == -1);
+    REQUIRE(value.load() == -1);
+
+    PaddedAtomicNotNaN<TestType> padded {N {1}};
+    REQUIRE(padded.fetch_add(N {1}) == 1);
+    REQUIRE(padded.load() == 2);
+}
+
+TEMPLATE_TEST_CASE("Atomic NaN updates", "[NotNaN][Atomic]", float, double)
+{
+    constexpr TestType inf = std::numeric_limits<TestType>::infinity();
+
+    // nothing is stored
+    using N = NotNaN<TestType>;
+    AtomicNotNaN<TestType> value {N {inf}};
+    REQUIRE_THROWS_AS(value.fetch_add(N {-inf}), std::runtime_error);
+    REQUIRE_THROWS_AS(value.fetch_sub(N {inf}), std::runtime_error);
+    REQUIRE(value.load() == inf);
+    REQUIRE(value.fetch_add(N {inf}) == inf);
+
+    // also when the policy otherwise checks results later
+    using H = NotNaN<TestType, notnan::HardwarePolicy>;
+    AtomicNotNaN<TestType, notnan::HardwarePolicy> hardware {H {inf}};
+    REQUIRE_THROWS_AS(hardware.fetch_add(H {-inf}), std::runtime_error);
+    REQUIRE(hardware.load() == inf);
+
+    using E = NotNaN<TestType, notnan::ExpectedPolicy>;
+    AtomicNotNaN<TestType, notnan::ExpectedPolicy> expected {E {inf}};
+    const auto difference = expected.fetch_sub(E {inf});
+    REQUIRE(difference.error() == notnan::NaNError {notnan::Operation::Subtract, notnan::Operand::Result});
+    REQUIRE(expected.load() == inf);
+    REQUIRE(*expected.fetch_add(E {1}) == inf);
+
+    // without checks the NaN is stored
+    using U = NotNaN<TestType, notnan::UncheckedPolicy>;
+    AtomicNotNaN<TestType, notnan::UncheckedPolicy> unchecked {U {inf}};
+    REQUIRE(unchecked.fetch_add(U {-inf}) == inf);
+    REQUIRE(std::isnan(*unchecked.load()));
+}
+
+TEST_CASE("Atomic contention", "[NotNaN][Atomic]")
+{
+    using N = NotNaN<double>;
+    constexpr std::size_t THREADS = 8;
+    constexpr std::size_t UPDATES = 10'000;
+
+    AtomicNotNaN<double> sum {N {0}};
+    AtomicNotNaN<double> high {N {0}};
+    AtomicNotNaN<double> low {N {0}};
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t thread = 0; thread < THREADS; ++thread)
+        {
+            threads.emplace_back(
+              [&, thread]
+              {
+                  for (std::size_t i = 0; i < UPDATES; ++i)
+                  {
+                      const N value {static_cast<double>(thread * UPDATES + i)};
+                      sum.fetch_add(N {1});
+                      high.fetch_max(value, std::memory_order_relaxed);
+                      low.fetch_min(-value, std::memory_order_relaxed);
+                  }
+              }
+            );
+        }
+    }
+    REQUIRE(sum.load() == THREADS * UPDATES);
+    REQUIRE(high.load() == THREADS * UPDATES - 1);
+    REQUIRE(low.load() == -(THREADS * UPDATES - 1.0));
+
+    // one thread adds inf, the others -inf, whichever comes second is refused, no thread ever sees NaN
+    constexpr double     inf = std::numeric_limits<double>::infinity();
+    AtomicNotNaN<double> total {N {0}};
+    std::atomic<bool>    sawNaN {false};
+    {
+        std::vector<std::jthread> threads;
+        threads.emplace_back(
+          [&]
+          {
+              try
+              {
+                  total.fetch_add(N {inf});
+              }
+              catch (const std::runtime_error&)
+              {
+                  // refused, a -inf thread got there first
+              }
+          }
+        );
+        for (std::size_t thread = 1; thread < THREADS; ++thread)
+        {
+            threads.emplace_back(
+              [&]
+              {
+                  for (std::size_t i = 0; i < UPDATES; ++i)
+                  {
+                      try
+                      {
+                          total.fetch_add(N {-inf});
+                      }
+                      catch (const std::runtime_error&)
+                      {
+                          // refused
+                      }
+                      sawNaN = sawNaN || std::isnan(*total.load());
+                  }
+              }
+            );
+        }
+    }
+    REQUIRE_FALSE(sawNaN);
+    REQUIRE_FALSE(std::isnan(*total.load()));
+}
+
+TEST_CASE("Atomic types", "[NotNaN][Atomic]")
+{
+    STATIC_REQUIRE(HasAtomic<float>);
+    STATIC_REQUIRE(HasAtomic<double>);
+    STATIC_REQUIRE(HasAtomic<long double> == std::atomic<long double>::is_always_lock_free);
+}
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#pragma GCC diagnostic pop
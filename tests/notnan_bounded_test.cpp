@@ -0,0 +1,291 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include "../NotNaNBounded.hpp"
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <compare>
+#include <expected>
+#include <format>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+namespace
+{
+template <typename N>
+concept HasAddAssign = requires (N& lhs, const N& rhs) { lhs += rhs; };
+
+template <typename N>
+concept HasMultiplyAssign = requires (N& lhs, const N& rhs) { lhs *= rhs; };
+
+// A result has to be within the bounds, and may only be NaN where the bounds say that it is checked
+template <typename T, typename Describe>
+void verifyBounds(
+  const notnan::detail::Interval<T> bounds, const T result, const Describe& describe, const char* operation
+)
+{
+    if (std::isnan(result) ? !bounds.check : (result < bounds.lo || bounds.hi < result))
+    {
+        FAIL(std::format(
+          "{} gives {}, bounds are [{}, {}], check {}", describe(operation), result, bounds.lo, bounds.hi, bounds.check
+        ));
+    }
+}
+}    // namespace
+
+TEMPLATE_TEST_CASE("Bounded result types", "[NotNaN][Bounded]", float, double, long double)
+{
+    using L = std::numeric_limits<TestType>;
+    using N = NotNaN<TestType>;
+
+    using Unit     = BoundedNotNaN<TestType, 0, 1>;
+    using Error    = BoundedNotNaN<TestType, -5, 5>;
+    using Positive = BoundedNotNaN<TestType, 0, L::infinity()>;
+
+    STATIC_REQUIRE(std::same_as<Unit, BoundedNotNaN<TestType, 0.0, 1.0>>);
+    STATIC_REQUIRE(std::same_as<Unit, BoundedNotNaN<TestType, -0.0, 1>>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<Unit>() * std::declval<Error>()), Error>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<Unit>() + std::declval<Error>()), BoundedNotNaN<TestType, -5, 6>>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<Unit>() - std::declval<Unit>()), BoundedNotNaN<TestType, -1, 1>>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<Error>() / std::declval<BoundedNotNaN<TestType, 2, 4>>()), BoundedNotNaN<TestType, -2.5, 2.5>>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<Error>() / std::declval<Unit>()), N>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<Positive>() + std::declval<Positive>()), Positive>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<Positive>() * std::declval<Positive>()), Positive>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<Error>() + std::declval<N>()), N>);
+    STATIC_REQUIRE(std::same_as<decltype(-std::declval<Unit>()), BoundedNotNaN<TestType, -1, 0>>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<Error>().abs()), BoundedNotNaN<TestType, 0, 5>>);
+
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<Unit>().sqrt()), Unit>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<BoundedNotNaN<TestType, 4, 9>>().sqrt()), BoundedNotNaN<TestType, 2, 3>>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<Error>().sin()), BoundedNotNaN<TestType, -1, 1>>);
+    STATIC_REQUIRE(decltype(std::declval<Unit>().acos())::LOWER == 0);
+    STATIC_REQUIRE(decltype(std::declval<Unit>().asin())::LOWER == 0);
+    STATIC_REQUIRE(decltype(std::declval<Unit>().asin())::UPPER >= std::numbers::pi_v<TestType> / 2);
+    STATIC_REQUIRE(decltype(std::declval<BoundedNotNaN<TestType, 1, 2>>().log())::LOWER == 0);
+    STATIC_REQUIRE(decltype(std::declval<Unit>().log())::UPPER == 0);
+    STATIC_REQUIRE(decltype(std::declval<Unit>().log())::LOWER == -L::infinity());
+
+    // in place only where no check is needed and the bounds are kept
+    STATIC_REQUIRE(HasMultiplyAssign<Unit>);
+    STATIC_REQUIRE_FALSE(HasAddAssign<Unit>);
+    STATIC_REQUIRE(HasAddAssign<Positive>);
+    STATIC_REQUIRE_FALSE(HasMultiplyAssign<Error>);
+
+    // widening is implicit, narrowing explicit
+    STATIC_REQUIRE(std::is_convertible_v<Unit, Error>);
+    STATIC_REQUIRE(std::is_convertible_v<Unit, N>);
+    STATIC_REQUIRE_FALSE(std::is_convertible_v<Error, Unit>);
+    STATIC_REQUIRE(std::is_constructible_v<Unit, Error>);
+    STATIC_REQUIRE(sizeof(Unit) == sizeof(TestType));
+
+    // only operations that may still fail go through the policy's result type
+    using E = BoundedNotNaN<TestType, -1, 1, notnan::ExpectedPolicy>;
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<E>() * std::declval<E>()), E>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<E>().sqrt()), std::expected<BoundedNotNaN<TestType, 0, 1, notnan::ExpectedPolicy>, notnan::NaNError>>);
+}
+
+TEMPLATE_TEST_CASE("Bounded values", "[NotNaN][Bounded]", float, double, long double)
+{
+    using L = std::numeric_limits<TestType>;
+    using N = NotNaN<TestType>;
+
+    using Unit     = BoundedNotNaN<TestType, 0, 1>;
+    using Error    = BoundedNotNaN<TestType, -5, 5>;
+    using Positive = BoundedNotNaN<TestType, 0, L::infinity()>;
+
+    const Unit  gain {0.5};
+    const Error error {-3};
+    REQUIRE(*(gain * error) == -1.5);
+    REQUIRE(*(gain * gain).sqrt() == 0.5);
+    REQUIRE(*(gain + notnan::constant<TestType {1}>).log() == std::log(TestType {1.5}));
+    REQUIRE(*Unit {1}.acos() == 0);
+    REQUIRE(*Unit {1}.asin() == std::asin(TestType {1}));
+    REQUIRE(std::format("{}", gain) == "0.5");
+
+    Unit decay {1};
+    for (int i = 0; i < 3; ++i)
+    {
+        decay *= gain;
+    }
+    REQUIRE(*decay == 0.125);
+
+    // the checks that are left report through the policy
+    const Positive inf {L::infinity()};
+    REQUIRE(*(inf + inf) == L::infinity());
+    REQUIRE_THROWS_AS(inf - inf, std::runtime_error);
+    REQUIRE_THROWS_AS(Positive {0} * inf, std::runtime_error);
+    REQUIRE_THROWS_AS(gain / Unit {0} * Unit {0}, std::runtime_error);
+    REQUIRE_THROWS_AS(error.sqrt(), std::invalid_argument);
+    REQUIRE_THROWS_AS(Error {2}.asin(), std::invalid_argument);
+    REQUIRE(*Error {0.25}.sqrt() == 0.5);
+    REQUIRE(*(error / Unit {-0.0}) == L::infinity());
+
+    using E = BoundedNotNaN<TestType, -1, 1, notnan::ExpectedPolicy>;
+    REQUIRE(E {-1}.sqrt().error() == notnan::NaNError {notnan::Operation::Sqrt, notnan::Operand::Result});
+
+    // construction checks NaN and the bounds through the policy
+    REQUIRE_THROWS_AS(Unit {L::quiet_NaN()}, std::invalid_argument);
+    REQUIRE_THROWS_AS(Unit {1.5}, std::invalid_argument);
+    REQUIRE_THROWS_AS(Unit {N {-1}}, std::invalid_argument);
+    REQUIRE_THROWS_AS(Unit {error}, std::invalid_argument);
+    REQUIRE(*Unit {Error {0.5}} == 0.5);
+    REQUIRE(*Unit {-0.0} == 0);
+    try
+    {
+        static_cast<void>(Error {6});
+        FAIL("no error");
+    }
+    catch (const std::invalid_argument& error)
+    {
+        REQUIRE(std::string {error.what()} == "6 is not in [-5, 5]");
+    }
+
+    REQUIRE(*Unit::fromValue(0.5) == 0.5);
+    REQUIRE_THROWS_WITH(Unit::fromValue(2), "2 is not in [0, 1]");
+    REQUIRE_THROWS_AS(Unit::fromValue(L::quiet_NaN()), std::invalid_argument);
+    REQUIRE(Unit::tryFromValue(0.5).has_value());
+    REQUIRE_FALSE(Unit::tryFromValue(2).has_value());
+    REQUIRE_FALSE(Unit::tryFromValue(L::quiet_NaN()).has_value());
+
+    // other policies get the error of a bad constructor argument
+    using EU                     = BoundedNotNaN<TestType, 0, 1, notnan::ExpectedPolicy>;
+    constexpr notnan::NaNError BAD {notnan::Operation::Construct, notnan::Operand::Value};
+    REQUIRE(*EU::fromValue(0.5).value() == 0.5);
+    REQUIRE(EU::fromValue(2).error() == BAD);
+    REQUIRE(EU::fromValue(L::quiet_NaN()).error() == BAD);
+    REQUIRE(*BoundedNotNaN<TestType, 0, 1, notnan::UncheckedPolicy>::fromValue(2) == 2);
+
+    // comparisons
+    REQUIRE(gain == Error {0.5});
+    REQUIRE(((gain <=> error) == std::strong_ordering::greater));
+    REQUIRE(N {0.5} == gain);
+    REQUIRE(gain < 1);
+    REQUIRE_THROWS_AS(gain < L::quiet_NaN(), std::invalid_argument);
+}
+
+// a * b - c contracted into a fused multiply-add skips the rounding of a * b, the bounds have to hold for it as well
+TEST_CASE("Bounds under contraction", "[NotNaN][Bounded]")
+{
+    const auto difference = (notnan::constant<0.1> * notnan::constant<0.1>) - notnan::constant<0.010000000000000002>;
+    using Difference      = std::remove_cvref_t<decltype(difference)>;
+    const double fused    = std::fma(0.1, 0.1, -0.010000000000000002);
+
+    REQUIRE(fused < 0);
+    STATIC_REQUIRE(Difference::LOWER < 0);
+    REQUIRE(Difference::LOWER <= fused);
+    REQUIRE(fused <= Difference::UPPER);
+    REQUIRE(*difference.sqrt() == 0);
+    REQUIRE_THROWS_AS(Difference {fused}.sqrt(), std::invalid_argument);
+}
+
+// The bounds of every operation, checked against the results of values on and inside them
+TEMPLATE_TEST_CASE("Bounds propagation", "[NotNaN][Bounded]", float, double, long double)
+{
+    using L        = std::numeric_limits<TestType>;
+    using Interval = notnan::detail::Interval<TestType>;
+
+    const std::vector<TestType> ends {-L::infinity(), L::lowest(), -2, -1, 0, 0.5, 1, 3, L::max(), L::infinity()};
+    std::vector<TestType>       samples = ends;
+    for (const TestType sample : {-1.5, -0.3, -0.0, 0.7, 1.5})
+    {
+        samples.push_back(sample);
+    }
+    samples.push_back(-L::denorm_min());
+    samples.push_back(L::denorm_min());
+    samples.push_back(L::min());
+
+    std::vector<Interval> intervals;
+    for (const TestType lo : ends)
+    {
+        for (const TestType hi : ends)
+        {
+            if (lo <= hi)
+            {
+                intervals.push_back({lo, hi});
+            }
+        }
+    }
+    const auto inside = [&samples](const Interval interval)
+    {
+        std::vector<TestType> result;
+        for (const TestType sample : samples)
+        {
+            if (interval.lo <= sample && sample <= interval.hi)
+            {
+                result.push_back(sample);
+            }
+        }
+        return result;
+    };
+
+    for (const Interval x : intervals)
+    {
+        const auto describe = [&x](const char* operation)
+        { return std::format("{} of [{}, {}]", operation, x.lo, x.hi); };
+        for (const TestType a : inside(x))
+        {
+            verifyBounds(notnan::detail::negateBounds(x), -a, describe, "negation");
+            verifyBounds(notnan::detail::absBounds(x), std::abs(a), describe, "abs");
+            verifyBounds(notnan::detail::sqrtBounds(x), std::sqrt(a), describe, "sqrt");
+            verifyBounds(notnan::detail::logBounds(x), std::log(a), describe, "log");
+            verifyBounds(notnan::detail::asinBounds(x), std::asin(a), describe, "asin");
+            verifyBounds(notnan::detail::acosBounds(x), std::acos(a), describe, "acos");
+            verifyBounds(notnan::detail::trigBounds(x), std::sin(a), describe, "sin");
+            verifyBounds(notnan::detail::trigBounds(x), std::cos(a), describe, "cos");
+        }
+
+        for (const Interval y : intervals)
+        {
+            const Interval sum        = notnan::detail::addBounds(x, y);
+            const Interval difference = notnan::detail::subtractBounds(x, y);
+            const Interval product    = notnan::detail::multiplyBounds(x, y);
+            const Interval quotient   = notnan::detail::divideBounds(x, y);
+            const auto     describe   = [&x, &y](const char* operation)
+            { return std::format("{} of [{}, {}] and [{}, {}]", operation, x.lo, x.hi, y.lo, y.hi); };
+            for (const TestType a : inside(x))
+            {
+                for (const TestType b : inside(y))
+                {
+                    verifyBounds(sum, a + b, describe, "addition");
+                    verifyBounds(difference, a - b, describe, "subtraction");
+                    verifyBounds(product, a * b, describe, "multiplication");
+                    verifyBounds(quotient, a / b, describe, "division");
+                }
+            }
+        }
+    }
+
+    // rounded bounds are moved outward by an ulp, exact ones are kept
+    const TestType third = TestType {1} / 3;
+    const Interval thirds {third, third};
+    REQUIRE(notnan::detail::multiplyBounds(thirds, Interval {3, 3}).hi == std::nextafter(third * 3, L::infinity()));
+    REQUIRE(notnan::detail::multiplyBounds(thirds, Interval {3, 3}).lo == std::nextafter(third * 3, -L::infinity()));
+    REQUIRE(notnan::detail::divideBounds(Interval {1, 1}, Interval {3, 3}).hi > third);
+    REQUIRE(notnan::detail::addBounds(thirds, Interval {1, 1}).lo < third + 1);
+    REQUIRE(notnan::detail::multiplyBounds(Interval {-5, 0.5}, Interval {0.25, 3}).lo == -15);
+    REQUIRE(notnan::detail::divideBounds(Interval {-5, 5}, Interval {2, 4}).hi == 2.5);
+    REQUIRE(notnan::detail::addBounds(Interval {0.5, 1}, Interval {0.25, 3}).hi == 4);
+
+    // sqrt of exact squares is exact, the others are widened
+    REQUIRE(notnan::detail::sqrtBounds(Interval {4, 9}).lo == 2);
+    REQUIRE(notnan::detail::sqrtBounds(Interval {2, 2}).lo < std::sqrt(TestType {2}));
+    REQUIRE(notnan::detail::sqrtBounds(Interval {2, 2}).hi > std::sqrt(TestType {2}));
+}
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#pragma GCC diagnostic pop
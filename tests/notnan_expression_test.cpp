@@ -0,0 +1,73 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include "../NotNaNExpression.hpp"
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+TEMPLATE_TEST_CASE("Lazy expressions", "[NotNaN][Expression]", float, double, long double)
+{
+    constexpr TestType INF = std::numeric_limits<TestType>::infinity();
+    constexpr TestType NaN = std::numeric_limits<TestType>::quiet_NaN();
+
+    const NotNaN<TestType> a {2.0};
+    const NotNaN<TestType> b {3.0};
+    const NotNaN<TestType> c {8.0};
+    const NotNaN<TestType> d {4.0};
+    const NotNaN<TestType> e {1.0};
+
+    SECTION("Same result as the eager operators")
+    {
+        const NotNaN<TestType> eager = a * b + c / d - e;
+        const NotNaN<TestType> lazy  = notnan::lazy(a) * b + c / d - e;
+        REQUIRE(*lazy == *eager);
+
+        const NotNaN<TestType> mixed = TestType {2.0} * (notnan::lazy(a) - 1) / b;
+        REQUIRE(*mixed == TestType {2.0} * (*a - 1) / *b);
+        REQUIRE(*(notnan::lazy(a) + b).eval() == TestType {5.0});
+    }
+    SECTION("Operators build nodes instead of NotNaN")
+    {
+        const auto expr = notnan::lazy(a) * b;
+        REQUIRE(notnan::expression::Node<decltype(expr)>);
+        REQUIRE(notnan::expression::Node<decltype(a + expr)>);
+        REQUIRE(std::same_as<decltype(a + b), NotNaN<TestType>>);
+    }
+    SECTION("Assignment evaluates")
+    {
+        NotNaN<TestType> x {0.0};
+        x = notnan::lazy(a) + b;
+        REQUIRE(*x == TestType {5.0});
+        REQUIRE_THROWS(x = notnan::lazy(x) * 0.0 * INF);
+        REQUIRE(*x == TestType {5.0});
+    }
+    SECTION("Produced NaN is reported with its sub-expression")
+    {
+        const NotNaN<TestType> inf {INF};
+        const auto             expr = notnan::lazy(a) * b + (notnan::lazy(inf) - inf) / d;
+        REQUIRE_THROWS_AS(expr.eval(), std::runtime_error);
+        REQUIRE_THROWS_WITH(expr.eval(), Catch::Matchers::ContainsSubstring("Result of (inf - inf) is NaN"));
+    }
+    SECTION("NaN operand is reported")
+    {
+        const auto expr = notnan::lazy(a) + NaN;
+        REQUIRE_THROWS_AS(expr.eval(), std::invalid_argument);
+        REQUIRE_THROWS_WITH(expr.eval(), Catch::Matchers::ContainsSubstring("Operand nan is NaN"));
+    }
+}
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#pragma GCC diagnostic pop
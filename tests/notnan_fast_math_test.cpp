@@ -0,0 +1,131 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+// These tests are also built as notnan_test_fast_math with -ffast-math, where std::isnan may be folded to false.
+// NaN is only ever produced at run time here, the compiler is allowed to assume it does not exist.
+
+#include "../NotNaN.hpp"
+#include "../NotNaNVector.hpp"
+#if __has_include(<experimental/simd>)
+#include "../NotNaNSimd.hpp"
+#endif
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+namespace
+{
+// keeps the compiler from folding the operations at compile time
+template <typename T>
+auto opaque(const T value) -> T
+{
+    const volatile T copy = value;
+    return copy;
+}
+
+template <typename T>
+auto runtimeNaN() -> T
+{
+    return opaque(std::numeric_limits<T>::quiet_NaN());
+}
+}    // namespace
+
+TEMPLATE_TEST_CASE("Bit pattern NaN test", "[NotNaN][FastMath]", float, double, long double)
+{
+    using Limits = std::numeric_limits<TestType>;
+
+    // isNaN only uses the bit pattern under fast math, test it directly as well
+    const auto test = [](const auto isNaN)
+    {
+        STATIC_REQUIRE(isNaN(Limits::quiet_NaN()));
+        STATIC_REQUIRE(isNaN(-Limits::quiet_NaN()));
+        STATIC_REQUIRE(isNaN(Limits::signaling_NaN()));
+        STATIC_REQUIRE_FALSE(isNaN(Limits::infinity()));
+        STATIC_REQUIRE_FALSE(isNaN(-Limits::infinity()));
+        STATIC_REQUIRE_FALSE(isNaN(Limits::max()));
+        STATIC_REQUIRE_FALSE(isNaN(Limits::denorm_min()));
+        STATIC_REQUIRE_FALSE(isNaN(TestType {-0.0}));
+
+        REQUIRE(isNaN(runtimeNaN<TestType>()));
+        REQUIRE(isNaN(opaque(TestType {0}) / opaque(TestType {0})));
+        REQUIRE_FALSE(isNaN(opaque(TestType {1})));
+    };
+    test([](const TestType value) constexpr { return notnan::isNaN(value); });
+    test([](const TestType value) constexpr { return notnan::detail::isNaNBits(value); });
+}
+
+TEMPLATE_TEST_CASE("Invariant under fast math", "[NotNaN][FastMath]", float, double, long double)
+{
+    using N            = NotNaN<TestType>;
+    const TestType NaN = runtimeNaN<TestType>();
+    const N            one {opaque(TestType {1})};
+
+    REQUIRE_THROWS_AS(N {NaN}, std::invalid_argument);
+    REQUIRE_FALSE(N::tryFromValue(NaN).has_value());
+
+    N x {one};
+    REQUIRE_THROWS_AS(x = NaN, std::invalid_argument);
+    REQUIRE(*x == 1);
+    REQUIRE_THROWS_AS(x += NaN, std::invalid_argument);
+    REQUIRE(*x == 1);
+
+    REQUIRE_THROWS_AS(one + NaN, std::invalid_argument);
+    REQUIRE_THROWS_AS(NaN * one, std::invalid_argument);
+    REQUIRE_THROWS_AS(static_cast<void>(one < NaN), std::invalid_argument);
+    REQUIRE_THROWS_AS(one.pow(NaN), std::invalid_argument);
+
+    // results computed at run time, x / x would be folded to 1
+    const N zero {opaque(TestType {0})};
+    const N otherZero {opaque(TestType {0})};
+    REQUIRE_THROWS_AS(zero / otherZero, std::runtime_error);
+    REQUIRE_THROWS(N {opaque(TestType {-1})}.sqrt());
+    REQUIRE_THROWS(N {opaque(TestType {-1})}.log());
+}
+
+TEMPLATE_TEST_CASE("Bulk validation under fast math", "[NotNaN][FastMath]", float, double, long double)
+{
+    std::vector<TestType> values(1000, TestType {1});
+    REQUIRE(notnan::findNaN(std::span<const TestType> {values}) == values.size());
+    for (const std::size_t idx : {std::size_t {0}, std::size_t {17}, std::size_t {999}})
+    {
+        values[idx] = runtimeNaN<TestType>();
+        REQUIRE(notnan::findNaN(std::span<const TestType> {values}) == idx);
+        REQUIRE_THROWS_AS(notnan::validate(std::span<const TestType> {values}), std::invalid_argument);
+        REQUIRE_THROWS_AS(NotNaNVector<TestType>(std::span<const TestType> {values}), std::invalid_argument);
+        values[idx] = 1;
+    }
+}
+
+#if __has_include(<experimental/simd>)
+TEMPLATE_TEST_CASE("Simd lanes under fast math", "[NotNaN][FastMath][Simd]", float, double)
+{
+    using S = NotNaNSimd<TestType, 4>;
+
+    // results computed at run time, like above
+    const S one {NotNaN<TestType> {opaque(TestType {1})}};
+    const S zero {NotNaN<TestType> {opaque(TestType {0})}};
+    const S otherZero {NotNaN<TestType> {opaque(TestType {0})}};
+
+    typename S::SimdType values {TestType {1}};
+    values[3] = runtimeNaN<TestType>();
+    REQUIRE_THROWS_AS(S {values}, std::invalid_argument);
+    REQUIRE_THROWS_AS(one + runtimeNaN<TestType>(), std::invalid_argument);
+    REQUIRE_THROWS_AS(zero / otherZero, std::runtime_error);
+    REQUIRE_THROWS((-one).sqrt());
+}
+#endif
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,334 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include "../NotNaNFile.hpp"
+#include "../NotNaNVector.hpp"
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+namespace
+{
+// A file in the temporary directory, removed again at the end of the test
+class TemporaryFile
+{
+  private:
+    std::filesystem::path m_path;
+
+  public:
+    explicit TemporaryFile(const std::string& name)
+        : m_path {std::filesystem::temp_directory_path() / name}
+    {
+        // empty
+    }
+
+    TemporaryFile(const TemporaryFile&)                     = delete;
+    auto operator= (const TemporaryFile&) -> TemporaryFile& = delete;
+
+    ~TemporaryFile()
+    {
+        std::error_code error;
+        std::filesystem::remove(m_path, error);
+    }
+
+    [[nodiscard]]
+    auto path() const -> const std::filesystem::path&
+    {
+        return m_path;
+    }
+
+    [[nodiscard]]
+    auto read() const -> std::vector<char>
+    {
+        std::ifstream file {m_path, std::ios::binary};
+        return {std::istreambuf_iterator<char> {file}, std::istreambuf_iterator<char> {}};
+    }
+
+    void write(const std::vector<char>& bytes) const
+    {
+        std::ofstream file {m_path, std::ios::binary | std::ios::trunc};
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+};
+
+// Overwrites value idx of an array file with bytes, keeping the checksum valid if asked to
+template <typename T>
+void patch(const TemporaryFile& file, const std::size_t idx, const T value, const bool fixChecksum)
+{
+    std::vector<char> bytes = file.read();
+    std::memcpy(bytes.data() + notnan::detail::ARRAY_OFFSET + (idx * sizeof(T)), &value, sizeof(T));
+    if (fixChecksum)
+    {
+        const std::uint64_t checksum = notnan::detail::checksum(
+          std::as_bytes(std::span {bytes}).subspan(notnan::detail::ARRAY_OFFSET)
+        );
+        std::memcpy(bytes.data() + offsetof(notnan::detail::ArrayHeader, checksum), &checksum, sizeof(checksum));
+    }
+    file.write(bytes);
+}
+}    // namespace
+
+#if __has_include(<sys/mman.h>)
+TEMPLATE_TEST_CASE("Binary array files", "[NotNaN][File]", float, double)
+{
+    using N = NotNaN<TestType>;
+    using L = std::numeric_limits<TestType>;
+
+    const TemporaryFile file {"notnan_file_test.nnan"};
+    std::vector<N>      values;
+    for (int i = 0; i < 1001; ++i)
+    {
+        values.emplace_back(static_cast<TestType>(i) / 4);
+    }
+    values[1] = N {L::infinity()};
+    values[2] = N {-0.0};
+    values[3] = N {L::denorm_min()};
+
+    notnan::writeArray(file.path(), values);
+    REQUIRE(std::filesystem::file_size(file.path()) == 64 + (values.size() * sizeof(TestType)));
+
+    for (const notnan::Verification verification :
+         {notnan::Verification::Header, notnan::Verification::Checksum, notnan::Verification::Full})
+    {
+        const notnan::MappedArray<TestType> mapped {file.path(), verification};
+        REQUIRE(mapped.size() == values.size());
+        REQUIRE(std::ranges::equal(mapped, values));
+        REQUIRE(std::signbit(*mapped[2]));
+
+        const std::span<const N> view = mapped.values();
+        REQUIRE(reinterpret_cast<std::uintptr_t>(view.data()) % 64 == 0);
+    }
+
+    // any contiguous range of NotNaN, under any policy
+    notnan::writeArray(file.path(), NotNaNVector<TestType> {N {1}, N {2}});
+    const notnan::MappedArray<TestType, notnan::UncheckedPolicy> unchecked {file.path()};
+    REQUIRE(unchecked.size() == 2);
+    REQUIRE(*unchecked[1] == 2);
+
+    notnan::writeArray(file.path(), std::vector<N> {});
+    REQUIRE(notnan::MappedArray<TestType> {file.path(), notnan::Verification::Full}.empty());
+}
+
+TEST_CASE("Damaged binary array files", "[NotNaN][File]")
+{
+    using N = NotNaN<double>;
+
+    const TemporaryFile file {"notnan_file_test_damaged.nnan"};
+    const auto          write = [&file] { notnan::writeArray(file.path(), std::vector<N>(100, N {1.5})); };
+
+    write();
+    REQUIRE_THROWS_AS(notnan::MappedArray<float> {file.path()}, std::runtime_error);
+
+    // a changed value is only found by the checksum
+    patch(file, 50, 2.5, false);
+    REQUIRE(*notnan::MappedArray<double> {file.path()}[50] == 2.5);
+    REQUIRE_THROWS_AS(notnan::MappedArray<double>(file.path(), notnan::Verification::Checksum), std::runtime_error);
+
+    // a NaN written with a matching checksum is only found by the full scan
+    write();
+    patch(file, 7, std::numeric_limits<double>::quiet_NaN(), true);
+    REQUIRE_NOTHROW(notnan::MappedArray<double>(file.path(), notnan::Verification::Checksum));
+    try
+    {
+        static_cast<void>(notnan::MappedArray<double>(file.path(), notnan::Verification::Full));
+        FAIL("no error");
+    }
+    catch (const std::invalid_argument& error)
+    {
+        REQUIRE(std::string {error.what()}.find("at index 7") != std::string::npos);
+    }
+    // policies without checks leave the values to the caller
+    REQUIRE_NOTHROW(notnan::MappedArray<double, notnan::UncheckedPolicy>(file.path(), notnan::Verification::Full));
+
+    write();
+    std::vector<char> bytes = file.read();
+    bytes.pop_back();
+    file.write(bytes);
+    REQUIRE_THROWS_AS(notnan::MappedArray<double> {file.path()}, std::runtime_error);
+
+    file.write({'N', 'O', 'T'});
+    REQUIRE_THROWS_AS(notnan::MappedArray<double> {file.path()}, std::runtime_error);
+
+    std::filesystem::remove(file.path());
+    REQUIRE_THROWS_AS(notnan::MappedArray<double> {file.path()}, std::system_error);
+}
+#endif
+
+TEST_CASE("Checksum", "[NotNaN][File]")
+{
+    std::vector<std::byte> bytes(1000);
+    const std::uint64_t    empty = notnan::detail::checksum({});
+    const std::uint64_t    zeros = notnan::detail::checksum(bytes);
+
+    REQUIRE(empty != zeros);
+    REQUIRE(zeros != notnan::detail::checksum(std::span {bytes}.first(999)));
+
+    // every single bit flip changes it, in the striped part and in the tail
+    for (const std::size_t idx : {std::size_t {0}, std::size_t {31}, std::size_t {500}, std::size_t {995}, std::size_t {999}})
+    {
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            bytes[idx] ^= std::byte {1} << bit;
+            REQUIRE(notnan::detail::checksum(bytes) != zeros);
+            bytes[idx] ^= std::byte {1} << bit;
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Lazy validation", "[NotNaN][File]", float, double, long double)
+{
+    using View = notnan::LazyNotNaNView<TestType>;
+    using L    = std::numeric_limits<TestType>;
+
+    constexpr std::size_t CHUNK = View::CHUNK;
+    std::vector<TestType> raw(10 * CHUNK + 5);
+    for (std::size_t i = 0; i < raw.size(); ++i)
+    {
+        raw[i] = static_cast<TestType>(i % 100);
+    }
+    const std::size_t bad = (7 * CHUNK) + 3;
+    raw[bad]              = L::quiet_NaN();
+
+    const View view {raw};
+    REQUIRE(view.size() == raw.size());
+    REQUIRE(view.chunks() == 11);
+    REQUIRE(view.validatedChunks() == 0);
+
+    REQUIRE(*view[(3 * CHUNK) + 1] == raw[(3 * CHUNK) + 1]);
+    REQUIRE(view.isValidated(3 * CHUNK));
+    REQUIRE_FALSE(view.isValidated(0));
+    REQUIRE(view.validatedChunks() == 1);
+    REQUIRE(view.chunk((3 * CHUNK) + 7).size() == CHUNK);
+    REQUIRE(view.chunk(raw.size() - 1).size() == 5);
+    REQUIRE(*view.at(raw.size() - 1) == raw.back());
+    REQUIRE(view.validatedChunks() == 2);
+    REQUIRE_THROWS_AS(view.at(raw.size()), std::out_of_range);
+
+    try
+    {
+        static_cast<void>(view[bad + 5]);
+        FAIL("no error");
+    }
+    catch (const std::invalid_argument& error)
+    {
+        REQUIRE(std::string {error.what()}.find(std::format("at index {}", bad)) != std::string::npos);
+    }
+    REQUIRE_FALSE(view.isValidated(bad));
+    REQUIRE_THROWS_AS(view.values(), std::invalid_argument);
+
+    // a sequential scan gets as far as the chunk with the NaN
+    std::size_t scanned = 0;
+    REQUIRE_THROWS_AS(
+      [&]
+      {
+          for (const NotNaN<TestType>& value : view)
+          {
+              static_cast<void>(value);
+              ++scanned;
+          }
+      }(),
+      std::invalid_argument
+    );
+    REQUIRE(scanned == 7 * CHUNK);
+    REQUIRE(view.validatedChunks() == 8);
+
+    // policies without checks scan nothing
+    const notnan::LazyNotNaNView<TestType, notnan::UncheckedPolicy> unchecked {raw};
+    REQUIRE(unchecked.values().size() == raw.size());
+    REQUIRE(*unchecked[bad - 1] == raw[bad - 1]);
+    REQUIRE(unchecked.validatedChunks() == 0);
+
+    raw[bad]            = 1;
+    const View repaired {raw};
+    REQUIRE(repaired.values().size() == raw.size());
+    REQUIRE(repaired.validatedChunks() == repaired.chunks());
+    REQUIRE(std::ranges::distance(repaired.begin(), repaired.end()) == static_cast<std::ptrdiff_t>(raw.size()));
+
+    const View empty {std::span<const TestType> {}};
+    REQUIRE(empty.values().empty());
+    REQUIRE(empty.begin() == empty.end());
+}
+
+TEST_CASE("Lazy validation on background threads", "[NotNaN][File]")
+{
+    using View = notnan::LazyNotNaNView<double>;
+
+    std::vector<double> raw(1000 * View::CHUNK, 1.5);
+    {
+        const View view {raw};
+        auto       prefetch = view.prefetch(0, raw.size(), 4);
+        prefetch.wait();
+        REQUIRE(view.validatedChunks() == view.chunks());
+    }
+
+    // the chunk with the NaN is left for the scan to report
+    raw[(500 * View::CHUNK) + 1] = std::numeric_limits<double>::quiet_NaN();
+    {
+        const View view {raw};
+        auto       prefetch = view.prefetch();
+        double     sum      = 0;
+        REQUIRE_THROWS_AS(
+          [&]
+          {
+              for (const NotNaN<double>& value : view)
+              {
+                  sum += *value;
+              }
+          }(),
+          std::invalid_argument
+        );
+        REQUIRE(sum == 500 * View::CHUNK * 1.5);
+        prefetch.wait();
+        REQUIRE(view.validatedChunks() == view.chunks() - 1);
+    }
+
+    // a part of the view, and stopping early
+    {
+        const View view {raw};
+        view.prefetch(10 * View::CHUNK, (20 * View::CHUNK) - 1, 2).wait();
+        REQUIRE(view.validatedChunks() == 10);
+        static_cast<void>(view.prefetch());
+    }
+}
+
+#if __has_include(<sys/mman.h>)
+TEST_CASE("Lazy validation of a mapped file", "[NotNaN][File]")
+{
+    const TemporaryFile      file {"notnan_file_test.f32"};
+    const std::vector<float> raw(3001, 0.5F);
+    file.write({reinterpret_cast<const char*>(raw.data()), reinterpret_cast<const char*>(raw.data() + raw.size())});
+
+    const notnan::MappedFile            mapped {file.path()};
+    const notnan::LazyNotNaNView<float> view {mapped.values<float>()};
+    REQUIRE(view.size() == 3001);
+    REQUIRE(*view[3000] == 0.5F);
+    REQUIRE(view.validatedChunks() == 1);
+    REQUIRE_THROWS_AS(mapped.values<double>(), std::invalid_argument);
+}
+#endif
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,71 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include "../NotNaN.hpp"
+#include <array>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <charconv>
+#include <format>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+TEMPLATE_TEST_CASE("Formatting ranges", "[NotNaN][Format]", float, double, long double)
+{
+    using N                         = NotNaN<TestType>;
+    const std::vector<N>       values {N {1.5}, N {-2}, N {0.25}, N {std::numeric_limits<TestType>::infinity()}};
+    const std::span<const N>   view {values};
+    const std::array<N, 2>     pair {N {1}, N {2}};
+
+    REQUIRE(std::format("{}", view) == "[1.5, -2, 0.25, inf]");
+    REQUIRE(std::format("{:>+7.2F}", view) == "[  +1.50,   -2.00,   +0.25,    +INF]");
+    REQUIRE(std::format("{:e}", std::span {pair}) == "[1.000000e+00, 2.000000e+00]");
+    REQUIRE(std::format("{}", std::span<const N> {}) == "[]");
+
+    // the shortest form is the one {} gives for a single value
+    const N third {TestType {1} / 3};
+    REQUIRE(std::format("{}", std::span {&third, 1}) == std::format("[{}]", third));
+}
+
+TEMPLATE_TEST_CASE("Writing delimited text", "[NotNaN][Format]", float, double, long double)
+{
+    using N = NotNaN<TestType>;
+    using L = std::numeric_limits<TestType>;
+
+    const std::vector<N> values {N {1.5}, N {-2}, N {L::lowest()}, N {L::denorm_min()}, N {-L::infinity()}};
+
+    std::vector<char> buffer(values.size() * (notnan::MAX_CHARS<TestType> + 2));
+    const auto [end, error] = notnan::writeDelimited(buffer, values, ", ");
+    REQUIRE(error == std::errc {});
+    REQUIRE(
+      std::string_view {buffer.data(), end}
+      == std::format("1.5, -2, {}, {}, -inf", *values[2], *values[3])
+    );
+
+    // MAX_CHARS holds the longest values
+    for (const N& value : values)
+    {
+        std::array<char, notnan::MAX_CHARS<TestType>> text {};
+        REQUIRE(notnan::writeDelimited(text, std::span {&value, 1}).ec == std::errc {});
+    }
+
+    std::array<char, 5> small {};
+    REQUIRE(notnan::writeDelimited(small, values).ec == std::errc::value_too_large);
+    REQUIRE(notnan::writeDelimited(small, std::vector<N> {}).ptr == small.data());
+}
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#pragma GCC diagnostic pop
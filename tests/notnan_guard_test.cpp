@@ -0,0 +1,201 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include "../NotNaNGuard.hpp"
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cfenv>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+namespace
+{
+// keeps the compiler from folding the operations at compile time
+template <typename T>
+auto opaque(const T value) -> T
+{
+    const volatile T copy = value;
+    return copy;
+}
+
+// results that are never used may be optimized away together with the flag they would raise
+template <typename T, typename Policy>
+void consume(const NotNaN<T, Policy>& value)
+{
+    const volatile T copy = *value;
+    static_cast<void>(copy);
+}
+}    // namespace
+
+TEMPLATE_TEST_CASE("Hardware policy", "[NotNaN][Guard]", float, double, long double)
+{
+    using N                = NotNaN<TestType, notnan::HardwarePolicy>;
+    constexpr TestType NaN = std::numeric_limits<TestType>::quiet_NaN();
+    const N            inf {opaque(std::numeric_limits<TestType>::infinity())};
+    const N            one {opaque(TestType {1})};
+
+    // raw NaN does not raise the flag, so it is still checked right away
+    REQUIRE_THROWS_AS(N {NaN}, std::invalid_argument);
+    REQUIRE_THROWS_AS(one + NaN, std::invalid_argument);
+
+    // outside of a scope results are checked right away, before and after one
+    REQUIRE_THROWS_AS(inf - inf, std::runtime_error);
+    REQUIRE_THROWS_AS(N {opaque(TestType {-1})}.sqrt(), std::invalid_argument);
+    {
+        const notnan::NaNGuardScope guard;
+        REQUIRE(notnan::HardwarePolicy::deferring());
+    }
+    REQUIRE_FALSE(notnan::HardwarePolicy::deferring());
+    REQUIRE_THROWS_AS(inf * 0, std::runtime_error);
+
+    // results are checked once at the end of the scope
+    REQUIRE_THROWS_AS(
+      [&]
+      {
+          const notnan::NaNGuardScope guard;
+          N                           sum = one;
+          for (int i = 0; i < 10; ++i)
+          {
+              sum = sum + one;
+          }
+          consume(inf - inf);
+      }(),
+      std::runtime_error
+    );
+    REQUIRE_NOTHROW(
+      [&]
+      {
+          const notnan::NaNGuardScope guard;
+          REQUIRE(*(one + inf) == inf);
+          REQUIRE(*(one / N {opaque(TestType {0})}) == inf);
+          REQUIRE(*N {opaque(TestType {4})}.sqrt() == 2);
+      }()
+    );
+    REQUIRE_THROWS_AS(
+      [&]
+      {
+          const notnan::NaNGuardScope guard;
+          consume(N {opaque(TestType {-1})}.sqrt());
+      }(),
+      std::runtime_error
+    );
+}
+
+TEST_CASE("NaN guard scope", "[NotNaN][Guard]")
+{
+    using N = NotNaN<double, notnan::HardwarePolicy>;
+    const N inf {opaque(std::numeric_limits<double>::infinity())};
+
+    SECTION("flag state is restored")
+    {
+        std::feraiseexcept(FE_INVALID);
+        {
+            const notnan::NaNGuardScope guard;
+            REQUIRE_FALSE(notnan::NaNGuardScope<>::invalid());
+        }
+        REQUIRE(std::fetestexcept(FE_INVALID) != 0);
+        std::feclearexcept(FE_INVALID);
+    }
+
+    SECTION("nested scopes")
+    {
+        REQUIRE_THROWS_AS(
+          [&]
+          {
+              const notnan::NaNGuardScope outer;
+              REQUIRE_THROWS_AS(
+                [&]
+                {
+                    const notnan::NaNGuardScope inner;
+                    consume(inf - inf);
+                }(),
+                std::runtime_error
+              );
+              // the inner scope has already reported
+              REQUIRE_FALSE(notnan::NaNGuardScope<>::invalid());
+              consume(inf * 0);
+          }(),
+          std::runtime_error
+        );
+    }
+
+    SECTION("check reports early and starts over")
+    {
+        const notnan::NaNGuardScope guard;
+        consume(inf - inf);
+        REQUIRE(guard.invalid());
+        REQUIRE_THROWS_AS(guard.check(), std::runtime_error);
+        REQUIRE_FALSE(guard.invalid());
+        REQUIRE_NOTHROW(guard.check());
+    }
+
+    SECTION("nothing is reported while unwinding")
+    {
+        REQUIRE_THROWS_AS(
+          [&]
+          {
+              const notnan::NaNGuardScope guard;
+              consume(inf - inf);
+              throw std::logic_error("unrelated");
+          }(),
+          std::logic_error
+        );
+    }
+
+    SECTION("report through another policy")
+    {
+        REQUIRE_THROWS_WITH(
+          [&]
+          {
+              const notnan::NaNGuardScope<notnan::ThrowPolicy> guard;
+              consume(inf - inf);
+          }(),
+          "Result of guarded scope is NaN"
+        );
+    }
+}
+
+TEST_CASE("Guarded functions", "[NotNaN][Guard]")
+{
+    using N = NotNaN<double, notnan::HardwarePolicy>;
+    const N inf {opaque(std::numeric_limits<double>::infinity())};
+    const N one {opaque(1.0)};
+
+    REQUIRE(*notnan::guarded([&] { return inf + one; }) == std::numeric_limits<double>::infinity());
+    REQUIRE_THROWS_AS(notnan::guarded([&] { return inf * 0; }), std::runtime_error);
+    REQUIRE_THROWS_WITH(notnan::guarded([&] { return inf - inf; }), "Result of guarded scope is NaN");
+    REQUIRE_NOTHROW(notnan::guarded([] {}));
+
+    // the accumulator lives inside the function and is gone with the error
+    REQUIRE_THROWS_AS(
+      notnan::guarded(
+        [&]
+        {
+            N sum {0.0};
+            for (const N& value : {one, inf, -inf})
+            {
+                sum += value;
+            }
+            return sum;
+        }
+      ),
+      std::runtime_error
+    );
+
+    // back to checking after each operation
+    REQUIRE_FALSE(notnan::HardwarePolicy::deferring());
+    REQUIRE_THROWS_AS(inf - inf, std::runtime_error);
+}
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,289 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include "../NotNaNMath.hpp"
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+namespace
+{
+enum class Function : std::uint8_t
+{
+    Exp,
+    Log,
+    Sin,
+    Cos,
+};
+
+constexpr std::array FUNCTIONS {Function::Exp, Function::Log, Function::Sin, Function::Cos};
+
+template <std::floating_point T>
+auto reference(const Function function, const T x) -> T
+{
+    switch (function)
+    {
+        case Function::Exp: return std::exp(x);
+        case Function::Log: return std::log(x);
+        case Function::Sin: return std::sin(x);
+        case Function::Cos: return std::cos(x);
+    }
+    return x;
+}
+
+template <std::floating_point T, notnan::CheckPolicy Policy>
+void apply(const Function function, const std::span<const NotNaN<T, Policy>> values, const std::span<NotNaN<T, Policy>> results)
+{
+    switch (function)
+    {
+        case Function::Exp: notnan::exp(values, results); break;
+        case Function::Log: notnan::log(values, results); break;
+        case Function::Sin: notnan::sin(values, results); break;
+        case Function::Cos: notnan::cos(values, results); break;
+    }
+}
+
+// the kernels themselves, whether the target has AVX2 or not
+template <std::floating_point T>
+void applyKernel(const Function function, const std::vector<T>& values, std::vector<T>& results)
+{
+    using namespace notnan::detail;
+    switch (function)
+    {
+        case Function::Exp: computeKernel<ExpFunction>(values.data(), results.data(), values.size()); break;
+        case Function::Log: computeKernel<LogFunction>(values.data(), results.data(), values.size()); break;
+        case Function::Sin: computeKernel<TrigFunction<false>>(values.data(), results.data(), values.size()); break;
+        case Function::Cos: computeKernel<TrigFunction<true>>(values.data(), results.data(), values.size()); break;
+    }
+}
+
+// error of result in units of the last place of the double nearest to exact
+auto ulps(const double result, const long double exact) -> long double
+{
+    const double nearest = static_cast<double>(exact);
+    if (result == nearest)
+    {
+        return 0;
+    }
+    const double ulp = std::nextafter(std::abs(nearest), std::numeric_limits<double>::infinity()) - std::abs(nearest);
+    return std::abs(static_cast<long double>(result) - exact) / ulp;
+}
+
+// inputs for which the kernel of function is worth checking, well spread over the range of double
+auto sweep(const Function function) -> std::vector<double>
+{
+    std::mt19937_64                        rng {42};
+    std::uniform_real_distribution<double> uniform {-1.0, 1.0};
+    std::vector<double>                    values;
+    for (int i = 0; i < 100'000; ++i)
+    {
+        switch (function)
+        {
+            case Function::Exp: values.push_back(uniform(rng) * 746.0); break;
+            case Function::Log: values.push_back(std::exp2((uniform(rng) + 1.0) * 1049.0 - 1074.0)); break;
+            case Function::Sin:
+            case Function::Cos: values.push_back(std::exp2(uniform(rng) * 30.0) * uniform(rng)); break;
+        }
+    }
+    if (function == Function::Sin || function == Function::Cos)
+    {
+        // the doubles closest to multiples of pi / 2, where the reduction loses the most
+        constexpr long double PI_2 = 1.570796326794896619231321691639751442L;
+        for (std::int64_t k = 1; k < 600'000; k += 7)
+        {
+            values.push_back(static_cast<double>(static_cast<long double>(k) * PI_2));
+        }
+    }
+    return values;
+}
+}    // namespace
+
+TEMPLATE_TEST_CASE("Span math", "[NotNaN][Math]", float, double, long double)
+{
+    using N            = NotNaN<TestType>;
+    constexpr auto inf = std::numeric_limits<TestType>::infinity();
+
+    // sizes around the lanes and the blocks
+    for (const std::size_t size :
+         {std::size_t {0}, std::size_t {1}, std::size_t {7}, std::size_t {8}, std::size_t {9}, std::size_t {1023},
+          std::size_t {1024}, std::size_t {1025}, std::size_t {3000}})
+    {
+        std::vector<N> values;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            values.emplace_back(static_cast<TestType>(i) * TestType {0.37} - TestType {20});
+        }
+        std::vector<N> positive;
+        for (const N value : values)
+        {
+            positive.push_back(value.abs());
+        }
+
+        for (const Function function : FUNCTIONS)
+        {
+            const std::vector<N>& inputs = function == Function::Log ? positive : values;
+            std::vector<N>        results(size, N {0});
+            apply(function, std::span<const N> {inputs}, std::span<N> {results});
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                const TestType expected = reference(function, *inputs[i]);
+                const TestType ulp      = std::nextafter(std::abs(expected), inf) - std::abs(expected);
+                REQUIRE((*results[i] == expected || std::abs(*results[i] - expected) <= 2 * ulp));
+            }
+
+            // in place
+            std::vector<N> copy = inputs;
+            apply(function, std::span<const N> {copy}, std::span<N> {copy});
+            REQUIRE(copy == results);
+        }
+    }
+
+    // special values
+    const std::vector<N> specials {N {0}, N {-0.0}, N {inf}, N {-inf}, N {std::numeric_limits<TestType>::denorm_min()}};
+    std::vector<N>       results(specials.size(), N {1});
+    notnan::exp(std::span<const N> {specials}, std::span<N> {results});
+    REQUIRE(results == std::vector<N> {N {1}, N {1}, N {inf}, N {0}, N {1}});
+
+    const std::span<const N> nonNegative {specials.data(), 3};
+    notnan::log(nonNegative, std::span<N> {results}.first(3));
+    REQUIRE(results[0] == -inf);
+    REQUIRE(results[1] == -inf);
+    REQUIRE(results[2] == inf);
+
+    const std::span<const N> finite {specials.data(), 2};
+    notnan::sin(finite, std::span<N> {results}.first(2));
+    REQUIRE((*results[0] == 0 && !std::signbit(*results[0])));
+    REQUIRE((*results[1] == 0 && std::signbit(*results[1])));
+    notnan::cos(finite, std::span<N> {results}.first(2));
+    REQUIRE(results[0] == 1);
+    REQUIRE(results[1] == 1);
+}
+
+TEMPLATE_TEST_CASE("Span math domain errors", "[NotNaN][Math]", float, double, long double)
+{
+    using N            = NotNaN<TestType>;
+    constexpr auto inf = std::numeric_limits<TestType>::infinity();
+
+    std::vector<N> values(3000, N {0.5});
+    std::vector<N> results(values.size(), N {0});
+    values[2500] = N {-1};
+
+    try
+    {
+        notnan::log(std::span<const N> {values}, std::span<N> {results});
+        FAIL("log of a negative value did not throw");
+    }
+    catch (const std::invalid_argument& error)
+    {
+        REQUIRE(std::string {error.what()} == "log of -1 at index 2500 is NaN");
+    }
+    // the blocks before the one with the error are written, the rest is left alone
+    REQUIRE(*results[0] == std::log(TestType {0.5}));
+    REQUIRE(results[2999] == 0);
+
+    values[2500] = N {-inf};
+    REQUIRE_THROWS_AS(notnan::log(std::span<const N> {values}, std::span<N> {results}), std::invalid_argument);
+    REQUIRE_THROWS_AS(notnan::sin(std::span<const N> {values}, std::span<N> {results}), std::invalid_argument);
+    REQUIRE_THROWS_AS(notnan::cos(std::span<const N> {values}, std::span<N> {results}), std::invalid_argument);
+    REQUIRE_NOTHROW(notnan::exp(std::span<const N> {values}, std::span<N> {results}));
+    REQUIRE(results[2500] == 0);
+
+    values[2500] = N {inf};
+    REQUIRE_THROWS_AS(notnan::sin(std::span<const N> {values}, std::span<N> {results}), std::invalid_argument);
+    REQUIRE_NOTHROW(notnan::log(std::span<const N> {values}, std::span<N> {results}));
+
+    results.pop_back();
+    REQUIRE_THROWS_AS(notnan::exp(std::span<const N> {values}, std::span<N> {results}), std::invalid_argument);
+
+    // other policies report like the math members, without checks nothing is checked
+    using E = NotNaN<TestType, notnan::ExpectedPolicy>;
+    const std::vector<E> negative {E {1}, E {-1}};
+    std::vector<E>       expected(negative.size(), E {0});
+    REQUIRE(
+      notnan::log(std::span<const E> {negative}, std::span<E> {expected}).error()
+      == notnan::NaNError {notnan::Operation::Log, notnan::Operand::Result}
+    );
+    REQUIRE(expected[0] == 0);
+    REQUIRE(notnan::exp(std::span<const E> {negative}, std::span<E> {expected})->data() == expected.data());
+    REQUIRE(*expected[0] > 2);
+
+    using U = NotNaN<TestType, notnan::UncheckedPolicy>;
+    const std::vector<U> unchecked {U {1}, U {-1}};
+    std::vector<U>       logs(unchecked.size(), U {0});
+    REQUIRE_NOTHROW(notnan::log(std::span<const U> {unchecked}, std::span<U> {logs}));
+    REQUIRE(logs[0] == 0);
+}
+
+TEST_CASE("Math kernels", "[NotNaN][Math]")
+{
+    // long double is the reference, which needs more digits than double
+    if constexpr (std::numeric_limits<long double>::digits > std::numeric_limits<double>::digits)
+    {
+        for (const Function function : FUNCTIONS)
+        {
+            const std::vector<double> values = sweep(function);
+            std::vector<double>       results(values.size());
+            applyKernel(function, values, results);
+
+            long double worst = 0;
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                const long double error = ulps(results[i], reference(function, static_cast<long double>(values[i])));
+                if (error > worst)
+                {
+                    INFO(std::format("function {} of {:a} is {:a}", static_cast<int>(function), values[i], results[i]));
+                    worst = error;
+                    REQUIRE(worst <= (function == Function::Exp ? 1.0L : 0.95L));
+                }
+            }
+        }
+    }
+
+    // float is rounded once from double, every 997th float
+    for (const Function function : FUNCTIONS)
+    {
+        std::vector<float> values;
+        for (std::uint32_t bits = 0; bits < 0x7f80'0000U; bits += 997)
+        {
+            values.push_back(std::bit_cast<float>(bits));
+            if (function != Function::Log)
+            {
+                values.push_back(-std::bit_cast<float>(bits));
+            }
+        }
+        std::vector<float> results(values.size());
+        applyKernel(function, values, results);
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            const auto expected = static_cast<float>(reference(function, static_cast<long double>(values[i])));
+            if (results[i] != expected)
+            {
+                FAIL(std::format("function {} of {:a} is {:a}, not {:a}", static_cast<int>(function), values[i], results[i], expected));
+            }
+        }
+    }
+}
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,176 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include "../NotNaNParse.hpp"
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <execution>
+#include <expected>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+namespace
+{
+template <typename T>
+auto raw(const std::vector<NotNaN<T>>& values) -> std::vector<T>
+{
+    std::vector<T> result;
+    for (const NotNaN<T>& value : values)
+    {
+        result.push_back(*value);
+    }
+    return result;
+}
+
+// The position of the ParseError text throws
+template <typename Parse>
+auto errorPosition(const Parse& parse) -> std::pair<std::size_t, std::size_t>
+{
+    try
+    {
+        static_cast<void>(parse());
+    }
+    catch (const notnan::ParseError& error)
+    {
+        return {error.line(), error.column()};
+    }
+    return {0, 0};
+}
+
+// many lines, enough for several parallel chunks
+auto bigTable(const std::size_t rows) -> std::string
+{
+    std::string text;
+    for (std::size_t row = 0; row < rows; ++row)
+    {
+        text += std::format("{},{}.5,-{}e-3\n", row, row % 100, row % 7);
+    }
+    return text;
+}
+}    // namespace
+
+TEMPLATE_TEST_CASE("Parsing delimited text", "[NotNaN][Parse]", float, double, long double)
+{
+    using V = std::vector<TestType>;
+
+    REQUIRE(raw(notnan::parse<TestType>("1,2.5,-3\n4e2, +5 ,inf\n")) == V {1, 2.5, -3, 400, 5, std::numeric_limits<TestType>::infinity()});
+    REQUIRE(raw(notnan::parse<TestType>("1\t2\r\n\r\n  \n3\t4", {.delimiter = '\t'})) == V {1, 2, 3, 4});
+    REQUIRE(raw(notnan::parse<TestType>("a,b\n1,2\n", {.header = true})) == V {1, 2});
+    REQUIRE(notnan::parse<TestType>("").empty());
+
+    const auto columns = notnan::parseColumns<TestType>("x;y\n1;2\n3;4\n5;6\n", {.delimiter = ';', .header = true});
+    REQUIRE(columns.size() == 2);
+    REQUIRE(raw(columns[0]) == V {1, 3, 5});
+    REQUIRE(raw(columns[1]) == V {2, 4, 6});
+}
+
+TEMPLATE_TEST_CASE("Parse errors", "[NotNaN][Parse]", float, double, long double)
+{
+    using Pair = std::pair<std::size_t, std::size_t>;
+
+    REQUIRE_THROWS_AS(notnan::parse<TestType>("1,nan"), notnan::ParseError);
+    REQUIRE_THROWS_AS(notnan::parse<TestType>("1,nan"), std::invalid_argument);
+    REQUIRE(errorPosition([] { return notnan::parse<TestType>("1,2\n3,NaN\n"); }) == Pair {2, 2});
+    REQUIRE(errorPosition([] { return notnan::parse<TestType>("h\n1,2\n\n-nan(1)\n", {.header = true}); }) == Pair {4, 1});
+    REQUIRE(errorPosition([] { return notnan::parse<TestType>("1,2x"); }) == Pair {1, 2});
+    REQUIRE(errorPosition([] { return notnan::parse<TestType>("1,,2"); }) == Pair {1, 2});
+    REQUIRE(errorPosition([] { return notnan::parse<TestType>("1e999999"); }) == Pair {1, 1});
+    REQUIRE(errorPosition([] { return notnan::parseColumns<TestType>("1,2\n3\n"); }) == Pair {2, 2});
+    REQUIRE(errorPosition([] { return notnan::parseColumns<TestType>("1,2\n3,4,5\n"); }) == Pair {2, 3});
+
+    try
+    {
+        static_cast<void>(notnan::parse<TestType>("1\n nan \n"));
+        FAIL("no error");
+    }
+    catch (const notnan::ParseError& error)
+    {
+        REQUIRE(std::string {error.what()} == "NaN 'nan' at line 2, column 1");
+    }
+}
+
+TEST_CASE("Parsing under other policies", "[NotNaN][Parse]")
+{
+    using notnan::ExpectedPolicy;
+
+    const auto values = notnan::parse<double, ExpectedPolicy>("1,2\n3\n");
+    REQUIRE(values.has_value());
+    REQUIRE(values->size() == 3);
+    REQUIRE(*(*values)[2] == 3);
+
+    // NaN goes through the policy, text that is not a number is still a ParseError
+    const notnan::NaNError nanField {notnan::Operation::Construct, notnan::Operand::Value};
+    REQUIRE(notnan::parse<double, ExpectedPolicy>("1,nan") == std::unexpected(nanField));
+    REQUIRE(notnan::parseColumns<double, ExpectedPolicy>("1,2\n3,nan\n") == std::unexpected(nanField));
+    REQUIRE(notnan::parseColumns<double, ExpectedPolicy>(std::execution::par, "1,2\nnan,4\n") == std::unexpected(nanField));
+    REQUIRE(notnan::parse<double, ExpectedPolicy>(std::execution::par, "nan") == std::unexpected(nanField));
+    REQUIRE_THROWS_AS((notnan::parse<double, ExpectedPolicy>("1,x")), notnan::ParseError);
+    REQUIRE_THROWS_AS((notnan::parseColumns<double, ExpectedPolicy>(std::execution::par, "1,2\n3\n")), notnan::ParseError);
+}
+
+TEST_CASE("Parallel parsing", "[NotNaN][Parse]")
+{
+    std::string text = bigTable(200'000);
+    REQUIRE(text.size() > 2 * notnan::detail::PARSE_CHUNK);
+
+    const auto sequential = notnan::parseColumns<double>(text);
+    REQUIRE(notnan::parseColumns<double>(std::execution::par, text) == sequential);
+    REQUIRE(notnan::parse<double>(std::execution::par_unseq, text) == notnan::parse<double>(text));
+    REQUIRE(sequential[0].size() == 200'000);
+    REQUIRE(*sequential[1][123'456] == 56.5);
+
+    // line numbers count the lines of all chunks before
+    text.replace(text.rfind('\n', text.size() - 2) + 1, 1, "nan");
+    REQUIRE(errorPosition([&] { return notnan::parse<double>(std::execution::par, text); }) == std::pair<std::size_t, std::size_t> {200'000, 1});
+    REQUIRE(errorPosition([&] { return notnan::parseColumns<double>(std::execution::par, text); }) == std::pair<std::size_t, std::size_t> {200'000, 1});
+}
+
+#if __has_include(<sys/mman.h>)
+TEST_CASE("Parsing a mapped file", "[NotNaN][Parse]")
+{
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "notnan_parse_test.csv";
+    {
+        std::ofstream file {path};
+        file << "a,b\n1,2\n3,4\n";
+    }
+    {
+        const notnan::MappedFile mapped {path};
+        const auto               columns = notnan::parseColumns<double>(mapped.text(), {.header = true});
+        REQUIRE(columns.size() == 2);
+        REQUIRE(*columns[1][1] == 4);
+    }
+    std::filesystem::remove(path);
+
+    REQUIRE_THROWS_AS(notnan::MappedFile {path}, std::system_error);
+}
+#endif
+
+TEMPLATE_TEST_CASE("Reading from streams", "[NotNaN][Parse]", float, double, long double)
+{
+    NotNaN<TestType>  value {0};
+    std::stringstream stream {"1.5 abc"};
+    REQUIRE(stream >> value);
+    REQUIRE(*value == 1.5);
+    REQUIRE_FALSE(stream >> value);
+    REQUIRE(*value == 1.5);
+}
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#pragma GCC diagnostic pop
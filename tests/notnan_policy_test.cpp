@@ -0,0 +1,158 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include "../NotNaN.hpp"
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <expected>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+TEMPLATE_TEST_CASE("Policy interface", "[NotNaN][Policy]", float, double, long double)
+{
+    using Throwing = NotNaN<TestType>;
+    using Expected = NotNaN<TestType, notnan::ExpectedPolicy>;
+
+    REQUIRE(std::same_as<Throwing, NotNaN<TestType, notnan::ThrowPolicy>>);
+    REQUIRE(std::same_as<decltype(std::declval<Throwing>() + 1), Throwing>);
+    REQUIRE(std::same_as<decltype(std::declval<Throwing&>() += 1), Throwing&>);
+    REQUIRE(std::same_as<decltype(std::declval<Expected>() + 1), std::expected<Expected, notnan::NaNError>>);
+    REQUIRE(std::same_as<decltype(std::declval<Expected&>() += 1), std::expected<void, notnan::NaNError>>);
+    REQUIRE(std::same_as<decltype(std::declval<Expected>().sqrt()), std::expected<Expected, notnan::NaNError>>);
+    REQUIRE(sizeof(NotNaN<TestType, notnan::UncheckedPolicy>) == sizeof(TestType));
+    REQUIRE(notnan::AssertPolicy::CHECKED ==
+#ifdef NDEBUG
+            false
+#else
+            true
+#endif
+    );
+}
+
+TEMPLATE_TEST_CASE("Throw policy", "[NotNaN][Policy]", float, double, long double)
+{
+    constexpr TestType INF = std::numeric_limits<TestType>::infinity();
+    constexpr TestType NaN = std::numeric_limits<TestType>::quiet_NaN();
+
+    REQUIRE_THROWS_AS(NotNaN<TestType> {NaN}, std::invalid_argument);
+    REQUIRE_THROWS_AS(NotNaN<TestType> {1.0} + NaN, std::invalid_argument);
+    REQUIRE_THROWS_AS(NaN * NotNaN<TestType> {1.0}, std::invalid_argument);
+    REQUIRE_THROWS_AS(NotNaN<TestType> {INF} - INF, std::runtime_error);
+    REQUIRE_THROWS_AS(NotNaN<TestType> {-1.0}.sqrt(), std::invalid_argument);
+    REQUIRE_THROWS_AS(NotNaN<TestType> {1.0}.pow(NaN), std::invalid_argument);
+    REQUIRE_THROWS_AS(NotNaN<TestType> {1.0} < NaN, std::invalid_argument);
+}
+
+TEMPLATE_TEST_CASE("Expected policy", "[NotNaN][Policy]", float, double, long double)
+{
+    using N                = NotNaN<TestType, notnan::ExpectedPolicy>;
+    constexpr TestType INF = std::numeric_limits<TestType>::infinity();
+    constexpr TestType NaN = std::numeric_limits<TestType>::quiet_NaN();
+
+    SECTION("Success")
+    {
+        const N    x {4.0};
+        const auto sum = x + N {1.0};
+        REQUIRE(sum.has_value());
+        REQUIRE(**sum == TestType {5.0});
+        REQUIRE(**x.sqrt() == TestType {2.0});
+        REQUIRE(**N::fromValue(3.0) == TestType {3.0});
+        REQUIRE(**x.pow(2) == TestType {16.0});
+    }
+    SECTION("Errors")
+    {
+        const N x {INF};
+        REQUIRE((x - x).error() == notnan::NaNError {notnan::Operation::Subtract, notnan::Operand::Result});
+        REQUIRE((x + NaN).error() == notnan::NaNError {notnan::Operation::Add, notnan::Operand::Rhs});
+        REQUIRE((NaN / x).error() == notnan::NaNError {notnan::Operation::Divide, notnan::Operand::Lhs});
+        REQUIRE(N {-1.0}.log().error() == notnan::NaNError {notnan::Operation::Log, notnan::Operand::Result});
+        REQUIRE(x.atan2(NaN).error() == notnan::NaNError {notnan::Operation::Atan2, notnan::Operand::Rhs});
+        REQUIRE(N::fromValue(NaN).error() == notnan::NaNError {notnan::Operation::Construct, notnan::Operand::Value});
+    }
+    SECTION("In-place operations leave the value unchanged on error")
+    {
+        N x {INF};
+        REQUIRE((x += 1).has_value());
+        REQUIRE(!(x -= INF).has_value());
+        REQUIRE(*x == INF);
+        REQUIRE((x = NaN).error() == notnan::NaNError {notnan::Operation::Assign, notnan::Operand::Value});
+        REQUIRE(*x == INF);
+    }
+}
+
+TEMPLATE_TEST_CASE("Unchecked policy", "[NotNaN][Policy]", float, double, long double)
+{
+    using N                = NotNaN<TestType, notnan::UncheckedPolicy>;
+    constexpr TestType INF = std::numeric_limits<TestType>::infinity();
+
+    // nothing is checked, the caller takes responsibility
+    const N x {INF};
+    REQUIRE_NOTHROW(x - x);
+    REQUIRE(std::isnan(*(x - x)));
+    REQUIRE(*(x + 1) == INF);
+}
+
+TEMPLATE_TEST_CASE("Try functions", "[NotNaN][Policy]", float, double, long double)
+{
+    using N                = NotNaN<TestType>;
+    constexpr TestType NaN = std::numeric_limits<TestType>::quiet_NaN();
+    constexpr TestType INF = std::numeric_limits<TestType>::infinity();
+
+    STATIC_REQUIRE(std::is_same_v<decltype(N::tryFromValue(0)), std::expected<N, notnan::NaNError>>);
+    STATIC_REQUIRE(noexcept(std::declval<const N&>().trySqrt()));
+    STATIC_REQUIRE(std::is_trivially_copyable_v<notnan::NaNError>);
+
+    // the throwing policy is bypassed
+    REQUIRE_NOTHROW(N::tryFromValue(NaN));
+    REQUIRE(N::tryFromValue(NaN).error() == notnan::NaNError {notnan::Operation::Construct, notnan::Operand::Value});
+    REQUIRE(*N::tryFromValue(2) == N {2});
+
+    const N inf {INF};
+    REQUIRE(inf.trySubtract(inf).error() == notnan::NaNError {notnan::Operation::Subtract, notnan::Operand::Result});
+    REQUIRE(inf.tryMultiply(0).error() == notnan::NaNError {notnan::Operation::Multiply, notnan::Operand::Result});
+    REQUIRE(N {1}.tryAdd(NaN).error() == notnan::NaNError {notnan::Operation::Add, notnan::Operand::Rhs});
+    REQUIRE(N {0}.tryDivide(N {0}).error() == notnan::NaNError {notnan::Operation::Divide, notnan::Operand::Result});
+    REQUIRE(**N {1}.tryAdd(2) == 3);
+
+    REQUIRE(N {-1}.trySqrt().error() == notnan::NaNError {notnan::Operation::Sqrt, notnan::Operand::Result});
+    REQUIRE(N {-1}.tryLog().error() == notnan::NaNError {notnan::Operation::Log, notnan::Operand::Result});
+    REQUIRE(N {2}.tryPow(NaN).error() == notnan::NaNError {notnan::Operation::Pow, notnan::Operand::Rhs});
+    REQUIRE(N {2}.tryAsin().error() == notnan::NaNError {notnan::Operation::Asin, notnan::Operand::Result});
+    REQUIRE(**N {4}.trySqrt() == 2);
+    REQUIRE(**N {2}.tryPow(N {3}) == 8);
+
+    REQUIRE(notnan::describe({notnan::Operation::Sqrt, notnan::Operand::Result}) == "Result of sqrt is NaN");
+}
+
+#if __cpp_lib_expected >= 202211L
+TEMPLATE_TEST_CASE("Try function chaining", "[NotNaN][Policy]", float, double, long double)
+{
+    using N = NotNaN<TestType>;
+
+    const auto chain = [](const TestType value)
+    {
+        return N::tryFromValue(value)
+          .and_then([](const N& x) { return x.tryLog(); })
+          .and_then([](const N& x) { return x.trySqrt(); });
+    };
+
+    REQUIRE(**chain(1) == 0);
+    // the first failing step is reported, the rest of the chain is skipped
+    REQUIRE(chain(-1).error() == notnan::NaNError {notnan::Operation::Log, notnan::Operand::Result});
+    REQUIRE(chain(TestType {0.5}).error() == notnan::NaNError {notnan::Operation::Sqrt, notnan::Operand::Result});
+}
+#endif
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#pragma GCC diagnostic pop
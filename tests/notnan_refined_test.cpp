@@ -0,0 +1,266 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include "../NotNaNRefined.hpp"
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <compare>
+#include <expected>
+#include <format>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+namespace
+{
+template <typename N>
+concept HasAddAssign = requires (N& lhs, const N& rhs) { lhs += rhs; };
+
+template <typename N>
+concept HasSubtractAssign = requires (N& lhs, const N& rhs) { lhs -= rhs; };
+
+template <typename N>
+concept HasMultiplyAssign = requires (N& lhs, const N& rhs) { lhs *= rhs; };
+}    // namespace
+
+TEMPLATE_TEST_CASE("Refined result types", "[NotNaN][Refined]", float, double, long double)
+{
+    using N  = NotNaN<TestType>;
+    using F  = notnan::Finite<TestType>;
+    using NN = notnan::NonNegative<TestType>;
+    using P  = notnan::Positive<TestType>;
+    using U  = notnan::UnitInterval<TestType>;
+    using FP = notnan::Refined<TestType, notnan::refinement::FINITE | notnan::refinement::POSITIVE | notnan::refinement::NON_NEGATIVE>;
+    using FN = notnan::Refined<TestType, notnan::refinement::FINITE | notnan::refinement::NON_NEGATIVE>;
+    using B  = notnan::Refined<TestType, notnan::refinement::UNIT_BOUNDED | notnan::refinement::FINITE>;
+
+    // the checks that are left are those at real domain boundaries
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<F>() * std::declval<F>()), N>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<F>() + std::declval<F>()), N>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<F>() - std::declval<F>()), N>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<NN>() + std::declval<NN>()), NN>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<P>() + std::declval<NN>()), P>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<NN>() - std::declval<NN>()), N>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<P>() * std::declval<P>()), NN>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<NN>() / std::declval<P>()), NN>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<NN>() / std::declval<NN>()), N>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<F>() / std::declval<FP>()), N>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<U>() * std::declval<U>()), U>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<U>() * std::declval<F>()), F>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<U>() + std::declval<U>()), FN>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<U>() - std::declval<U>()), B>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<U>() * std::declval<N>()), N>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<N>() + std::declval<NN>()), N>);
+
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<NN>().sqrt()), NN>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<F>().sqrt()), FN>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<U>().sqrt()), U>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<FP>().log()), F>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<NN>().log()), N>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<U>().exp()), FP>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<F>().exp()), NN>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<F>().sin()), B>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<U>().acos()), FN>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<B>().asin()), F>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<F>().abs()), FN>);
+    STATIC_REQUIRE(std::same_as<decltype(-std::declval<U>()), B>);
+    STATIC_REQUIRE(std::same_as<decltype(-std::declval<NN>()), N>);
+
+    // in place only where no check is needed and the refinements are kept
+    STATIC_REQUIRE(HasAddAssign<NN>);
+    STATIC_REQUIRE(HasAddAssign<P>);
+    STATIC_REQUIRE_FALSE(HasAddAssign<F>);
+    STATIC_REQUIRE_FALSE(HasSubtractAssign<NN>);
+    STATIC_REQUIRE(HasMultiplyAssign<U>);
+    STATIC_REQUIRE_FALSE(HasMultiplyAssign<P>);
+
+    // refinements are dropped implicitly, added explicitly
+    STATIC_REQUIRE(std::is_convertible_v<U, NN>);
+    STATIC_REQUIRE(std::is_convertible_v<U, N>);
+    STATIC_REQUIRE_FALSE(std::is_convertible_v<NN, U>);
+    STATIC_REQUIRE(std::is_constructible_v<U, NN>);
+    STATIC_REQUIRE(sizeof(U) == sizeof(TestType));
+
+    // only operations that may still fail go through the policy's result type
+    using E  = notnan::Finite<TestType, notnan::ExpectedPolicy>;
+    using EN = NotNaN<TestType, notnan::ExpectedPolicy>;
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<E>() * std::declval<E>()), EN>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<E>().sqrt()), std::expected<notnan::Refined<TestType, notnan::refinement::FINITE | notnan::refinement::NON_NEGATIVE, notnan::ExpectedPolicy>, notnan::NaNError>>);
+}
+
+TEMPLATE_TEST_CASE("Refined values", "[NotNaN][Refined]", float, double, long double)
+{
+    using L  = std::numeric_limits<TestType>;
+    using N  = NotNaN<TestType>;
+    using F  = notnan::Finite<TestType>;
+    using NN = notnan::NonNegative<TestType>;
+    using P  = notnan::Positive<TestType>;
+    using U  = notnan::UnitInterval<TestType>;
+
+    const U w {0.25};
+    const F a {2};
+    const F b {-6};
+    const N r = w * a + (U {1} - w) * b;
+    REQUIRE(*r == -4);
+
+    NN sum {0};
+    for (int i = 1; i <= 4; ++i)
+    {
+        sum += NN {static_cast<TestType>(i)};
+    }
+    REQUIRE(*sum == 10);
+    REQUIRE(*(sum / P {4}).sqrt() == std::sqrt(TestType {2.5}));
+    REQUIRE(*U {0.5}.acos() == std::acos(TestType {0.5}));
+    REQUIRE(*(-U {0.5}) == -0.5);
+    REQUIRE(std::format("{}", U {0.5}) == "0.5");
+
+    // infinities are fine where they can't produce NaN
+    const NN inf {L::infinity()};
+    REQUIRE(*(inf + inf) == L::infinity());
+    REQUIRE(*(F {L::max()} * F {L::max()}) == L::infinity());
+    REQUIRE(*(NN {-0.0} / P {1}) == 0);
+
+    // the checks that are left report through the policy
+    REQUIRE_THROWS_AS(inf - inf, std::runtime_error);
+    REQUIRE_THROWS_AS(NN {0} * inf, std::runtime_error);
+    REQUIRE_THROWS_AS(NN {0} / NN {0}, std::runtime_error);
+    REQUIRE_THROWS_AS(F {-1}.sqrt(), std::invalid_argument);
+    REQUIRE_THROWS_AS(N {L::infinity()} - inf, std::runtime_error);
+    REQUIRE(*F {4}.sqrt() == 2);
+
+    using E = notnan::NonNegative<TestType, notnan::ExpectedPolicy>;
+    REQUIRE((E {L::infinity()} - E {L::infinity()}).error() == notnan::NaNError {notnan::Operation::Subtract, notnan::Operand::Result});
+    REQUIRE(*(E {1} + E {2}) == 3);
+
+    // construction checks NaN and the refinements through the policy
+    REQUIRE_THROWS_AS(F {L::quiet_NaN()}, std::invalid_argument);
+    REQUIRE_THROWS_AS(F {L::infinity()}, std::invalid_argument);
+    REQUIRE_THROWS_AS(NN {-1}, std::invalid_argument);
+    REQUIRE_THROWS_AS(P {0}, std::invalid_argument);
+    REQUIRE_THROWS_AS(U {1.5}, std::invalid_argument);
+    REQUIRE_THROWS_AS(U {NN {2}}, std::invalid_argument);
+    REQUIRE_THROWS_AS(NN {N {-2}}, std::invalid_argument);
+    REQUIRE(*U {NN {1}} == 1);
+    REQUIRE(*NN {-0.0} == 0);
+    try
+    {
+        static_cast<void>(U {-0.5});
+        FAIL("no error");
+    }
+    catch (const std::invalid_argument& error)
+    {
+        REQUIRE(std::string {error.what()} == "-0.5 is not non-negative and in [-1, 1]");
+    }
+
+    REQUIRE(*U::fromValue(0.5) == 0.5);
+    REQUIRE_THROWS_WITH(U::fromValue(2), "2 is not non-negative and in [-1, 1]");
+    REQUIRE_THROWS_AS(F::fromValue(L::quiet_NaN()), std::invalid_argument);
+    REQUIRE(U::tryFromValue(0.5).has_value());
+    REQUIRE_FALSE(U::tryFromValue(2).has_value());
+    REQUIRE_FALSE(F::tryFromValue(L::quiet_NaN()).has_value());
+
+    // other policies get the error of a bad constructor argument
+    using EU                     = notnan::UnitInterval<TestType, notnan::ExpectedPolicy>;
+    constexpr notnan::NaNError BAD {notnan::Operation::Construct, notnan::Operand::Value};
+    REQUIRE(*EU::fromValue(0.5).value() == 0.5);
+    REQUIRE(EU::fromValue(2).error() == BAD);
+    REQUIRE(EU::fromValue(L::quiet_NaN()).error() == BAD);
+    REQUIRE(*notnan::UnitInterval<TestType, notnan::UncheckedPolicy>::fromValue(2) == 2);
+
+    // comparisons
+    REQUIRE(U {0.5} == NN {0.5});
+    REQUIRE(NN {0} == NN {-0.0});
+    REQUIRE(((U {0.5} <=> F {-3}) == std::strong_ordering::greater));
+    REQUIRE(N {1} == U {1});
+    REQUIRE(U {0.5} < 1);
+    REQUIRE(2 > U {0.5});
+    REQUIRE_THROWS_AS(U {0.5} < L::quiet_NaN(), std::invalid_argument);
+}
+
+// Every claim of the propagation table, checked on values at the edges of the refinements
+TEMPLATE_TEST_CASE("Refinement propagation", "[NotNaN][Refined]", float, double, long double)
+{
+    using L = std::numeric_limits<TestType>;
+    using notnan::Operation;
+    namespace r = notnan::refinement;
+
+    const std::vector<TestType> values {
+      -L::infinity(), L::lowest(), -2, -1, -0.5, -L::denorm_min(), -0.0, 0, L::denorm_min(), L::min(), 0.5, 1, 2,
+      L::max(), L::infinity()
+    };
+    const std::vector<notnan::Refinements> sets {
+      0,
+      r::FINITE,
+      r::NON_NEGATIVE,
+      r::FINITE | r::NON_NEGATIVE,
+      r::POSITIVE | r::NON_NEGATIVE,
+      r::FINITE | r::POSITIVE | r::NON_NEGATIVE,
+      r::UNIT_BOUNDED | r::FINITE,
+      r::UNIT_BOUNDED | r::FINITE | r::NON_NEGATIVE,
+      r::UNIT_BOUNDED | r::FINITE | r::POSITIVE | r::NON_NEGATIVE,
+    };
+    const auto satisfies = [](const TestType value, const notnan::Refinements refinements)
+    { return refinements == 0 ? !std::isnan(value) : notnan::detail::satisfies(value, refinements); };
+    const auto verify = [&](const Operation operation, const notnan::Refinements lhs, const notnan::Refinements rhs, const TestType result)
+    {
+        const notnan::detail::Propagation propagation = notnan::detail::propagate(operation, lhs, rhs);
+        if (!propagation.check)
+        {
+            REQUIRE_FALSE(std::isnan(result));
+        }
+        if (!std::isnan(result) && !satisfies(result, propagation.refinements))
+        {
+            FAIL(std::format("{} {:x} {:x} gives {}", notnan::toString(operation), lhs, rhs, result));
+        }
+    };
+
+    for (const notnan::Refinements lhs : sets)
+    {
+        for (const TestType x : values)
+        {
+            if (!satisfies(x, lhs))
+            {
+                continue;
+            }
+            verify(Operation::Sqrt, lhs, 0, std::sqrt(x));
+            verify(Operation::Log, lhs, 0, std::log(x));
+            verify(Operation::Exp, lhs, 0, std::exp(x));
+            verify(Operation::Sin, lhs, 0, std::sin(x));
+            verify(Operation::Cos, lhs, 0, std::cos(x));
+            verify(Operation::Asin, lhs, 0, std::asin(x));
+            verify(Operation::Acos, lhs, 0, std::acos(x));
+            verify(Operation::Abs, lhs, 0, std::abs(x));
+
+            for (const notnan::Refinements rhs : sets)
+            {
+                for (const TestType y : values)
+                {
+                    if (!satisfies(y, rhs))
+                    {
+                        continue;
+                    }
+                    verify(Operation::Add, lhs, rhs, x + y);
+                    verify(Operation::Subtract, lhs, rhs, x - y);
+                    verify(Operation::Multiply, lhs, rhs, x * y);
+                    verify(Operation::Divide, lhs, rhs, x / y);
+                }
+            }
+        }
+    }
+}
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#pragma GCC diagnostic pop
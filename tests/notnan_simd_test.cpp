@@ -0,0 +1,215 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+// libc++ has no <experimental/simd>
+#if __has_include(<experimental/simd>)
+
+#include "../NotNaNSimd.hpp"
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstddef>
+#include <expected>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+namespace
+{
+// values in 0.5 steps around zero, so that floor and the comparisons have something to do
+template <typename S>
+auto load(const typename S::Type offset) -> S
+{
+    using N = NotNaN<typename S::Type, typename S::PolicyType>;
+    std::vector<N> values;
+    for (std::size_t i = 0; i < S::size(); ++i)
+    {
+        values.emplace_back(static_cast<typename S::Type>(i) * typename S::Type {0.5} + offset);
+    }
+    return S {std::span<const N> {values}};
+}
+}    // namespace
+
+// the native sizes and ones that need a fixed size simd, depending on the target
+TEMPLATE_TEST_CASE(
+    "Simd lanes match NotNaN",
+    "[NotNaN][Simd]",
+    (NotNaNSimd<float, 4>),
+    (NotNaNSimd<float, 8>),
+    (NotNaNSimd<float, 16>),
+    (NotNaNSimd<double, 2>),
+    (NotNaNSimd<double, 3>),
+    (NotNaNSimd<double, 8>)
+)
+{
+    using T              = typename TestType::Type;
+    using N              = NotNaN<T>;
+    constexpr auto LANES = TestType::size();
+
+    const TestType x = load<TestType>(T {-2});
+    const TestType y = load<TestType>(T {0.25});
+
+    const auto check = [&](const TestType& result, const auto& expected)
+    {
+        for (std::size_t lane = 0; lane < LANES; ++lane)
+        {
+            REQUIRE(result[lane] == expected(x[lane], y[lane]));
+        }
+    };
+    check(x + y, [](const N a, const N b) { return a + b; });
+    check(x - y, [](const N a, const N b) { return a - b; });
+    check(x * y, [](const N a, const N b) { return a * b; });
+    check(x / y, [](const N a, const N b) { return a / b; });
+    check(x * T {3} - N {1}, [](const N a, const N /* b */) { return a * T {3} - N {1}; });
+    check(T {3} / y, [](const N /* a */, const N b) { return T {3} / b; });
+    check(-x, [](const N a, const N /* b */) { return -a; });
+    check(+x, [](const N a, const N /* b */) { return a; });
+    check(x.abs(), [](const N a, const N /* b */) { return a.abs(); });
+    check(x.floor(), [](const N a, const N /* b */) { return a.floor(); });
+    check(y.sqrt(), [](const N /* a */, const N b) { return b.sqrt(); });
+    check(min(x, y), [](const N a, const N b) { return std::min(a, b); });
+    check(max(x, y), [](const N a, const N b) { return std::max(a, b); });
+
+    TestType z = x;
+    z += y;
+    z *= T {2};
+    z -= N {1};
+    z /= y;
+    check(z, [](const N a, const N b) { return ((a + b) * T {2} - N {1}) / b; });
+
+    // comparisons give a mask with a lane for each comparison of NotNaN
+    const TestType                    half {N {0.5}};
+    const typename TestType::MaskType less = x < half;
+    for (std::size_t lane = 0; lane < LANES; ++lane)
+    {
+        REQUIRE(less[lane] == (x[lane] < N {0.5}));
+        REQUIRE((x <= T {0.5})[lane] == (x[lane] <= N {0.5}));
+        REQUIRE((x > half)[lane] == (x[lane] > N {0.5}));
+        REQUIRE((N {0.5} >= x)[lane] == (N {0.5} >= x[lane]));
+        REQUIRE((x == half)[lane] == (x[lane] == N {0.5}));
+        REQUIRE((x != half)[lane] == (x[lane] != N {0.5}));
+    }
+    REQUIRE(all_of(x == x));
+    REQUIRE(none_of(x != x));
+
+    // round trip through the values
+    std::vector<N> stored(LANES, N {0});
+    z.store(std::span<N> {stored});
+    REQUIRE(all_of(TestType {std::span<const N> {stored}} == z));
+    REQUIRE(all_of(TestType {*z} == z));
+    REQUIRE(all_of(*TestType::fromValues(*z) == *z));
+}
+
+TEMPLATE_TEST_CASE(
+    "Simd NaN checks",
+    "[NotNaN][Simd]",
+    (NotNaNSimd<float, 8>),
+    (NotNaNSimd<float, 5>),
+    (NotNaNSimd<double, 4>),
+    (NotNaNSimd<double, 3>)
+)
+{
+    using T              = typename TestType::Type;
+    using N              = NotNaN<T>;
+    using Simd           = typename TestType::SimdType;
+    constexpr auto LANES = TestType::size();
+    constexpr T    NaN   = std::numeric_limits<T>::quiet_NaN();
+    constexpr T    inf   = std::numeric_limits<T>::infinity();
+
+    // a single NaN lane is found wherever it is, with either sign
+    for (std::size_t lane = 0; lane < LANES; ++lane)
+    {
+        for (const T nan : {NaN, -NaN, std::numeric_limits<T>::signaling_NaN()})
+        {
+            Simd values {T {1}};
+            values[lane] = nan;
+            REQUIRE_THROWS_AS(TestType {values}, std::invalid_argument);
+            REQUIRE_FALSE(notnan::detail::anyNaN(Simd {T {1}}));
+            REQUIRE(notnan::detail::anyNaN(values));
+        }
+        Simd infinite {T {1}};
+        infinite[lane] = -inf;
+        REQUIRE_FALSE(notnan::detail::anyNaN(infinite));
+    }
+
+    const TestType one {N {1}};
+    const TestType zero {N {0}};
+    const TestType infinity {N {inf}};
+
+    // NaN results are raised like those of NotNaN
+    REQUIRE_THROWS_AS(infinity - infinity, std::runtime_error);
+    REQUIRE_THROWS_AS(zero * infinity, std::runtime_error);
+    REQUIRE_THROWS_AS(zero / zero, std::runtime_error);
+    REQUIRE_THROWS_AS((-one).sqrt(), std::invalid_argument);
+    REQUIRE_NOTHROW(one / zero);
+
+    // and so are NaN arguments, with the side
+    try
+    {
+        static_cast<void>(one + NaN);
+        FAIL("NaN argument did not throw");
+    }
+    catch (const std::invalid_argument& error)
+    {
+        REQUIRE(std::string {error.what()} == "rhs of addition is NaN");
+    }
+    REQUIRE_THROWS_AS(NaN * one, std::invalid_argument);
+    REQUIRE_THROWS_AS(static_cast<void>(one < NaN), std::invalid_argument);
+    REQUIRE_THROWS_AS(static_cast<void>(NaN == one), std::invalid_argument);
+
+    // compound assignment leaves the lanes alone when it fails
+    TestType x = infinity;
+    REQUIRE_THROWS_AS(x -= infinity, std::runtime_error);
+    REQUIRE_THROWS_AS(x *= NaN, std::invalid_argument);
+    REQUIRE(all_of(x == inf));
+
+    // a load or store of the wrong size
+    std::vector<N> values(LANES + 1, N {0});
+    REQUIRE_THROWS_AS(TestType {std::span<const N> {values}}, std::invalid_argument);
+    REQUIRE_THROWS_AS(one.store(std::span<N> {values}), std::invalid_argument);
+    REQUIRE_THROWS_AS(one.store(std::span<N> {values}.first(LANES - 1)), std::invalid_argument);
+}
+
+TEMPLATE_TEST_CASE("Simd policies", "[NotNaN][Simd]", float, double)
+{
+    using E                = NotNaNSimd<TestType, 4, notnan::ExpectedPolicy>;
+    using U                = NotNaNSimd<TestType, 4, notnan::UncheckedPolicy>;
+    constexpr TestType NaN = std::numeric_limits<TestType>::quiet_NaN();
+    constexpr TestType inf = std::numeric_limits<TestType>::infinity();
+
+    // errors come back in the expected
+    const E    infinity {NotNaN<TestType, notnan::ExpectedPolicy> {inf}};
+    const auto difference = infinity - infinity;
+    REQUIRE_FALSE(difference.has_value());
+    REQUIRE(difference.error() == notnan::NaNError {notnan::Operation::Subtract, notnan::Operand::Result});
+    REQUIRE((infinity + TestType {1}).has_value());
+    REQUIRE((infinity * NaN).error() == notnan::NaNError {notnan::Operation::Multiply, notnan::Operand::Rhs});
+    REQUIRE(E::fromValues(typename E::SimdType {NaN}).error()
+            == notnan::NaNError {notnan::Operation::Construct, notnan::Operand::Value});
+
+    E x = infinity;
+    REQUIRE_FALSE((x -= infinity).has_value());
+    REQUIRE(all_of(*x == inf));
+    REQUIRE((x += TestType {1}).has_value());
+
+    // nothing is checked
+    const U unchecked {typename U::SimdType {NaN}};
+    REQUIRE(std::isnan(*(unchecked + TestType {1})[0]));
+    REQUIRE(std::isnan(*U {typename U::SimdType {-TestType {1}}}.sqrt()[3]));
+}
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#endif
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,29 @@
+# Compares the hot .text of the checked kernel with the raw one.
+# cmake -DOBJDUMP=<objdump> -DOBJECT=<notnan_size_kernel object> -DBUDGET=<ratio> -P notnan_size_check.cmake
+
+execute_process(
+    COMMAND ${OBJDUMP} -h ${OBJECT}
+    OUTPUT_VARIABLE HEADERS
+    RESULT_VARIABLE STATUS
+)
+if (NOT STATUS EQUAL 0)
+    message(FATAL_ERROR "${OBJDUMP} -h ${OBJECT} failed")
+endif()
+
+function(section_size NAME RESULT)
+    string(REGEX MATCH "[ \t]\\.text\\.${NAME}[ \t]+([0-9a-fA-F]+)" MATCHED "${HEADERS}")
+    if (NOT MATCHED)
+        message(FATAL_ERROR "No section .text.${NAME} in ${OBJECT}")
+    endif()
+    math(EXPR SIZE "0x${CMAKE_MATCH_1}")
+    set(${RESULT} ${SIZE} PARENT_SCOPE)
+endfunction()
+
+section_size(notnanSizeRaw RAW)
+section_size(notnanSizeChecked CHECKED)
+math(EXPR LIMIT "${RAW} * ${BUDGET}")
+
+message(STATUS "hot .text: raw ${RAW} bytes, NotNaN ${CHECKED} bytes, limit ${LIMIT} bytes")
+if (CHECKED GREATER LIMIT)
+    message(FATAL_ERROR "NotNaN kernel is ${CHECKED} bytes, more than ${BUDGET} times the raw kernel (${RAW} bytes)")
+endif()
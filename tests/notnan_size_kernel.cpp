@@ -0,0 +1,45 @@
+#include "../NotNaN.hpp"
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+
+// The same kernel on raw doubles and on NotNaN<double>, compiled with -ffunction-sections.
+// notnan_size_check compares the hot .text of both, the error paths belong to .text.unlikely.
+
+namespace
+{
+template <typename Number>
+[[gnu::always_inline]]
+inline auto kernel(const double* const values, const std::size_t size) -> double
+{
+    Number sum {0.0};
+    Number max {0.0};
+    for (std::size_t idx = 0; idx < size; ++idx)
+    {
+        const Number value {values[idx]};
+        sum += value * value / (value + 1.0);
+        if (max < value)
+        {
+            max = value;
+        }
+    }
+    if constexpr (std::same_as<Number, double>)
+    {
+        return std::sqrt(sum) + max;
+    }
+    else
+    {
+        return *(sum.sqrt() + max);
+    }
+}
+}    // namespace
+
+extern "C" auto notnanSizeRaw(const double* const values, const std::size_t size) -> double
+{
+    return kernel<double>(values, size);
+}
+
+extern "C" auto notnanSizeChecked(const double* const values, const std::size_t size) -> double
+{
+    return kernel<NotNaN<double>>(values, size);
+}
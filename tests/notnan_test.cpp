@@ -15,13 +15,28 @@
 #include <catch2/generators/catch_generators_adapters.hpp>
 #include <catch2/generators/catch_generators_random.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <algorithm>
 #include <cmath>
+#include <compare>
 #include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <functional>
 #include <limits>
 #include <numbers>
 #include <numeric>
+#include <random>
+#include <span>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
+#if __has_include(<stdfloat>)
+#include <stdfloat>
+#endif
 
 // NOLINTBEGIN(readability-magic-numbers)
 // NOLINTBEGIN(implicit-float-conversion)
@@ -102,6 +117,28 @@ auto generateTestValues()
     );
 }
 
+// The 16 bit formats have no implicit conversion from double, they take the float values, which they all hold
+template <std::floating_point T>
+    requires notnan::detail::IsHalfPrecision<T>
+auto generateTestValues()
+{
+    return static_cast<T>(generateTestValues<float>());
+}
+
+// The <cmath> functions need not have 16 bit overloads, the 16 bit formats go through float, which holds all of them
+template <std::floating_point T>
+auto widen(const T value)
+{
+    if constexpr (notnan::detail::IsHalfPrecision<T>)
+    {
+        return static_cast<float>(value);
+    }
+    else
+    {
+        return value;
+    }
+}
+
 template <std::integral T>
 auto getTestValueType(const T& value) -> std::string
 {
@@ -201,12 +238,18 @@ auto getTestValueType(const T& value) -> std::string
 }    // namespace
 
 #define PAIRS_ARITHMETIC_TO_FLOATING (std::pair<int, float>), (std::pair<int, double>), (std::pair<int, long double>), (std::pair<float, float>), (std::pair<float, double>), (std::pair<float, long double>), (std::pair<double, float>), (std::pair<double, double>), (std::pair<double, long double>), (std::pair<long double, float>), (std::pair<long double, double>), (std::pair<long double, long double>)
+// The 16 bit formats, where the compiler has them
+#if defined(__STDCPP_FLOAT16_T__) && defined(__STDCPP_BFLOAT16_T__)
+#define HALF_PRECISION_TYPES , std::float16_t, std::bfloat16_t
+#else
+#define HALF_PRECISION_TYPES
+#endif
 #define PAIRS_FLOATING_TO_FLOATING (std::pair<float, float>), (std::pair<float, double>), (std::pair<float, long double>), (std::pair<double, float>), (std::pair<double, double>), (std::pair<double, long double>), (std::pair<long double, float>), (std::pair<long double, double>), (std::pair<long double, long double>)
 
-TEMPLATE_TEST_CASE("Type deduction", "[NotNaN][TypeDeduction]", float, double, long double)
+TEMPLATE_TEST_CASE("Type deduction", "[NotNaN][TypeDeduction]", float, double, long double HALF_PRECISION_TYPES)
 {
     auto rv = generateTestValues<TestType>();
-    if (std::isnan(rv))
+    if (std::isnan(widen(rv)))
     {
         REQUIRE_THROWS(NotNaN {rv});
     }
@@ -322,10 +365,10 @@ TEMPLATE_TEST_CASE("Assignment", "[NotNaN][Assignment]", PAIRS_ARITHMETIC_TO_FLO
     }
 }
 
-TEMPLATE_TEST_CASE("Conversion", "[NotNaN][Conversion]", float, double, long double)
+TEMPLATE_TEST_CASE("Conversion", "[NotNaN][Conversion]", float, double, long double HALF_PRECISION_TYPES)
 {
     auto tv = generateTestValues<TestType>();
-    if (std::isnan(tv))
+    if (std::isnan(widen(tv)))
     {
         REQUIRE_THROWS(NotNaN {tv});
         return;    // no need to test further
@@ -1004,10 +1047,10 @@ TEMPLATE_TEST_CASE("Special Functions With Value", "[NotNaN][MathValue]", PAIRS_
     }
 }
 
-TEMPLATE_TEST_CASE("Unary Ops", "[NotNaN][UnaryOps]", float, double, long double)
+TEMPLATE_TEST_CASE("Unary Ops", "[NotNaN][UnaryOps]", float, double, long double HALF_PRECISION_TYPES)
 {
     auto tv = generateTestValues<TestType>();
-    if (std::isnan(tv))
+    if (std::isnan(widen(tv)))
     {
         REQUIRE_THROWS(NotNaN {tv});
         return;
@@ -1384,6 +1427,269 @@ TEMPLATE_TEST_CASE("Binary Ops", "[NotNaN][BinaryOps]", PAIRS_ARITHMETIC_TO_FLOA
 }
 
 
+TEMPLATE_TEST_CASE("Bulk validation", "[NotNaN][Bulk]", float, double, long double HALF_PRECISION_TYPES)
+{
+    // sizes around the vector widths and unroll factors of the SIMD kernels
+    const std::size_t size = GENERATE(0U, 1U, 3U, 4U, 7U, 8U, 15U, 16U, 17U, 31U, 32U, 33U, 63U, 64U, 65U, 127U, 1000U);
+    std::vector<TestType> values(size);
+    std::iota(values.begin(), values.end(), TestType {-10});
+
+    SECTION("Without NaN")
+    {
+        if (!values.empty())
+        {
+            values.front() = -std::numeric_limits<TestType>::infinity();
+            values.back()  = std::numeric_limits<TestType>::infinity();
+        }
+        REQUIRE(notnan::findNaN(std::span<const TestType> {values}) == size);
+
+        const auto view = notnan::validate(std::span<const TestType> {values});
+        REQUIRE(std::same_as<decltype(view), const std::span<const NotNaN<TestType>>>);
+        REQUIRE(view.size() == size);
+        REQUIRE(static_cast<const void*>(view.data()) == static_cast<const void*>(values.data()));
+        for (std::size_t idx = 0; idx < size; ++idx)
+        {
+            REQUIRE(*view[idx] == values[idx]);
+        }
+
+        const auto mutableView = notnan::validate(std::span {values});
+        REQUIRE(std::same_as<decltype(mutableView), const std::span<NotNaN<TestType>>>);
+        if (!values.empty())
+        {
+            mutableView.front() = TestType {42};
+            REQUIRE(values.front() == TestType {42});
+            REQUIRE_THROWS(mutableView.front() = std::numeric_limits<TestType>::quiet_NaN());
+        }
+    }
+    SECTION("With NaN")
+    {
+        for (std::size_t badIdx = 0; badIdx < size; ++badIdx)
+        {
+            std::vector<TestType> copy {values};
+            copy[badIdx] = std::numeric_limits<TestType>::quiet_NaN();
+            if (badIdx + 1 < size)
+            {
+                copy.back() = -std::numeric_limits<TestType>::quiet_NaN();
+            }
+            INFO("size = " << size << ", NaN at " << badIdx);
+            REQUIRE(notnan::findNaN(std::span<const TestType> {copy}) == badIdx);
+            REQUIRE_THROWS_AS(notnan::validate(std::span<const TestType> {copy}), std::invalid_argument);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Ordering and hashing", "[NotNaN][Comparison]", float, double, long double)
+{
+    using N = NotNaN<TestType>;
+    using L = std::numeric_limits<TestType>;
+
+    STATIC_REQUIRE(std::same_as<decltype(N {1} <=> N {2}), std::strong_ordering>);
+    STATIC_REQUIRE(std::same_as<decltype(N {1} <=> NotNaN {2.0F}), std::strong_ordering>);
+    STATIC_REQUIRE(std::totally_ordered<N>);
+
+    REQUIRE((N {1} <=> N {2}) == std::strong_ordering::less);
+    REQUIRE((N {L::infinity()} <=> N {L::max()}) == std::strong_ordering::greater);
+    REQUIRE((N {-L::infinity()} <=> N {L::lowest()}) == std::strong_ordering::less);
+    REQUIRE((N {L::denorm_min()} <=> N {0}) == std::strong_ordering::greater);
+    REQUIRE((N {0.5} <=> NotNaN {0.5F}) == std::strong_ordering::equal);
+
+    // signed zeros are equivalent, as for ==
+    const N zero {0.0};
+    const N negativeZero {-0.0};
+    REQUIRE((zero <=> negativeZero) == std::strong_ordering::equal);
+    REQUIRE(std::hash<N> {}(zero) == std::hash<N> {}(negativeZero));
+
+    std::vector<N> values {N {3}, N {-0.0}, N {L::infinity()}, N {-1}, N {0.0}, N {-L::infinity()}};
+    std::ranges::sort(values);
+    REQUIRE(std::ranges::is_sorted(values, std::less {}));
+    REQUIRE(*values.front() == -L::infinity());
+    REQUIRE(*values.back() == L::infinity());
+
+    // distinct values give distinct hashes, also in the low bits used by power of two tables
+    std::unordered_set<std::size_t> hashes;
+    std::unordered_set<std::size_t> lowBits;
+    for (int i = 0; i < 1024; ++i)
+    {
+        const std::size_t hash = std::hash<N> {}(N {static_cast<TestType>(i) / 8});
+        hashes.insert(hash);
+        lowBits.insert(hash & 0xFFFU);
+    }
+    REQUIRE(hashes.size() == 1024);
+    REQUIRE(lowBits.size() > 700);
+
+    std::unordered_map<N, int> map;
+    map[zero]                = 1;
+    map[negativeZero]        = 2;
+    map[N {L::infinity()}]   = 3;
+    map[N {L::denorm_min()}] = 4;
+    REQUIRE(map.size() == 3);
+    REQUIRE(map.at(zero) == 2);
+    REQUIRE(map.at(N {L::infinity()}) == 3);
+}
+
+TEMPLATE_TEST_CASE("Ordered bytes", "[NotNaN][OrderedBytes]", float, double, long double)
+{
+    using N = NotNaN<TestType>;
+    using L = std::numeric_limits<TestType>;
+
+    const auto compareBytes = [](const N& lhs, const N& rhs)
+    {
+        const auto lhsBytes = lhs.toOrderedBytes();
+        const auto rhsBytes = rhs.toOrderedBytes();
+        return std::memcmp(lhsBytes.data(), rhsBytes.data(), N::ORDERED_SIZE) <=> 0;
+    };
+
+    // random magnitudes over the whole exponent range, denormals included, and the special values
+    std::mt19937_64                          rng {7};
+    std::uniform_real_distribution<TestType> mantissa {-1, 1};
+    std::uniform_int_distribution<int>       exponent {L::min_exponent - L::digits, L::max_exponent};
+    std::vector<N>                           values {N {0.0}, N {-0.0}, N {1}, N {-1}};
+    for (const TestType special : {L::infinity(), L::max(), L::min(), L::denorm_min()})
+    {
+        values.emplace_back(special);
+        values.emplace_back(-special);
+    }
+    for (int i = 0; i < 2000; ++i)
+    {
+        values.emplace_back(std::ldexp(mantissa(rng), exponent(rng)));
+    }
+
+    for (const N& value : values)
+    {
+        const N back = N::fromOrderedBytes(value.toOrderedBytes());
+        REQUIRE(back == value);
+        REQUIRE((std::signbit(*back) == std::signbit(*value) || *value == 0));
+    }
+    REQUIRE_FALSE(std::signbit(*N::fromOrderedBytes(N {-0.0}.toOrderedBytes())));
+    REQUIRE(N {0.0}.toOrderedBytes() == N {-0.0}.toOrderedBytes());
+
+    std::ranges::sort(values);
+    for (std::size_t i = 0; i + 1 < values.size(); ++i)
+    {
+        REQUIRE((compareBytes(values[i], values[i + 1]) == (values[i] <=> values[i + 1])));
+    }
+    for (int i = 0; i < 2000; ++i)
+    {
+        const N& lhs = values[rng() % values.size()];
+        const N& rhs = values[rng() % values.size()];
+        REQUIRE((compareBytes(lhs, rhs) == (lhs <=> rhs)));
+    }
+
+    // one more than the bytes of infinity is NaN
+    auto nanBytes = N {L::infinity()}.toOrderedBytes();
+    nanBytes.back() = static_cast<std::byte>(std::to_integer<unsigned>(nanBytes.back()) + 1);
+    REQUIRE_THROWS_AS(N::fromOrderedBytes(nanBytes), std::invalid_argument);
+
+    // bulk versions
+    std::vector<std::byte> bytes(values.size() * N::ORDERED_SIZE);
+    notnan::toOrderedBytes(std::span<const N> {values}, bytes);
+    std::vector<N> decoded(values.size(), N {1});
+    notnan::fromOrderedBytes(bytes, std::span {decoded});
+    REQUIRE(decoded == values);
+    REQUIRE(std::ranges::equal(std::span {bytes}.first(N::ORDERED_SIZE), values.front().toOrderedBytes()));
+
+    // a NaN stops the decoding, the values from it on are left as they were
+    std::ranges::copy(nanBytes, bytes.begin() + static_cast<std::ptrdiff_t>(5 * N::ORDERED_SIZE));
+    std::ranges::fill(decoded, N {1});
+    REQUIRE_THROWS_WITH(notnan::fromOrderedBytes(bytes, std::span {decoded}), Catch::Matchers::ContainsSubstring("at index 5"));
+    REQUIRE(std::ranges::equal(std::span {decoded}.first(5), std::span {values}.first(5)));
+    REQUIRE(std::ranges::all_of(std::span {decoded}.subspan(5), [](const N& value) { return value == 1; }));
+
+    using E = NotNaN<TestType, notnan::ExpectedPolicy>;
+    std::vector<E> expected(values.size(), E {1});
+    REQUIRE(
+      notnan::fromOrderedBytes(bytes, std::span {expected}).error()
+      == notnan::NaNError {notnan::Operation::Construct, notnan::Operand::Value}
+    );
+    REQUIRE(std::ranges::all_of(std::span {expected}.subspan(5), [](const E& value) { return value == 1; }));
+    REQUIRE(notnan::fromOrderedBytes(std::span {bytes}.first(5 * N::ORDERED_SIZE), std::span {expected}.first(5)).has_value());
+    REQUIRE(*expected[4] == *values[4]);
+    REQUIRE_THROWS_AS(notnan::toOrderedBytes(std::span<const N> {values}, std::span {bytes}.first(3)), std::invalid_argument);
+}
+
+#if defined(__STDCPP_FLOAT16_T__) && defined(__STDCPP_BFLOAT16_T__)
+TEMPLATE_TEST_CASE("Half precision", "[NotNaN][HalfPrecision]", std::float16_t, std::bfloat16_t)
+{
+    using N = NotNaN<TestType>;
+    using L = std::numeric_limits<TestType>;
+
+    STATIC_REQUIRE(sizeof(N) == 2);
+    REQUIRE(notnan::isNaN(L::quiet_NaN()));
+    REQUIRE(notnan::isNaN(-L::signaling_NaN()));
+    REQUIRE_FALSE(notnan::isNaN(L::infinity()));
+    REQUIRE_THROWS_AS(N {L::quiet_NaN()}, std::invalid_argument);
+
+    // arithmetic stays in the format and is rounded once from float
+    const N three {3};
+    const N third {TestType {1} / TestType {3}};
+    STATIC_REQUIRE(std::same_as<decltype(three * third), N>);
+    STATIC_REQUIRE(std::same_as<decltype(three + 1), N>);
+    STATIC_REQUIRE(std::same_as<decltype(three + 0.5F), N>);
+    REQUIRE(*(three * third) == static_cast<TestType>(3.0F * static_cast<float>(*third)));
+    REQUIRE(*(three + 1) == 4);
+    REQUIRE(*(three + 0.5F) == static_cast<TestType>(3.5F));
+    N sum {three};
+    sum += third;
+    sum -= 0.5;
+    REQUIRE(*sum == static_cast<TestType>(static_cast<double>(three + third) - 0.5));
+    REQUIRE(*(N {L::max()} * 2) == L::infinity());
+    REQUIRE_THROWS_AS(N {L::infinity()} - N {L::infinity()}, std::runtime_error);
+    REQUIRE_THROWS_AS(N {0} * L::infinity(), std::runtime_error);
+
+    // widening is implicit, narrowing explicit
+    STATIC_REQUIRE(std::is_convertible_v<N, NotNaN<float>>);
+    STATIC_REQUIRE_FALSE(std::is_convertible_v<NotNaN<float>, N>);
+    REQUIRE(*N {NotNaN<float> {0.25F}} == static_cast<TestType>(0.25F));
+    const NotNaN<float> widened = N {third};
+    REQUIRE(*widened == static_cast<float>(*third));
+
+    REQUIRE(std::format("{}", N {TestType {1} / 4}) == "0.25");
+    REQUIRE(std::format("{:.2f}", three) == "3.00");
+    REQUIRE((N {-TestType {0}} <=> N {0}) == std::strong_ordering::equal);
+    REQUIRE(std::hash<N> {}(N {-TestType {0}}) == std::hash<N> {}(N {0}));
+    REQUIRE(N::fromOrderedBytes(third.toOrderedBytes()) == third);
+
+    // bulk conversion from and to float, around the vector widths of the conversion kernels
+    std::vector<float> floats {-std::numeric_limits<float>::infinity(), 1e30F, -1e-30F, 65520.0F, -0.0F};
+    for (int i = 0; i < 100; ++i)
+    {
+        floats.push_back(std::ldexp(1.0F + static_cast<float>(i) / 128.0F, i % 40 - 20));
+    }
+    std::vector<N> values(floats.size(), N {1});
+    notnan::fromFloats(std::span<const float> {floats}, std::span {values});
+    for (std::size_t idx = 0; idx < floats.size(); ++idx)
+    {
+        INFO("index " << idx);
+        REQUIRE(*values[idx] == static_cast<TestType>(floats[idx]));
+    }
+
+    std::vector<NotNaN<float>> back(values.size(), NotNaN<float> {0.0F});
+    notnan::toFloats(std::span<const N> {values}, std::span {back});
+    for (std::size_t idx = 0; idx < values.size(); ++idx)
+    {
+        REQUIRE(*back[idx] == static_cast<float>(*values[idx]));
+    }
+
+    // a NaN is reported before anything is written
+    floats[42] = std::numeric_limits<float>::quiet_NaN();
+    std::ranges::fill(values, N {1});
+    REQUIRE_THROWS_WITH(
+      notnan::fromFloats(std::span<const float> {floats}, std::span {values}), Catch::Matchers::ContainsSubstring("at index 42")
+    );
+    REQUIRE(std::ranges::all_of(values, [](const N& value) { return value == 1; }));
+    REQUIRE_THROWS_AS(notnan::fromFloats(std::span<const float> {floats}.first(3), std::span {values}), std::invalid_argument);
+
+    using E = NotNaN<TestType, notnan::ExpectedPolicy>;
+    std::vector<E> expected(floats.size(), E {1});
+    const auto     result = notnan::fromFloats(std::span<const float> {floats}, std::span {expected});
+    REQUIRE(result.error() == notnan::NaNError {notnan::Operation::Construct, notnan::Operand::Value});
+    REQUIRE(std::ranges::all_of(expected, [](const E& value) { return value == 1; }));
+    floats[42] = 0.0F;
+    REQUIRE(notnan::fromFloats(std::span<const float> {floats}, std::span {expected})->data() == expected.data());
+    REQUIRE(*expected[42] == 0);
+}
+#endif
+
 // NOLINTEND(readability-identifier-naming)
 // NOLINTEND(implicit-float-conversion)
 // NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,176 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include <cfenv>
+
+#if defined(__linux__) && defined(__GLIBC__)
+
+#include "../NotNaNTrap.hpp"
+#include <array>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <csignal>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+namespace
+{
+// keeps the compiler from folding the operations at compile time
+template <typename T>
+auto opaque(const T value) -> T
+{
+    const volatile T copy = value;
+    return copy;
+}
+
+// Runs function in a child process. Returns what the child wrote to stderr if it aborted, nothing if it did not.
+template <typename Function>
+auto abortMessage(const Function& function) -> std::optional<std::string>
+{
+    std::array<int, 2> pipe {};
+    REQUIRE(::pipe(pipe.data()) == 0);
+    const pid_t child = ::fork();
+    REQUIRE(child != -1);
+    if (child == 0)
+    {
+        ::close(pipe[0]);
+        ::dup2(pipe[1], STDERR_FILENO);
+        // no core dumps and no test framework handler for the abort
+        const rlimit noCore {};
+        ::setrlimit(RLIMIT_CORE, &noCore);
+        std::signal(SIGABRT, SIG_DFL);
+        try
+        {
+            static_cast<void>(function());
+        }
+        catch (...)
+        {
+            ::_exit(2);
+        }
+        ::_exit(0);
+    }
+
+    ::close(pipe[1]);
+    std::string           message;
+    std::array<char, 256>   buffer {};
+    ssize_t               count = 0;
+    while ((count = ::read(pipe[0], buffer.data(), buffer.size())) > 0)
+    {
+        message.append(buffer.data(), static_cast<std::size_t>(count));
+    }
+    ::close(pipe[0]);
+
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    if (WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT)
+    {
+        return message;
+    }
+    return std::nullopt;
+}
+
+auto aborts(const auto& function) -> bool
+{
+    return abortMessage(function).has_value();
+}
+}    // namespace
+
+TEST_CASE("Trapping invalid operations", "[NotNaN][Trap]")
+{
+    const NotNaN<double> inf {opaque(std::numeric_limits<double>::infinity())};
+
+    SECTION("inf - inf is caught")
+    {
+        const auto message = abortMessage([&] { return notnan::trapInvalid([&] { return inf - inf; }); });
+        REQUIRE(message.has_value());
+        REQUIRE_THAT(*message, Catch::Matchers::ContainsSubstring("NotNaN trap: Result of guarded scope is NaN at 0x"));
+        REQUIRE(message->ends_with('\n'));
+    }
+
+    SECTION("results are returned")
+    {
+        REQUIRE(*notnan::trapInvalid([&] { return inf + 1; }) == std::numeric_limits<double>::infinity());
+        REQUIRE_FALSE(aborts([&] { return notnan::trapInvalid([&] { return inf + 1; }); }));
+    }
+
+    SECTION("without software checks")
+    {
+        using N = NotNaN<double, notnan::HardwarePolicy>;
+        const N hardwareInf {*inf};
+        REQUIRE(aborts([&] { return notnan::trapInvalid([&] { return *(hardwareInf * 0); }); }));
+        REQUIRE(aborts([&] { return notnan::trapInvalid([&] { return *N {opaque(-1.0)}.sqrt(); }); }));
+    }
+
+    SECTION("raw arithmetic traps as well")
+    {
+        REQUIRE(aborts([] { return notnan::trapInvalid([] { return opaque(opaque(0.0) / 0.0); }); }));
+        REQUIRE(aborts([] { return notnan::trapInvalid([] { return opaque(opaque(0.0L) / 0.0L); }); }));
+    }
+
+    SECTION("other exceptions pass through")
+    {
+        REQUIRE_THROWS_AS(
+          notnan::trapInvalid([] { return NotNaN<double> {std::numeric_limits<double>::quiet_NaN()}; }),
+          std::invalid_argument
+        );
+        REQUIRE((fegetexcept() & FE_INVALID) == 0);
+    }
+
+    SECTION("floating point environment is restored")
+    {
+        const int enabled = fegetexcept();
+        std::fesetround(FE_UPWARD);
+        // a pending flag would trap as soon as it is enabled
+        std::feclearexcept(FE_OVERFLOW | FE_INVALID);
+        feenableexcept(FE_OVERFLOW);
+        static_cast<void>(notnan::trapInvalid([&] { return inf + 1; }));
+        const int round = std::fegetround();
+        const int after = fegetexcept();
+        fedisableexcept(FE_ALL_EXCEPT & ~enabled);
+        std::fesetround(FE_TONEAREST);
+        REQUIRE(round == FE_UPWARD);
+        REQUIRE(after == (enabled | FE_OVERFLOW));
+        REQUIRE(std::fetestexcept(FE_INVALID) == 0);
+        REQUIRE_THROWS_AS(inf - inf, std::runtime_error);
+    }
+
+    SECTION("nested regions")
+    {
+        // the outer region is still armed after the inner one returned
+        REQUIRE(aborts(
+          [&]
+          {
+              return notnan::trapInvalid(
+                [&]
+                {
+                    static_cast<void>(notnan::trapInvalid([&] { return inf + 1; }));
+                    return inf - inf;
+                }
+              );
+          }
+        ));
+        REQUIRE(*notnan::trapInvalid([&] { return notnan::trapInvalid([&] { return inf + 1; }); }) == *inf);
+        REQUIRE((fegetexcept() & FE_INVALID) == 0);
+    }
+}
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#endif
+
+#pragma GCC diagnostic pop
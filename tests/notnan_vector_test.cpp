@@ -0,0 +1,173 @@
+// disable warnings regarding conversions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include "../NotNaNVector.hpp"
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers)
+// NOLINTBEGIN(readability-identifier-naming)
+
+namespace
+{
+template <std::floating_point T>
+auto makeValues(const std::size_t size, const T start, const T step) -> std::vector<T>
+{
+    std::vector<T> values(size);
+    for (std::size_t idx = 0; idx < size; ++idx)
+    {
+        values[idx] = start + step * static_cast<T>(idx);
+    }
+    return values;
+}
+}    // namespace
+
+TEMPLATE_TEST_CASE("NotNaNVector construction", "[NotNaNVector][Construction]", float, double, long double)
+{
+    SECTION("Empty")
+    {
+        const NotNaNVector<TestType> vec;
+        REQUIRE(vec.empty());
+        REQUIRE(vec.size() == 0);
+        REQUIRE(vec.begin() == vec.end());
+    }
+    SECTION("Fill")
+    {
+        const NotNaNVector<TestType> vec(100, NotNaN<TestType> {2.5});
+        REQUIRE(vec.size() == 100);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(vec.data()) % 64 == 0);
+        for (const auto& value : vec)
+        {
+            REQUIRE(*value == TestType {2.5});
+        }
+    }
+    SECTION("Initializer list")
+    {
+        const NotNaNVector<TestType> vec {NotNaN<TestType> {1.0}, NotNaN<TestType> {2.0}, NotNaN<TestType> {3.0}};
+        REQUIRE(vec.size() == 3);
+        REQUIRE(*vec[0] == TestType {1.0});
+        REQUIRE(*vec[2] == TestType {3.0});
+        REQUIRE(*vec.at(1) == TestType {2.0});
+        REQUIRE_THROWS_AS(vec.at(3), std::out_of_range);
+    }
+    SECTION("From raw values")
+    {
+        auto raw = makeValues<TestType>(77, -3.0, 0.25);
+        const NotNaNVector<TestType> vec {std::span<const TestType> {raw}};
+        REQUIRE(vec.size() == raw.size());
+        REQUIRE(std::equal(raw.begin(), raw.end(), vec.data()));
+
+        raw[42] = std::numeric_limits<TestType>::quiet_NaN();
+        REQUIRE_THROWS_AS(NotNaNVector<TestType> {std::span<const TestType> {raw}}, std::invalid_argument);
+    }
+    SECTION("Element assignment keeps the invariant")
+    {
+        NotNaNVector<TestType> vec(4, NotNaN<TestType> {0.0});
+        vec[1] = TestType {5.0};
+        REQUIRE(*vec[1] == TestType {5.0});
+        REQUIRE_THROWS(vec[2] = std::numeric_limits<TestType>::quiet_NaN());
+        REQUIRE(*vec[2] == TestType {0.0});
+        vec.push_back(NotNaN<TestType> {7.0});
+        REQUIRE(vec.size() == 5);
+        REQUIRE(*vec.span().back() == TestType {7.0});
+    }
+}
+
+TEMPLATE_TEST_CASE("NotNaNVector arithmetic", "[NotNaNVector][Arithmetic]", float, double, long double)
+{
+    // sizes around the block size used for checking
+    const std::size_t size = GENERATE(0U, 1U, 17U, 255U, 256U, 257U, 1000U);
+
+    const auto rawLhs      = makeValues<TestType>(size, -50.0, 0.5);
+    const auto rawRhs      = makeValues<TestType>(size, 1.0, 0.25);
+    const NotNaNVector<TestType> lhs {std::span<const TestType> {rawLhs}};
+    const NotNaNVector<TestType> rhs {std::span<const TestType> {rawRhs}};
+    const TestType               scalar = 3.0;
+
+    const auto check = [&](const NotNaNVector<TestType>& result, const auto& expected)
+    {
+        REQUIRE(result.size() == size);
+        for (std::size_t idx = 0; idx < size; ++idx)
+        {
+            REQUIRE(*result[idx] == expected(idx));
+        }
+    };
+
+    SECTION("Vector and vector")
+    {
+        check(lhs + rhs, [&](const std::size_t idx) { return rawLhs[idx] + rawRhs[idx]; });
+        check(lhs - rhs, [&](const std::size_t idx) { return rawLhs[idx] - rawRhs[idx]; });
+        check(lhs * rhs, [&](const std::size_t idx) { return rawLhs[idx] * rawRhs[idx]; });
+        check(lhs / rhs, [&](const std::size_t idx) { return rawLhs[idx] / rawRhs[idx]; });
+    }
+    SECTION("Vector and scalar")
+    {
+        check(lhs + scalar, [&](const std::size_t idx) { return rawLhs[idx] + scalar; });
+        check(scalar - lhs, [&](const std::size_t idx) { return scalar - rawLhs[idx]; });
+        check(lhs * NotNaN {scalar}, [&](const std::size_t idx) { return rawLhs[idx] * scalar; });
+        check(NotNaN {scalar} / rhs, [&](const std::size_t idx) { return scalar / rawRhs[idx]; });
+    }
+    SECTION("Compound assignment")
+    {
+        NotNaNVector<TestType> vec {lhs};
+        vec += rhs;
+        vec *= scalar;
+        vec -= NotNaN {scalar};
+        vec /= rhs;
+        check(vec, [&](const std::size_t idx) { return (((rawLhs[idx] + rawRhs[idx]) * scalar) - scalar) / rawRhs[idx]; });
+    }
+    SECTION("Size mismatch")
+    {
+        const NotNaNVector<TestType> other(size + 1, NotNaN<TestType> {1.0});
+        REQUIRE_THROWS_AS(lhs + other, std::invalid_argument);
+        NotNaNVector<TestType> copy {lhs};
+        REQUIRE_THROWS_AS(copy *= other, std::invalid_argument);
+    }
+    SECTION("NaN scalar")
+    {
+        REQUIRE_THROWS_AS(lhs + std::numeric_limits<TestType>::quiet_NaN(), std::invalid_argument);
+        REQUIRE_THROWS_AS(std::numeric_limits<TestType>::quiet_NaN() * lhs, std::invalid_argument);
+    }
+}
+
+TEMPLATE_TEST_CASE("NotNaNVector NaN results", "[NotNaNVector][Exceptions]", float, double, long double)
+{
+    const std::size_t size   = GENERATE(1U, 300U, 1000U);
+    const std::size_t badIdx = GENERATE_COPY(0U, size / 2, size - 1);
+    INFO("size = " << size << ", NaN at " << badIdx);
+
+    constexpr TestType INF = std::numeric_limits<TestType>::infinity();
+    NotNaNVector<TestType> lhs(size, NotNaN<TestType> {1.0});
+    NotNaNVector<TestType> rhs(size, NotNaN<TestType> {2.0});
+    lhs[badIdx] = INF;
+    rhs[badIdx] = INF;
+
+    SECTION("Binary operator")
+    {
+        REQUIRE_THROWS_AS(lhs - rhs, std::runtime_error);
+        REQUIRE_THROWS_WITH(lhs - rhs, Catch::Matchers::ContainsSubstring(std::format("index {}", badIdx)));
+        REQUIRE_THROWS_AS(lhs * NotNaN<TestType> {0.0}, std::runtime_error);
+    }
+    SECTION("Compound assignment leaves no NaN behind")
+    {
+        REQUIRE_THROWS_AS(lhs -= rhs, std::runtime_error);
+        REQUIRE(notnan::findNaN(std::span<const TestType> {lhs.data(), lhs.size()}) == lhs.size());
+    }
+}
+
+// NOLINTEND(readability-identifier-naming)
+// NOLINTEND(readability-magic-numbers)
+
+#pragma GCC diagnostic pop